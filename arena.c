@@ -0,0 +1,213 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define ARENA_ALIGNMENT 16
+#define ARENA_DEFAULT_SIZE (64 * 1024)
+
+/*
+  Block of memory handed out by the arena, blocks are chained newest first
+*/
+struct arenaBlock
+{
+  struct arenaBlock *next;
+  size_t size;
+  size_t used;
+  char *data;
+};
+typedef struct arenaBlock arenaBlock;
+
+/*
+  Bump allocator, allocations are only released all at once with resetArena
+
+  @reserved: bytes requested from malloc across all blocks
+  @used: bytes handed out since the last reset
+  @growths: number of blocks added since the arena was created
+  @last: most recent allocation, the only one that can grow in place
+*/
+struct arena
+{
+  arenaBlock *head;
+  size_t reserved;
+  size_t used;
+  size_t growths;
+  void *last;
+};
+typedef struct arena arena;
+
+/*
+  Rounds a size up to the arena alignment
+
+  @size: size to be rounded
+
+  Return: aligned size
+*/
+size_t alignSize(size_t size)
+{
+  return (size + ARENA_ALIGNMENT - 1) & ~(size_t)(ARENA_ALIGNMENT - 1);
+}
+
+/*
+  Adds a block at the head of the arena
+
+  @arena: arena to be used
+  @size: usable size of the block
+
+  Return: none
+*/
+void addBlock(arena *arena, size_t size)
+{
+  arenaBlock *block = malloc(sizeof(arenaBlock));
+  block->data = malloc(size);
+  block->size = size;
+  block->used = 0;
+  block->next = arena->head;
+
+  arena->head = block;
+  arena->reserved += size;
+}
+
+arena *initArena(size_t size)
+{
+  arena *newArena = malloc(sizeof(arena));
+  newArena->head = NULL;
+  newArena->reserved = 0;
+  newArena->used = 0;
+  newArena->growths = 0;
+  newArena->last = NULL;
+
+  addBlock(newArena, alignSize(size > 0 ? size : ARENA_DEFAULT_SIZE));
+  return newArena;
+}
+
+/*
+  Allocates memory from the arena
+
+  @arena: arena to be used
+  @size: number of bytes
+
+  if the current block is full a new one is added, at least twice as big as
+  the previous one so the number of growths stays logarithmic
+
+  Return: pointer aligned to ARENA_ALIGNMENT
+*/
+void *arenaAlloc(arena *arena, size_t size)
+{
+  size = alignSize(size);
+  arenaBlock *block = arena->head;
+
+  if (block->size - block->used < size)
+  {
+    size_t blockSize = block->size * 2;
+    if (blockSize < size)
+      blockSize = size;
+    addBlock(arena, blockSize);
+    arena->growths++;
+    block = arena->head;
+  }
+
+  void *memory = block->data + block->used;
+  block->used += size;
+  arena->used += size;
+  arena->last = memory;
+  return memory;
+}
+
+/*
+  Grows an allocation, the arena's version of realloc
+
+  @arena: arena to be used
+  @memory: previous allocation
+  @oldSize: size of the previous allocation
+  @newSize: size needed
+
+  the most recent allocation grows in place when its block has room, any other
+  one is copied and the old copy stays unused until the next reset
+
+  Return: pointer to the grown allocation
+*/
+void *arenaGrow(arena *arena, void *memory, size_t oldSize, size_t newSize)
+{
+  arenaBlock *block = arena->head;
+  oldSize = alignSize(oldSize);
+  newSize = alignSize(newSize);
+
+  if (memory == arena->last && block->data + block->used == (char *)memory + oldSize &&
+      block->size - block->used >= newSize - oldSize)
+  {
+    block->used += newSize - oldSize;
+    arena->used += newSize - oldSize;
+    return memory;
+  }
+
+  void *grown = arenaAlloc(arena, newSize);
+  memcpy(grown, memory, oldSize);
+  return grown;
+}
+
+/*
+  Releases every allocation while keeping the capacity
+
+  @arena: arena to be reset
+  @sizeHint: bytes the next user expects to need, 0 if unknown
+
+  when the last run needed several blocks they are merged into a single one
+  as big as all of them together (or the hint, if larger), so a run of the
+  same size doesn't need to grow again
+
+  Return: none
+*/
+void resetArena(arena *arena, size_t sizeHint)
+{
+  size_t size = arena->reserved > sizeHint ? arena->reserved : alignSize(sizeHint);
+
+  if (arena->head->next || arena->head->size < size)
+  {
+    while (arena->head)
+    {
+      arenaBlock *next = arena->head->next;
+      free(arena->head->data);
+      free(arena->head);
+      arena->head = next;
+    }
+    arena->reserved = 0;
+    addBlock(arena, size);
+  }
+
+  arena->head->used = 0;
+  arena->used = 0;
+  arena->last = NULL;
+}
+
+/*
+  Writes the allocation statistics of an arena
+
+  @file: output file
+  @arena: arena to be described
+
+  Return: none
+*/
+void printArenaStats(FILE *file, arena *arena)
+{
+  fprintf(file, "arena: %zu bytes reserved, %zu bytes used, %zu growths\n",
+          arena->reserved, arena->used, arena->growths);
+}
+
+/*
+  Releases an arena and all of its blocks
+
+  @arena: arena to be released
+
+  Return: none
+*/
+void freeArena(arena *arena)
+{
+  while (arena->head)
+  {
+    arenaBlock *next = arena->head->next;
+    free(arena->head->data);
+    free(arena->head);
+    arena->head = next;
+  }
+  free(arena);
+}
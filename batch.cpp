@@ -0,0 +1,420 @@
+/*
+  Batch mode, classifies every C++ and Python file under the given paths in a
+  single process
+
+  build: gcc -O2 -pthread -DSCANNER_NO_MAIN -c scanner.c
+         g++ -std=c++17 -O2 -pthread -o batch batch.cpp scanner.o
+
+  usage: batch [-j threads] [-l list] [-c] paths...
+  directories are walked recursively, -l reads one path per line from a file
+  ("-" for stdin), the report is written to stdout as JSON Lines
+  -c classifies Python files in count-only mode: no token stream, the report
+  gets the def, class and self counts instead
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <stdio.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "scanner.h"
+
+#define BERNIE_NO_MAIN
+#include "bernie.cpp"
+
+#define PYTHONCOMP_NO_MAIN
+#include "py/finalcomp/pythoncomp.cpp"
+
+namespace fs = std::filesystem;
+
+enum language
+{
+  CPP,
+  PYTHON,
+  UNKNOWN
+};
+
+/*
+  Report line of one file
+*/
+struct batchResult
+{
+  std::string path;
+  language lang = UNKNOWN;
+  uintmax_t bytes = 0;
+  size_t tokens = 0;
+  size_t symbols = 0;
+  size_t errors = 0;
+  std::string paradigm;
+  std::string error;
+  // def, class and self counts, only filled in count-only mode
+  bool counted = false;
+  size_t counts[4] = {0, 0, 0, 0};
+};
+
+/*
+  Jobs of one worker, the owner takes from the front (largest files) and
+  thieves from the back
+*/
+struct workQueue
+{
+  std::mutex lock;
+  std::deque<size_t> jobs;
+};
+
+/*
+  Picks the pipeline of a file by its extension
+
+  @path: file to be classified
+
+  Return: language of the file, UNKNOWN if neither pipeline applies
+*/
+language languageOf(const fs::path &path)
+{
+  std::string extension = path.extension().string();
+  std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+
+  if (extension == ".py")
+    return PYTHON;
+  if (extension == ".cpp" || extension == ".cc" || extension == ".cxx" || extension == ".c" ||
+      extension == ".hpp" || extension == ".hh" || extension == ".h")
+    return CPP;
+  return UNKNOWN;
+}
+
+/*
+  Adds a file, or every supported file under a directory, to the batch
+
+  @path: file or directory
+  @results: batch, one entry per file
+
+  Return: none
+*/
+void collect(const fs::path &path, std::vector<batchResult> &results)
+{
+  std::error_code error;
+  if (fs::is_directory(path, error))
+  {
+    for (auto it = fs::recursive_directory_iterator(path, fs::directory_options::skip_permission_denied, error);
+         it != fs::recursive_directory_iterator(); it.increment(error))
+    {
+      if (error)
+        break;
+      if (it->is_regular_file(error) && languageOf(it->path()) != UNKNOWN)
+        collect(it->path(), results);
+    }
+    return;
+  }
+
+  batchResult result;
+  result.path = path.string();
+  result.lang = languageOf(path);
+  result.bytes = fs::file_size(path, error);
+  if (error)
+  {
+    result.bytes = 0;
+    result.error = "can't be opened";
+  }
+  else if (result.lang == UNKNOWN)
+    result.error = "unsupported extension";
+  results.push_back(result);
+}
+
+/*
+  Scanner (scanner.c) and probabilistic parser (bernie.cpp) pipeline
+
+  @result: entry of the file
+  @tables: tables of the worker, reused across files
+
+  Return: none
+*/
+void classifyCpp(batchResult &result, scanTables *tables)
+{
+  if (!scanFile(result.path.c_str(), tables))
+  {
+    result.error = "can't be opened";
+    return;
+  }
+
+  scanSummary summary;
+  summarizeScan(tables, &summary);
+  result.tokens = summary.tokens;
+  result.symbols = summary.symbols;
+  result.errors = summary.errors;
+
+  static const char *names[][2] = {{"OOP", "Object-Oriented Programming"},
+                                   {"PP", "Procedural Programming"},
+                                   {"MIXED", "Procedural and Object-Oriented Programming"}};
+  std::map<std::string, double> probabilities = ProbabilisticParadigmParser(summary.stream).getProbabilities();
+  double highest = 0.0;
+  for (auto &name : names)
+  {
+    if (probabilities[name[0]] > highest)
+    {
+      highest = probabilities[name[0]];
+      result.paradigm = name[1];
+    }
+  }
+}
+
+/*
+  Scanner and LL(1) parser pipeline of pythoncomp.cpp
+
+  @result: entry of the file
+  @tokens: token stream of the worker, reused across files
+
+  Return: none
+*/
+void classifyPython(batchResult &result, tokenStream &tokens)
+{
+  std::ifstream file(result.path, std::ios::binary);
+  if (!file)
+  {
+    result.error = "can't be opened";
+    return;
+  }
+  std::string code((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+  result.paradigm = classifyCode(code, &tokens, &result.error);
+  result.tokens = tokens.count;
+  // the parser reports "\nerror at position n\n"
+  result.error.erase(std::remove(result.error.begin(), result.error.end(), '\n'), result.error.end());
+}
+
+/*
+  Count-only pipeline of pythoncomp.cpp, the file is read in blocks straight
+  into the counters
+
+  @result: entry of the file
+
+  Return: none
+*/
+void countPython(batchResult &result)
+{
+  paradigmTally tally;
+  const char *paradigm = countFile(result.path.c_str(), tally, &result.error);
+  if (!paradigm)
+  {
+    result.error = "can't be opened";
+    return;
+  }
+
+  result.paradigm = paradigm;
+  result.counted = true;
+  std::copy(tally.counts, tally.counts + 4, result.counts);
+  result.tokens = tally.counts[1] + tally.counts[2] + tally.counts[3];
+  result.error.erase(std::remove(result.error.begin(), result.error.end(), '\n'), result.error.end());
+}
+
+/*
+  Takes the next job, from the worker's own queue first and then from the
+  back of the others
+
+  @queues: queues of every worker
+  @self: index of the calling worker
+  @job: where the job is stored
+
+  no job is added once the workers start, so empty queues everywhere mean the
+  batch is done
+
+  Return: true if a job was taken
+*/
+bool takeJob(std::vector<workQueue> &queues, size_t self, size_t &job)
+{
+  {
+    std::lock_guard<std::mutex> guard(queues[self].lock);
+    if (!queues[self].jobs.empty())
+    {
+      job = queues[self].jobs.front();
+      queues[self].jobs.pop_front();
+      return true;
+    }
+  }
+
+  for (size_t i = 1; i < queues.size(); i++)
+  {
+    workQueue &victim = queues[(self + i) % queues.size()];
+    std::lock_guard<std::mutex> guard(victim.lock);
+    if (!victim.jobs.empty())
+    {
+      job = victim.jobs.back();
+      victim.jobs.pop_back();
+      return true;
+    }
+  }
+  return false;
+}
+
+/*
+  Thread of the pool, classifies jobs until every queue is empty
+
+  @queues: queues of every worker
+  @self: index of the worker
+  @results: batch, the entry of every job taken is filled
+  @countOnly: Python files go through the count-only pipeline
+
+  the scanner tables and the token stream are allocated once per worker and
+  reused across its files
+
+  Return: none
+*/
+void worker(std::vector<workQueue> &queues, size_t self, std::vector<batchResult> &results, bool countOnly)
+{
+  scanTables *tables = NULL;
+  tokenStream tokens;
+  initTokenStream(&tokens, 0, tokenStreamRealloc, NULL);
+  size_t job;
+
+  while (takeJob(queues, self, job))
+  {
+    batchResult &result = results[job];
+    if (result.lang == CPP)
+    {
+      if (!tables)
+        tables = initScanTables(result.bytes);
+      classifyCpp(result, tables);
+    }
+    else if (result.lang == PYTHON && countOnly)
+      countPython(result);
+    else if (result.lang == PYTHON)
+      classifyPython(result, tokens);
+  }
+
+  if (tables)
+    freeScanTables(tables);
+  releaseTokenStream(&tokens);
+}
+
+/*
+  Writes a string as a JSON string literal
+
+  @file: output file
+  @text: string to be written
+
+  Return: none
+*/
+void writeJsonString(FILE *file, const std::string &text)
+{
+  fputc('"', file);
+  for (unsigned char ch : text)
+  {
+    if (ch == '"' || ch == '\\')
+      fprintf(file, "\\%c", ch);
+    else if (ch < 0x20)
+      fprintf(file, "\\u%04x", ch);
+    else
+      fputc(ch, file);
+  }
+  fputc('"', file);
+}
+
+/*
+  Writes the report line of a file, a JSON object
+
+  @file: output file
+  @result: entry of the file
+
+  Return: none
+*/
+void writeResult(FILE *file, const batchResult &result)
+{
+  static const char *languages[] = {"cpp", "python", "unknown"};
+
+  fputs("{\"path\": ", file);
+  writeJsonString(file, result.path);
+  fprintf(file, ", \"language\": \"%s\", \"bytes\": %ju, \"tokens\": %zu, \"symbols\": %zu, \"errors\": %zu, \"paradigm\": ",
+          languages[result.lang], result.bytes, result.tokens, result.symbols, result.errors);
+  writeJsonString(file, result.paradigm);
+  if (result.counted)
+    fprintf(file, ", \"counts\": {\"def\": %zu, \"class\": %zu, \"self\": %zu}", result.counts[1], result.counts[2],
+            result.counts[3]);
+  fputs(", \"error\": ", file);
+  if (result.error.empty())
+    fputs("null", file);
+  else
+    writeJsonString(file, result.error);
+  fputs("}\n", file);
+}
+
+/*
+  Main method
+
+  @argv[i]: "-j N" number of threads, "-l list" file with one path per line,
+  "-c" count-only mode for Python files, anything else is a file or directory
+
+  Return: 0, 1 if there is nothing to classify or the list can't be opened
+*/
+int main(int argc, char **argv)
+{
+  size_t threads = std::max(1u, std::thread::hardware_concurrency());
+  std::vector<batchResult> results;
+  bool countOnly = false;
+
+  for (int i = 1; i < argc; i++)
+  {
+    std::string arg = argv[i];
+    if (arg == "-j" && i + 1 < argc)
+      threads = std::max(1, atoi(argv[++i]));
+    else if (arg == "-c")
+      countOnly = true;
+    else if (arg == "-l" && i + 1 < argc)
+    {
+      std::string name = argv[++i];
+      std::ifstream listFile;
+      if (name != "-")
+        listFile.open(name);
+      std::istream &list = name == "-" ? std::cin : listFile;
+      if (!list)
+      {
+        fprintf(stderr, "%s: can't be opened\n", name.c_str());
+        return 1;
+      }
+      std::string line;
+      while (std::getline(list, line))
+        if (!line.empty())
+          collect(line, results);
+    }
+    else
+      collect(arg, results);
+  }
+
+  if (results.empty())
+  {
+    fprintf(stderr, "usage: %s [-j threads] [-l list] [-c] paths...\n", argv[0]);
+    return 1;
+  }
+
+  // the report follows the paths, the schedule follows the sizes
+  std::sort(results.begin(), results.end(),
+            [](const batchResult &a, const batchResult &b)
+            { return a.path < b.path; });
+  std::vector<size_t> order(results.size());
+  for (size_t i = 0; i < order.size(); i++)
+    order[i] = i;
+  std::stable_sort(order.begin(), order.end(),
+                   [&](size_t a, size_t b)
+                   { return results[a].bytes > results[b].bytes; });
+
+  // dealt round robin, so every queue starts with one of the largest files
+  threads = std::min(threads, results.size());
+  std::vector<workQueue> queues(threads);
+  for (size_t i = 0; i < order.size(); i++)
+    if (results[order[i]].error.empty())
+      queues[i % threads].jobs.push_back(order[i]);
+
+  std::vector<std::thread> pool;
+  for (size_t i = 0; i < threads; i++)
+    pool.emplace_back(worker, std::ref(queues), i, std::ref(results), countOnly);
+  for (std::thread &thread : pool)
+    thread.join();
+
+  for (const batchResult &result : results)
+    writeResult(stdout, result);
+  return 0;
+}
@@ -0,0 +1,184 @@
+#ifndef BENCHUTIL_H
+#define BENCHUTIL_H
+
+/*
+  Measurements shared by the lexer benchmarks: wall time, peak RSS and heap
+  allocations, printed as one JSON object per line so runs can be diffed and
+  tracked across changes
+
+  include it in exactly one file per program, it replaces malloc, calloc and
+  realloc (glibc) to count the calls, operator new goes through them as well
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <time.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+  void *__libc_malloc(size_t size);
+  void *__libc_calloc(size_t count, size_t size);
+  void *__libc_realloc(void *memory, size_t size);
+
+  // heap calls and bytes requested since the last benchResetAllocations
+  static size_t benchAllocations;
+  static size_t benchAllocatedBytes;
+
+  void *malloc(size_t size)
+  {
+    benchAllocations++;
+    benchAllocatedBytes += size;
+    return __libc_malloc(size);
+  }
+
+  void *calloc(size_t count, size_t size)
+  {
+    benchAllocations++;
+    benchAllocatedBytes += count * size;
+    return __libc_calloc(count, size);
+  }
+
+  void *realloc(void *memory, size_t size)
+  {
+    benchAllocations++;
+    benchAllocatedBytes += size;
+    return __libc_realloc(memory, size);
+  }
+
+#ifdef __cplusplus
+}
+#endif
+
+#define BENCH_DEFAULT_ROUNDS 5
+
+/*
+  Result of a benchmark, the best of its rounds
+
+  @allocations, @allocatedBytes: heap calls of one round
+  @peakRss: peak resident set of the process in KB, the input included
+*/
+struct benchResult
+{
+  const char *scanner;
+  const char *input;
+  size_t bytes;
+  size_t tokens;
+  double seconds;
+  size_t allocations;
+  size_t allocatedBytes;
+  long peakRss;
+};
+typedef struct benchResult benchResult;
+
+/*
+  Gets a monotonic timestamp
+
+  Return: seconds
+*/
+static inline double benchNow(void)
+{
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+/*
+  Starts counting the allocations of a round
+
+  Return: none
+*/
+static inline void benchResetAllocations(void)
+{
+  benchAllocations = 0;
+  benchAllocatedBytes = 0;
+}
+
+/*
+  Keeps a round if it's the fastest so far
+
+  @result: best round, seconds is 0 before the first one
+  @seconds: duration of the round
+  @tokens: tokens the round produced
+
+  Return: none
+*/
+static inline void benchKeepRound(benchResult *result, double seconds, size_t tokens)
+{
+  if (result->seconds == 0 || seconds < result->seconds)
+  {
+    result->seconds = seconds;
+    result->tokens = tokens;
+    result->allocations = benchAllocations;
+    result->allocatedBytes = benchAllocatedBytes;
+  }
+}
+
+/*
+  Prints a result as a JSON line
+
+  @result: result to be printed, peakRss is read here
+
+  Return: none
+*/
+static inline void benchReport(benchResult *result)
+{
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  result->peakRss = usage.ru_maxrss;
+
+  double seconds = result->seconds > 0 ? result->seconds : 1e-9;
+  printf("{\"scanner\": \"%s\", \"input\": \"%s\", \"bytes\": %zu, \"tokens\": %zu, \"seconds\": %.6f, "
+         "\"mb_per_s\": %.2f, \"tokens_per_s\": %.0f, \"peak_rss_kb\": %ld, \"allocations\": %zu, "
+         "\"allocated_bytes\": %zu}\n",
+         result->scanner, result->input, result->bytes, result->tokens, result->seconds,
+         result->bytes / seconds / 1e6, result->tokens / seconds, result->peakRss, result->allocations,
+         result->allocatedBytes);
+  fflush(stdout);
+}
+
+/*
+  Reads the options shared by the benchmarks: [-r rounds] input...
+
+  @argc, @argv: arguments of main
+  @rounds: number of rounds to be filled
+
+  Return: index of the first input, argc if there is none
+*/
+static inline int benchOptions(int argc, char **argv, int *rounds)
+{
+  *rounds = BENCH_DEFAULT_ROUNDS;
+  int first = 1;
+  if (argc > 2 && !strcmp(argv[1], "-r"))
+  {
+    *rounds = atoi(argv[2]) > 0 ? atoi(argv[2]) : 1;
+    first = 3;
+  }
+  if (first >= argc)
+    fprintf(stderr, "usage: %s [-r rounds] input...\n", argv[0]);
+  return first;
+}
+
+/*
+  Gets the size of a file
+
+  @filename: name of the file
+
+  Return: size in bytes, 0 if it can't be read
+*/
+static inline size_t benchFileSize(const char *filename)
+{
+  FILE *file = fopen(filename, "rb");
+  if (!file)
+    return 0;
+  fseek(file, 0, SEEK_END);
+  long size = ftell(file);
+  fclose(file);
+  return size > 0 ? (size_t)size : 0;
+}
+
+#endif
@@ -0,0 +1,322 @@
+/*
+  Deterministic synthetic corpora for the lexer benchmarks
+
+  the text is built from units of four kinds (comments, strings, identifier
+  lines and nested blocks) picked at random with the weights of the mix, the
+  same language, size, mix and seed always give the same bytes
+
+  build: gcc -O2 -o gencorpus bench/gencorpus.c
+  usage: ./gencorpus cpp|python megabytes mix output [seed]
+    mix: comment-heavy, string-heavy, identifier-heavy, deep-nesting, balanced,
+         or the four weights as comment:string:identifier:nesting (e.g. 1:1:6:2)
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define DEFAULT_SEED 20250501
+#define MAX_NESTING 48
+#define WORD_POOL 512
+
+enum unitKind
+{
+  COMMENT_UNIT,
+  STRING_UNIT,
+  IDENTIFIER_UNIT,
+  NESTING_UNIT,
+  UNIT_KINDS
+};
+
+/*
+  Weights of every unit kind in a mix
+*/
+struct corpusMix
+{
+  const char *name;
+  int weights[UNIT_KINDS];
+};
+typedef struct corpusMix corpusMix;
+
+static const corpusMix presets[] = {
+    {"comment-heavy", {6, 1, 2, 1}},
+    {"string-heavy", {1, 6, 2, 1}},
+    {"identifier-heavy", {1, 1, 7, 1}},
+    {"deep-nesting", {1, 1, 2, 6}},
+    {"balanced", {1, 1, 1, 1}},
+};
+
+/*
+  Output buffer that grows by doubling
+*/
+struct corpus
+{
+  char *data;
+  size_t length;
+  size_t size;
+  unsigned long long seed;
+  int python;
+  char words[WORD_POOL][16];
+};
+typedef struct corpus corpus;
+
+/*
+  Gets the next pseudo-random number (xorshift64)
+
+  @text: corpus with the generator state
+
+  Return: random number
+*/
+unsigned long long nextRandom(corpus *text)
+{
+  text->seed ^= text->seed << 13;
+  text->seed ^= text->seed >> 7;
+  text->seed ^= text->seed << 17;
+  return text->seed;
+}
+
+/*
+  Appends a string to the corpus
+
+  @text: corpus to be used
+  @string: text to be appended
+
+  Return: none
+*/
+void append(corpus *text, const char *string)
+{
+  size_t length = strlen(string);
+  if (text->length + length > text->size)
+  {
+    while (text->length + length > text->size)
+      text->size *= 2;
+    text->data = realloc(text->data, text->size);
+  }
+  memcpy(text->data + text->length, string, length);
+  text->length += length;
+}
+
+/*
+  Appends the indentation of a nesting level
+
+  @text: corpus to be used
+  @depth: nesting level
+
+  Return: none
+*/
+void indent(corpus *text, int depth)
+{
+  for (int i = 0; i < depth; i++)
+    append(text, "  ");
+}
+
+/*
+  Appends a random word of the pool, some of them are keywords
+
+  @text: corpus to be used
+
+  Return: none
+*/
+void appendWord(corpus *text)
+{
+  append(text, text->words[nextRandom(text) % WORD_POOL]);
+}
+
+/*
+  Fills the word pool with identifiers of 1 to 12 characters and the keywords
+  the scanners look for
+
+  @text: corpus to be used
+
+  Return: none
+*/
+void fillWords(corpus *text)
+{
+  static const char *keywords[] = {"class", "def", "main", "self", "if", "while", "for", "return", "int", "void"};
+  static const char first[] = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ_";
+  static const char rest[] = "abcdefghijklmnopqrstuvwxyz_0123456789";
+
+  for (int i = 0; i < WORD_POOL; i++)
+  {
+    if (i < (int)(sizeof(keywords) / sizeof(*keywords)))
+    {
+      strcpy(text->words[i], keywords[i]);
+      continue;
+    }
+    int length = 1 + nextRandom(text) % 12;
+    text->words[i][0] = first[nextRandom(text) % (sizeof(first) - 1)];
+    for (int j = 1; j < length; j++)
+      text->words[i][j] = rest[nextRandom(text) % (sizeof(rest) - 1)];
+    text->words[i][length] = '\0';
+  }
+}
+
+/*
+  Appends a line or block comment
+
+  @text: corpus to be used
+
+  Return: none
+*/
+void appendComment(corpus *text)
+{
+  int words = 4 + nextRandom(text) % 12;
+  int block = !text->python && nextRandom(text) % 3 == 0;
+  append(text, text->python ? "# " : block ? "/* " : "// ");
+  for (int i = 0; i < words; i++)
+  {
+    appendWord(text);
+    append(text, block && i % 5 == 4 ? "\n   " : " ");
+  }
+  append(text, block ? "*/\n" : "\n");
+}
+
+/*
+  Appends an assignment of a string literal, with escapes now and then
+
+  @text: corpus to be used
+
+  Return: none
+*/
+void appendString(corpus *text)
+{
+  const char *quote = nextRandom(text) % 2 ? "\"" : "'";
+  appendWord(text);
+  append(text, " = ");
+  append(text, quote);
+  int words = 2 + nextRandom(text) % 16;
+  for (int i = 0; i < words; i++)
+  {
+    appendWord(text);
+    append(text, nextRandom(text) % 8 == 0 ? "\\n" : " ");
+  }
+  append(text, quote);
+  append(text, text->python ? "\n" : ";\n");
+}
+
+/*
+  Appends a line of identifiers, calls and operators
+
+  @text: corpus to be used
+
+  Return: none
+*/
+void appendIdentifiers(corpus *text)
+{
+  appendWord(text);
+  append(text, " = ");
+  appendWord(text);
+  append(text, "(");
+  int arguments = nextRandom(text) % 5;
+  for (int i = 0; i < arguments; i++)
+  {
+    if (i)
+      append(text, ", ");
+    appendWord(text);
+  }
+  append(text, ") + ");
+  appendWord(text);
+  append(text, text->python ? "\n" : ";\n");
+}
+
+/*
+  Appends blocks nested a random number of levels, C++ with braces and Python
+  with indentation, every level opened by a class, def or control statement
+
+  @text: corpus to be used
+
+  Return: none
+*/
+void appendNesting(corpus *text)
+{
+  static const char *openers[] = {"class", "def", "if", "while", "for"};
+  int depth = 2 + nextRandom(text) % (MAX_NESTING - 1);
+
+  for (int level = 0; level < depth; level++)
+  {
+    indent(text, level);
+    append(text, openers[nextRandom(text) % 5]);
+    append(text, " ");
+    appendWord(text);
+    append(text, text->python ? "(" : " (");
+    appendWord(text);
+    append(text, text->python ? "):\n" : ") {\n");
+  }
+  indent(text, depth);
+  appendWord(text);
+  append(text, text->python ? " = 0\n" : " = 0;\n");
+  if (!text->python)
+    for (int level = depth - 1; level >= 0; level--)
+    {
+      indent(text, level);
+      append(text, "}\n");
+    }
+}
+
+/*
+  Parses a mix, a preset name or four weights
+
+  @name: argument given
+  @mix: weights to be filled
+
+  Return: 1 on success, 0 if the mix isn't valid
+*/
+int parseMix(const char *name, corpusMix *mix)
+{
+  for (size_t i = 0; i < sizeof(presets) / sizeof(*presets); i++)
+    if (!strcmp(name, presets[i].name))
+    {
+      *mix = presets[i];
+      return 1;
+    }
+
+  mix->name = name;
+  int *w = mix->weights;
+  return sscanf(name, "%d:%d:%d:%d", &w[0], &w[1], &w[2], &w[3]) == 4 && w[0] >= 0 && w[1] >= 0 &&
+         w[2] >= 0 && w[3] >= 0 && w[0] + w[1] + w[2] + w[3] > 0;
+}
+
+int main(int argc, char **argv)
+{
+  corpusMix mix;
+  if (argc < 5 || (strcmp(argv[1], "cpp") && strcmp(argv[1], "python")) || !parseMix(argv[3], &mix))
+  {
+    fprintf(stderr, "usage: %s cpp|python megabytes mix output [seed]\n", argv[0]);
+    return 1;
+  }
+
+  size_t target = (size_t)(atof(argv[2]) * (1 << 20));
+  corpus text = {malloc(1 << 16), 0, 1 << 16, argc > 5 ? strtoull(argv[5], NULL, 10) : DEFAULT_SEED,
+                 !strcmp(argv[1], "python")};
+  if (!text.seed)
+    text.seed = DEFAULT_SEED;
+  fillWords(&text);
+
+  int total = mix.weights[0] + mix.weights[1] + mix.weights[2] + mix.weights[3];
+  while (text.length < target)
+  {
+    int pick = nextRandom(&text) % total;
+    int kind = 0;
+    while (pick >= mix.weights[kind])
+      pick -= mix.weights[kind++];
+
+    if (kind == COMMENT_UNIT)
+      appendComment(&text);
+    else if (kind == STRING_UNIT)
+      appendString(&text);
+    else if (kind == IDENTIFIER_UNIT)
+      appendIdentifiers(&text);
+    else
+      appendNesting(&text);
+  }
+
+  FILE *output = fopen(argv[4], "wb");
+  if (!output)
+  {
+    fprintf(stderr, "%s: can't be opened\n", argv[4]);
+    return 1;
+  }
+  fwrite(text.data, 1, text.length, output);
+  fclose(output);
+  free(text.data);
+  return 0;
+}
@@ -0,0 +1,219 @@
+/*
+  GLLParser (gllparser.cpp), EarleyParser (earley.h) and the parsers
+  python/rdgen.py generates against RecursiveDescentParser (parser100.cpp),
+  with and without the packrat memo, on long synthetic token sequences, the
+  ambiguous ones and some that fail late, one JSON object per family, size and
+  parser
+
+  RecursiveDescentParser keeps the first alternative that parses, GLL and
+  Earley all of them, so some sequences only those accept, the outcome is in
+  the output
+
+  build: g++ -std=c++17 -O2 -o gllbench bench/gllbench.cpp
+  usage: ./gllbench [max units], from the repository root (Earley reads grammar5.md)
+*/
+#define PARSER100_NO_MAIN
+#define GLLPARSER_NO_MAIN
+#include "../parser100.cpp"
+#include "../gllparser.cpp"
+// regenerate with: python3 python/rdgen.py [--memo] grammar5.md grammar5_[memo_]parser.h id=0,10-255 class=1 def=2 main=3 '(=4' ')=5' '{=6' '}=7' indent=8 noindent=9
+#include "../grammar5_parser.h"
+#include "../grammar5_memo_parser.h"
+#include <chrono>
+
+#define DEFAULT_MAX_UNITS 1024
+#define ROUNDS 3
+
+/*
+  Sequences of a family: the head, the unit repeated and the tail
+*/
+struct tokenFamily
+{
+  const char *name;
+  std::vector<uint8_t> head;
+  std::vector<uint8_t> unit;
+  std::vector<uint8_t> tail;
+};
+
+// ids: 0 id, 1 class, 2 def, 3 main, 4 (, 5 ), 6 {, 7 }, 8 indent, 9 noindent
+static const tokenFamily families[] = {
+    // any number of the statements can be the ones before the function
+    {"python-statements-function", {}, {9, 0}, {2, 0, 4, 5, 8, 0}},
+    // the statements between functions go to FUNC' or to S', in every combination
+    {"c-functions", {}, {0, 0, 4, 5, 6, 8, 0, 7, 8, 0}, {}},
+    {"mixed-classes-functions", {}, {9, 1, 0, 6, 8, 0, 7, 8, 0, 0, 4, 5, 6, 8, 0, 7}, {}},
+    {"unclosed-class-body", {9, 1, 0, 6}, {9, 0, 0}, {}},
+    {"unclosed-parens", {9, 0}, {4, 9, 0}, {}},
+};
+
+/*
+  Parses a sequence ROUNDS times with RecursiveDescentParser and prints the
+  fastest round
+
+  @family: family of the sequence
+  @units: repetitions of the unit
+  @tokens: sequence to be parsed
+  @packrat: whether the parser memoizes
+
+  Return: none
+*/
+void measureRecursiveDescent(const tokenFamily &family, size_t units, const std::vector<uint8_t> &tokens, bool packrat)
+{
+  double best = 0;
+  memoStats stats;
+  std::string outcome;
+  for (int round = 0; round < ROUNDS; round++)
+  {
+    auto start = std::chrono::steady_clock::now();
+    RecursiveDescentParser parser(tokenSpanOf(tokens.data(), tokens.size()), packrat);
+    outcome = "accepted";
+    try
+    {
+      parser.parse();
+    }
+    catch (ParseError &e)
+    {
+      outcome = "error at " + std::to_string(e.position);
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    if (round == 0 || seconds < best)
+      best = seconds;
+    stats = parser.getMemoStats();
+  }
+
+  printf("{\"family\": \"%s\", \"units\": %zu, \"tokens\": %zu, \"parser\": \"%s\", \"seconds\": %.6f, "
+         "\"calls\": %zu, \"outcome\": \"%s\"}\n",
+         family.name, units, tokens.size(), packrat ? "packrat" : "backtracking", best, stats.calls,
+         outcome.c_str());
+  fflush(stdout);
+}
+
+/*
+  Parses a sequence ROUNDS times with GLLParser and prints the fastest round,
+  the size of the structures it built and the derivations the forest holds
+
+  @family: family of the sequence
+  @units: repetitions of the unit
+  @tokens: sequence to be parsed
+
+  Return: none
+*/
+void measureGLL(const tokenFamily &family, size_t units, const std::vector<uint8_t> &tokens)
+{
+  double best = 0;
+  gllStats stats;
+  std::string outcome;
+  double derivations = 0;
+  size_t paradigms = 0;
+  for (int round = 0; round < ROUNDS; round++)
+  {
+    auto start = std::chrono::steady_clock::now();
+    GLLParser parser(tokenSpanOf(tokens.data(), tokens.size()));
+    bool accepted = parser.parse();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    if (round == 0 || seconds < best)
+      best = seconds;
+    stats = parser.getStats();
+    outcome = accepted ? "accepted" : "error at " + std::to_string(parser.getErrorPosition());
+    // outside the timing, walking the forest is up to the caller
+    derivations = parser.countDerivations();
+    paradigms = parser.derivationsOf(GRAMMAR5_PARADIGM).size();
+  }
+
+  printf("{\"family\": \"%s\", \"units\": %zu, \"tokens\": %zu, \"parser\": \"gll\", \"seconds\": %.6f, "
+         "\"descriptors\": %zu, \"gss_nodes\": %zu, \"gss_edges\": %zu, \"sppf_nodes\": %zu, "
+         "\"packed_nodes\": %zu, \"paradigms\": %zu, \"derivations\": %g, \"outcome\": \"%s\"}\n",
+         family.name, units, tokens.size(), best, stats.descriptors, stats.gssNodes, stats.gssEdges, stats.sppfNodes,
+         stats.packedNodes, paradigms, derivations, outcome.c_str());
+  fflush(stdout);
+}
+
+/*
+  Parses a sequence ROUNDS times with EarleyParser and prints the fastest
+  round and the size of its item sets
+
+  @family: family of the sequence
+  @units: repetitions of the unit
+  @tokens: sequence to be parsed
+  @grammar: grammar5.md, read once
+
+  Return: none
+*/
+void measureEarley(const tokenFamily &family, size_t units, const std::vector<uint8_t> &tokens,
+                   const EarleyGrammar &grammar)
+{
+  double best = 0;
+  earleyStats stats;
+  std::string outcome;
+  for (int round = 0; round < ROUNDS; round++)
+  {
+    auto start = std::chrono::steady_clock::now();
+    EarleyParser parser(grammar, tokenSpanOf(tokens.data(), tokens.size()));
+    bool accepted = parser.parse();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    if (round == 0 || seconds < best)
+      best = seconds;
+    stats = parser.getStats();
+    outcome = accepted ? "accepted" : "error at " + std::to_string(parser.getErrorPosition());
+  }
+
+  printf("{\"family\": \"%s\", \"units\": %zu, \"tokens\": %zu, \"parser\": \"earley\", \"seconds\": %.6f, "
+         "\"items\": %zu, \"completions\": %zu, \"transitive\": %zu, \"outcome\": \"%s\"}\n",
+         family.name, units, tokens.size(), best, stats.items, stats.completions, stats.transitive, outcome.c_str());
+  fflush(stdout);
+}
+
+/*
+  Parses a sequence ROUNDS times with a parser generated by python/rdgen.py
+  and prints the fastest round
+
+  @family: family of the sequence
+  @units: repetitions of the unit
+  @tokens: sequence to be parsed
+  @name: strategy the parser was generated with
+
+  Return: none
+*/
+template <typename GeneratedParser>
+void measureGenerated(const tokenFamily &family, size_t units, const std::vector<uint8_t> &tokens, const char *name)
+{
+  double best = 0;
+  std::string outcome;
+  for (int round = 0; round < ROUNDS; round++)
+  {
+    auto start = std::chrono::steady_clock::now();
+    GeneratedParser parser(tokenSpanOf(tokens.data(), tokens.size()));
+    bool accepted = parser.parse();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    if (round == 0 || seconds < best)
+      best = seconds;
+    outcome = accepted ? "accepted" : "error at " + std::to_string(parser.getErrorPosition());
+  }
+
+  printf("{\"family\": \"%s\", \"units\": %zu, \"tokens\": %zu, \"parser\": \"%s\", \"seconds\": %.6f, "
+         "\"outcome\": \"%s\"}\n",
+         family.name, units, tokens.size(), name, best, outcome.c_str());
+  fflush(stdout);
+}
+
+int main(int argc, char **argv)
+{
+  size_t maxUnits = argc > 1 ? atol(argv[1]) : DEFAULT_MAX_UNITS;
+  EarleyGrammar grammar("grammar5.md", grammar5Terminals);
+
+  for (const tokenFamily &family : families)
+    for (size_t units = 16; units <= maxUnits; units *= 4)
+    {
+      std::vector<uint8_t> tokens = family.head;
+      for (size_t i = 0; i < units; i++)
+        tokens.insert(tokens.end(), family.unit.begin(), family.unit.end());
+      tokens.insert(tokens.end(), family.tail.begin(), family.tail.end());
+
+      measureRecursiveDescent(family, units, tokens, false);
+      measureRecursiveDescent(family, units, tokens, true);
+      measureGenerated<Grammar5Parser>(family, units, tokens, "generated");
+      measureGenerated<Grammar5MemoParser>(family, units, tokens, "generated-memo");
+      measureGLL(family, units, tokens);
+      measureEarley(family, units, tokens, grammar);
+    }
+}
@@ -0,0 +1,151 @@
+/*
+  Random edits against editLiveScan: after every edit the live token stream and
+  errors must be the ones a full scan of the new text gives
+
+  build: gcc -O1 -g -fsanitize=address,undefined -o incrementalcheck bench/incrementalcheck.c
+  usage: ./incrementalcheck [edits] [seed]
+*/
+#define SCANNER_NO_MAIN
+#include "../scanner.c"
+
+#define DEFAULT_EDITS 20000
+#define MAX_LENGTH 4096
+
+// pieces the texts are made of, with the lexemes that span or break lines
+static const char *pieces[] = {
+    "class", "def", "main", "value", "x1", "_y", " ", "  ", "\t", "\n", "\n  ", "\n    ", "(", ")", "{", "}",
+    "=", "+", "==", "!=", "<=", "0", "42", "3.14", "1e9", "\"text\"", "'c'", "\"open", "'", "`tpl`",
+    "// note\n", "/* block\n */", "/*", "*/", "#", "@", "$", "\\", "caf\xc3\xa9", "\xce\xbb", "\xe2\x82\xac",
+    "\xf0\x9f\x98\x80", "\xc3", "\x80", "\xff", "\r\n"};
+#define PIECE_COUNT (sizeof(pieces) / sizeof(pieces[0]))
+
+/*
+  Appends random pieces to a buffer
+
+  @data: buffer, grown as needed
+  @length: length of the buffer, updated
+  @count: number of pieces
+
+  Return: buffer
+*/
+char *appendPieces(char *data, size_t *length, int count)
+{
+  for (int i = 0; i < count; i++)
+  {
+    const char *piece = pieces[rand() % PIECE_COUNT];
+    size_t pieceLength = strlen(piece);
+    data = realloc(data, *length + pieceLength + 1);
+    memcpy(data + *length, piece, pieceLength);
+    *length += pieceLength;
+  }
+  return data;
+}
+
+/*
+  Compares the live scan of a text with a full scan of it
+
+  @scan: live scan to be checked
+  @data, @length: current text
+
+  Return: 1 if they match, 0 if not
+*/
+int matchesFullScan(liveScan *scan, const char *data, size_t length)
+{
+  scanTables *full = initScanTables(length);
+  scanBuffer(data, length, full);
+
+  tokenStream *live = scan->tables->tokens;
+  tokenStream *expected = full->tokens;
+  int matches = live->count == expected->count;
+  tokenReader liveReader, expectedReader;
+  seekToken(live, 0, &liveReader);
+  seekToken(expected, 0, &expectedReader);
+  for (size_t i = 0; matches && i < expected->count; i++)
+  {
+    int same = live->ids[i] == expected->ids[i] && liveReader.offset == expectedReader.offset &&
+               liveReader.line == expectedReader.line;
+    // symbol ids are kept stable by the live scan, the names must still match
+    if (same && expected->symbols[i] >= 0)
+      same = live->symbols[i] >= 0 &&
+             !strcmp(symbolName(scan->tables->identifiers, live->symbols[i]),
+                     symbolName(full->identifiers, expected->symbols[i]));
+    if (!same)
+    {
+      fprintf(stderr, "token %zu: %d at %llu line %zu, expected %d at %llu line %zu\n", i, live->ids[i],
+              (unsigned long long)liveReader.offset, liveReader.line, expected->ids[i],
+              (unsigned long long)expectedReader.offset, expectedReader.line);
+      matches = 0;
+    }
+    nextToken(live, &liveReader);
+    nextToken(expected, &expectedReader);
+  }
+  if (matches && live->count != expected->count)
+    fprintf(stderr, "%zu tokens, expected %zu\n", live->count, expected->count);
+
+  charTable *liveErrors = scan->tables->errors;
+  charTable *expectedErrors = full->errors;
+  if (liveErrors->position != expectedErrors->position)
+  {
+    fprintf(stderr, "%zu errors, expected %zu\n", liveErrors->position, expectedErrors->position);
+    matches = 0;
+  }
+  for (size_t i = 0; matches && i < expectedErrors->position; i++)
+    if (liveErrors->views[i][0] != expectedErrors->views[i][0] ||
+        liveErrors->views[i][1] != expectedErrors->views[i][1])
+    {
+      fprintf(stderr, "error %zu: [%zu, +%zu), expected [%zu, +%zu)\n", i, liveErrors->views[i][0],
+              liveErrors->views[i][1], expectedErrors->views[i][0], expectedErrors->views[i][1]);
+      matches = 0;
+    }
+
+  freeScanTables(full);
+  return matches;
+}
+
+int main(int argc, char **argv)
+{
+  long edits = argc > 1 ? atol(argv[1]) : DEFAULT_EDITS;
+  unsigned seed = argc > 2 ? (unsigned)atol(argv[2]) : 1;
+  srand(seed);
+
+  size_t length = 0;
+  char *data = appendPieces(NULL, &length, 200);
+  liveScan *scan = initLiveScan(data, length);
+
+  for (long i = 0; i < edits; i++)
+  {
+    // replaces a random range, mostly small, with random pieces
+    size_t editStart = length ? rand() % (length + 1) : 0;
+    size_t removed = rand() % 4 ? rand() % 8 : rand() % 200;
+    if (removed > length - editStart)
+      removed = length - editStart;
+    size_t insertedLength = 0;
+    char *inserted = length > MAX_LENGTH ? NULL : appendPieces(NULL, &insertedLength, rand() % 4 ? rand() % 3 : rand() % 30);
+
+    size_t newLength = length - removed + insertedLength;
+    char *next = malloc(newLength + 1);
+    memcpy(next, data, editStart);
+    if (insertedLength)
+      memcpy(next + editStart, inserted, insertedLength);
+    memcpy(next + editStart + insertedLength, data + editStart + removed, length - editStart - removed);
+    free(inserted);
+
+    // the previous text is read while the edit is applied
+    editLiveScan(scan, next, newLength, editStart, editStart + removed, editStart + insertedLength, NULL);
+    free(data);
+    data = next;
+    length = newLength;
+
+    if (!matchesFullScan(scan, data, length))
+    {
+      fprintf(stderr, "edit %ld (seed %u): [%zu, %zu) replaced by %zu bytes\n", i, seed, editStart,
+              editStart + removed, insertedLength);
+      return 1;
+    }
+  }
+
+  printf("%ld edits match a full scan\n", edits);
+  freeLiveScan(scan);
+  free(data);
+  return 0;
+}
@@ -0,0 +1,94 @@
+/*
+  Backtracking cost of RecursiveDescentParser (parser100.cpp) with and without
+  the packrat memo, on long synthetic token sequences that fail late, one JSON
+  object per family, size and mode
+
+  build: g++ -std=c++17 -O2 -o packratbench bench/packratbench.cpp
+  usage: ./packratbench [max units]
+*/
+#define PARSER100_NO_MAIN
+#include "../parser100.cpp"
+#include <chrono>
+
+#define DEFAULT_MAX_UNITS 4096
+#define ROUNDS 3
+
+/*
+  Sequences of a family: the head, the unit repeated and the tail
+*/
+struct tokenFamily
+{
+  const char *name;
+  std::vector<uint8_t> head;
+  std::vector<uint8_t> unit;
+  std::vector<uint8_t> tail;
+};
+
+// ids: 0 id, 1 class, 2 def, 3 main, 4 (, 5 ), 6 {, 7 }, 8 indent, 9 noindent
+static const tokenFamily families[] = {
+    // every alternative of S and PARADIGM parses the body before missing the }
+    {"unclosed-class-body", {9, 1, 0, 6}, {9, 0, 0}, {}},
+    {"unclosed-parens", {9, 0}, {4, 9, 0}, {}},
+    {"unclosed-braces", {}, {9, 0, 6}, {}},
+    {"unclosed-python-call", {0}, {4, 8, 0}, {}},
+};
+
+/*
+  Parses a sequence ROUNDS times and prints the fastest round
+
+  @family: family of the sequence
+  @units: repetitions of the unit
+  @tokens: sequence to be parsed
+  @packrat: whether the parser memoizes
+
+  Return: none
+*/
+void measure(const tokenFamily &family, size_t units, const std::vector<uint8_t> &tokens, bool packrat)
+{
+  double best = 0;
+  memoStats stats;
+  std::string outcome;
+  for (int round = 0; round < ROUNDS; round++)
+  {
+    auto start = std::chrono::steady_clock::now();
+    RecursiveDescentParser parser(tokenSpanOf(tokens.data(), tokens.size()), packrat);
+    outcome = "accepted";
+    try
+    {
+      parser.parse();
+    }
+    catch (ParseError &e)
+    {
+      outcome = "error at " + std::to_string(e.position);
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    if (round == 0 || seconds < best)
+      best = seconds;
+    stats = parser.getMemoStats();
+  }
+
+  printf("{\"family\": \"%s\", \"units\": %zu, \"tokens\": %zu, \"mode\": \"%s\", \"seconds\": %.6f, "
+         "\"calls\": %zu, \"lookups\": %zu, \"hits\": %zu, \"hit_rate\": %.4f, \"memo_bytes\": %zu, "
+         "\"outcome\": \"%s\"}\n",
+         family.name, units, tokens.size(), packrat ? "packrat" : "backtracking", best, stats.calls, stats.lookups,
+         stats.hits, stats.lookups ? (double)stats.hits / stats.lookups : 0.0,
+         packrat ? NONTERMINALS * (tokens.size() + 1) * sizeof(uint32_t) : 0, outcome.c_str());
+  fflush(stdout);
+}
+
+int main(int argc, char **argv)
+{
+  size_t maxUnits = argc > 1 ? atol(argv[1]) : DEFAULT_MAX_UNITS;
+
+  for (const tokenFamily &family : families)
+    for (size_t units = 64; units <= maxUnits; units *= 4)
+    {
+      std::vector<uint8_t> tokens = family.head;
+      for (size_t i = 0; i < units; i++)
+        tokens.insert(tokens.end(), family.unit.begin(), family.unit.end());
+      tokens.insert(tokens.end(), family.tail.begin(), family.tail.end());
+
+      measure(family, units, tokens, false);
+      measure(family, units, tokens, true);
+    }
+}
@@ -0,0 +1,52 @@
+/*
+ * Throughput of the pythoncomp scanner over whole files, scanner() or with -c
+ * the count-only mode (countFile).
+ *
+ * build: g++ -std=c++17 -O2 -o pythoncompbench bench/pythoncompbench.cpp
+ * usage: ./pythoncompbench [-c] [-r rounds] input...
+ * Prints one JSON line per input (see benchutil.h), inputs from gencorpus.
+ * Each mode runs in its own process so peak_rss_kb belongs to that mode.
+ */
+#define PYTHONCOMP_NO_MAIN
+#include "../py/finalcomp/pythoncomp.cpp"
+#include "benchutil.h"
+
+int main(int argc, char **argv)
+{
+  bool countOnly = argc > 1 && !strcmp(argv[1], "-c");
+  if (countOnly)
+  {
+    argv[1] = argv[0];
+    argc--;
+    argv++;
+  }
+  int rounds;
+  int first = benchOptions(argc, argv, &rounds);
+
+  for (int i = first; i < argc; i++)
+  {
+    benchResult result = {countOnly ? "pythoncomp count-only" : "pythoncomp", argv[i], benchFileSize(argv[i]),
+                          0, 0, 0, 0, 0};
+    for (int round = 0; round < rounds; round++)
+    {
+      benchResetAllocations();
+      double start = benchNow();
+      if (countOnly)
+      {
+        paradigmTally tally;
+        countFile(argv[i], tally);
+        double seconds = benchNow() - start;
+        benchKeepRound(&result, seconds, tally.counts[1] + tally.counts[2] + tally.counts[3]);
+      }
+      else
+      {
+        tokenStream tokens = scanner(argv[i]);
+        double seconds = benchNow() - start;
+        benchKeepRound(&result, seconds, tokens.count);
+        releaseTokenStream(&tokens);
+      }
+    }
+    benchReport(&result);
+  }
+  return first >= argc;
+}
@@ -0,0 +1,40 @@
+/*
+  Throughput of pythonscanner.c over whole files (scanPythonFile, read in blocks)
+
+  build: gcc -O2 -o pythonscannerbench bench/pythonscannerbench.c
+  usage: ./pythonscannerbench [-r rounds] input...
+  prints one JSON line per input (see benchutil.h), inputs from gencorpus
+*/
+#define PYTHONSCANNER_NO_MAIN
+#include "../pythonscanner.c"
+#include "benchutil.h"
+
+int main(int argc, char **argv)
+{
+  int rounds;
+  int first = benchOptions(argc, argv, &rounds);
+
+  for (int i = first; i < argc; i++)
+  {
+    benchResult result = {"pythonscanner.c", argv[i], benchFileSize(argv[i]), 0, 0, 0, 0, 0};
+    for (int round = 0; round < rounds; round++)
+    {
+      benchResetAllocations();
+      double start = benchNow();
+      dfaLanguage language;
+      initPythonLanguage(&language);
+      scanTables *tables = initScanTables(0);
+      paradigmScan scan = {tables->tokens, 0, 0};
+      if (!scanPythonFile(argv[i], &language, &scan))
+      {
+        fprintf(stderr, "%s: can't be opened\n", argv[i]);
+        return 1;
+      }
+      double seconds = benchNow() - start;
+      benchKeepRound(&result, seconds, tables->tokens->count);
+      freeScanTables(tables);
+    }
+    benchReport(&result);
+  }
+  return first >= argc;
+}
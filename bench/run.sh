@@ -0,0 +1,35 @@
+#!/bin/sh
+# Builds the lexer benchmarks, generates the corpora and prints one JSON line
+# per scanner and corpus (see bench/benchutil.h), e.g. to keep as a baseline:
+#   bench/run.sh 16 > baseline.jsonl
+# every input runs in its own process so peak_rss_kb belongs to that input
+#
+# usage: bench/run.sh [megabytes] [rounds] [mix...]
+set -e
+
+root=$(cd "$(dirname "$0")/.." && pwd)
+megabytes=${1:-16}
+rounds=${2:-5}
+[ $# -gt 2 ] && shift 2 || set --
+mixes=${*:-comment-heavy string-heavy identifier-heavy deep-nesting balanced}
+work=${BENCH_DIR:-/tmp/lexbench}
+mkdir -p "$work"
+
+cc=${CC:-gcc}
+cxx=${CXX:-g++}
+$cc -O2 -o "$work/gencorpus" "$root/bench/gencorpus.c"
+$cc -O2 -pthread -o "$work/scannerbench" "$root/bench/scannerbench.c"
+$cc -O2 -o "$work/pythonscannerbench" "$root/bench/pythonscannerbench.c"
+$cxx -std=c++17 -O2 -o "$work/pythoncompbench" "$root/bench/pythoncompbench.cpp"
+
+for mix in $mixes; do
+  cpp="$work/$mix-${megabytes}mb.cpp"
+  python="$work/$mix-${megabytes}mb.py"
+  [ -f "$cpp" ] || "$work/gencorpus" cpp "$megabytes" "$mix" "$cpp"
+  [ -f "$python" ] || "$work/gencorpus" python "$megabytes" "$mix" "$python"
+
+  "$work/scannerbench" -r "$rounds" "$cpp"
+  "$work/pythonscannerbench" -r "$rounds" "$python"
+  "$work/pythoncompbench" -r "$rounds" "$python"
+  "$work/pythoncompbench" -c -r "$rounds" "$python"
+done
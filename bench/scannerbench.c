@@ -0,0 +1,37 @@
+/*
+  Throughput of scanner.c over whole files (scanFile, memory-mapped)
+
+  build: gcc -O2 -pthread -o scannerbench bench/scannerbench.c
+  usage: ./scannerbench [-r rounds] input...
+  prints one JSON line per input (see benchutil.h), inputs from gencorpus
+*/
+#define SCANNER_NO_MAIN
+#include "../scanner.c"
+#include "benchutil.h"
+
+int main(int argc, char **argv)
+{
+  int rounds;
+  int first = benchOptions(argc, argv, &rounds);
+
+  for (int i = first; i < argc; i++)
+  {
+    benchResult result = {"scanner.c", argv[i], benchFileSize(argv[i]), 0, 0, 0, 0, 0};
+    for (int round = 0; round < rounds; round++)
+    {
+      benchResetAllocations();
+      double start = benchNow();
+      scanTables *tables = initScanTables(result.bytes);
+      if (!scanFile(argv[i], tables))
+      {
+        fprintf(stderr, "%s: can't be opened\n", argv[i]);
+        return 1;
+      }
+      double seconds = benchNow() - start;
+      benchKeepRound(&result, seconds, tables->tokens->count);
+      freeScanTables(tables);
+    }
+    benchReport(&result);
+  }
+  return first >= argc;
+}
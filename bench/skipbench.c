@@ -0,0 +1,87 @@
+/*
+  Throughput of scanSource with and without the fast skip over strings and comments
+
+  build: gcc -O2 -march=native -o skipbench bench/skipbench.c
+  usage: ./skipbench [megabytes]
+*/
+#define SCANNER_NO_MAIN
+#include "../scanner.c"
+#include <time.h>
+
+#define DEFAULT_MEGABYTES 64
+#define ROUNDS 5
+
+/*
+  Fills a buffer repeating a snippet
+
+  @length: size of the buffer
+  @snippet: text to be repeated
+
+  Return: buffer, must be freed
+*/
+char *repeatSnippet(size_t length, const char *snippet)
+{
+  char *data = malloc(length);
+  size_t snippetLen = strlen(snippet);
+  for (size_t i = 0; i < length; i += snippetLen)
+    memcpy(data + i, snippet, length - i < snippetLen ? length - i : snippetLen);
+  return data;
+}
+
+/*
+  Gets the best throughput over ROUNDS runs
+
+  @language: descriptor of the scanner language
+  @source: input buffer
+  @skip: 1 to skip, 0 for the per-byte DFA walk
+
+  Return: MB/s
+*/
+double measure(const dfaLanguage *language, const sourceBuffer *source, int skip)
+{
+  double best = 0;
+  scanTables *tables = initScanTables(source->length);
+  for (int round = 0; round < ROUNDS; round++)
+  {
+    resetScanTables(tables, source->length);
+    attachSource(tables->errors, source->data);
+
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    scanSource(language, source, skip, tables);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    double seconds = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+    double throughput = source->length / seconds / 1e6;
+    if (throughput > best)
+      best = throughput;
+  }
+  return best;
+}
+
+int main(int argc, char **argv)
+{
+  size_t length = (argc > 1 ? atol(argv[1]) : DEFAULT_MEGABYTES) << 20;
+
+  static const char *names[] = {"comment-heavy", "string-heavy"};
+  static const char *snippets[] = {
+      "// scans the remaining input looking for the closing delimiter of the lexeme\n"
+      "/* block comments usually span\n   several lines of documentation text\n   before the code */\n"
+      "int value\n",
+      "  message = \"Testing lexical analyzer with a reasonably long string literal\"\n"
+      "  other = 'single quoted text that the DFA only leaves on its quote'\n"
+      "  raw = `template literal`\n"};
+
+  dfaLanguage language;
+  initScannerLanguage(&language);
+
+  for (int i = 0; i < 2; i++)
+  {
+    sourceBuffer source = {repeatSnippet(length, snippets[i]), length, 0};
+    double before = measure(&language, &source, 0);
+    double after = measure(&language, &source, 1);
+    printf("%-14s %8.1f MB/s per byte %8.1f MB/s skipping (%.1fx)\n",
+           names[i], before, after, after / before);
+    closeSource(&source);
+  }
+}
@@ -4,11 +4,13 @@
 #include <map>
 #include <algorithm>
 #include <iomanip>
+#include "tokfile.h"
 
 class ProbabilisticParadigmParser
 {
 private:
-  std::vector<int> tokens;
+  // non-owning, the scanner's stream or a mapped token file outlives the parser
+  tokenSpan tokens;
   size_t currentPos;
 
   struct ParseResult
@@ -23,7 +25,7 @@ private:
 
   int getToken(size_t pos)
   {
-    return (pos < tokens.size()) ? tokens[pos] : -1;
+    return grammarTokenId(tokens[pos]);
   }
 
   double calculateConfidence(size_t consumed, size_t total, bool hasSpecificPatterns = false)
@@ -200,14 +202,14 @@ private:
   }
 
 public:
-  ProbabilisticParadigmParser(const std::vector<int> &tokenSeq) : tokens(tokenSeq), currentPos(0) {}
+  ProbabilisticParadigmParser(tokenSpan tokenSeq) : tokens(tokenSeq), currentPos(0) {}
 
   void analyzeProbabilities()
   {
     std::cout << "Input token sequence (" << tokens.size() << " tokens): ";
     for (size_t i = 0; i < tokens.size(); i++)
     {
-      std::cout << tokens[i];
+      std::cout << getToken(i);
       if (i < tokens.size() - 1)
         std::cout << " ";
     }
@@ -294,11 +296,26 @@ public:
   }
 };
 
-int main()
+#ifndef BERNIE_NO_MAIN
+// argv[1]: optional token file written by the scanner (tokfile.h), replaces the example tokens
+int main(int argc, char **argv)
 {
   try
   {
-    std::vector<int> tokens = {9, 0, 3, 4, 5, 6, 8, 0, 0, 8, 0, 0, 0, 8, 0, 4, 0, 5, 8, 0, 0, 0, 0, 8, 0, 7};
+    std::vector<uint8_t> example = {9, 0, 3, 4, 5, 6, 8, 0, 0, 8, 0, 0, 0, 8, 0, 4, 0, 5, 8, 0, 0, 0, 0, 8, 0, 7};
+    tokenSpan tokens = tokenSpanOf(example.data(), example.size());
+
+    // mapped until the process exits, the parser reads the file in place
+    tokfile file;
+    if (argc > 1)
+    {
+      if (!tokfileMap(argv[1], &file))
+      {
+        std::cout << argv[1] << " is not a token file" << std::endl;
+        return 1;
+      }
+      tokens = file.tokens;
+    }
 
     ProbabilisticParadigmParser parser(tokens);
     parser.analyzeProbabilities();
@@ -318,4 +335,5 @@ int main()
   }
 
   return 0;
-}
\ No newline at end of file
+}
+#endif
@@ -0,0 +1,850 @@
+#ifndef DFA_H
+#define DFA_H
+
+/*
+  Lexer engine shared by every front end (scanner.c, pythonscanner.c and
+  py/finalcomp/pythoncomp.cpp)
+
+  a front end only describes its language in a dfaLanguage: transition table,
+  byte classes, what each transition does with its character and which token
+  each final state stands for
+  the descriptor is read-only once built and the drivers keep their state in
+  their own structs, there are no globals, so any number of scans can run at
+  the same time, over the same language or different ones
+
+  two drivers:
+  - dfaLexer: push lexer, the input is fed in chunks of any size
+  - dfaScanRange: scans a buffer in place, lexemes are views into it, skipping
+    strings and comments with findByte
+
+  states are numbered [0, finalStart) for the ones with a row in the table,
+  [finalStart, failState) for final states that accept a token and failState
+  for unrecognized lexemes
+  a transition into a final state ends the lexeme, the DFA goes back to state 0
+  and, unless the transition consumes its character, the character is
+  processed again from there
+
+  input is 8-bit: ASCII bytes go straight through classOf, and when the
+  language sets utf8Symbol every byte of a well-formed UTF-8 sequence is read
+  as that symbol (e.g. an identifier letter) while malformed bytes keep their
+  classOf entry, a byte order mark at the start of the input is skipped
+  both drivers find pure ASCII blocks with findNonAscii and only decode the
+  non-ASCII runs
+*/
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include "fastskip.c"
+
+#define DFA_MAX_STATES 32
+#define DFA_MAX_SYMBOLS 32
+#define DFA_BUFFER_SIZE 128
+
+// bytes of a non-ASCII run classified at once, and of an ASCII check
+#define DFA_RUN_SIZE 64
+#define DFA_ASCII_BLOCK 4096
+
+// utf8Symbol of the languages that read every byte through classOf
+#define DFA_NO_UTF8 -1
+
+// action flags of a transition
+#define DFA_CONSUME 1
+#define DFA_BUFFER 2
+
+// token id of a final state that is looked up in the keyword map
+#define DFA_KEYWORD -2
+
+// token id given to the callback for unrecognized lexemes
+#define DFA_ERROR -1
+
+/*
+  Description of a language
+
+  @next: state x symbol -> state, only for the states below finalStart
+  @actions: state x symbol -> DFA_CONSUME | DFA_BUFFER, indexed by the state
+  reached and the symbol that led there
+  @classOf: byte -> symbol, all 256 bytes
+  @utf8Symbol: symbol of the bytes of well-formed UTF-8 sequences, DFA_NO_UTF8
+  to use classOf for them too
+  @eofSymbol: symbol processed once the input is over
+  @tokens: final state -> token id, DFA_KEYWORD to ask keyword
+  @keyword: keyword map, token id of a lexeme or 0 for identifiers, NULL if
+  the language has none
+  @skipTo: terminator byte of the states that only wait for it, NO_SKIP if not
+  (see dfaBuildSkipTable)
+*/
+struct dfaLanguage
+{
+  int finalStart;
+  int failState;
+  int symbols;
+  uint8_t next[DFA_MAX_STATES][DFA_MAX_SYMBOLS];
+  uint8_t actions[DFA_MAX_STATES][DFA_MAX_SYMBOLS];
+  uint8_t classOf[256];
+  int utf8Symbol;
+  int eofSymbol;
+  int tokens[DFA_MAX_STATES];
+  int (*keyword)(const char *lexeme, size_t length);
+  int skipTo[DFA_MAX_STATES];
+};
+typedef struct dfaLanguage dfaLanguage;
+
+/*
+  Receives the lexemes of a scan
+
+  @context: pointer given to the driver
+  @tokenId: token id, DFA_ERROR for an unrecognized lexeme
+  @lexeme: start of the lexeme, null terminated only for the dfaLexer, only
+  valid during the call
+  @length: length of the lexeme
+  @offset: byte offset of the lexeme in the input
+  @line: line of the lexeme, starting at 1
+*/
+typedef void (*dfaTokenCallback)(void *context, int tokenId, const char *lexeme, size_t length,
+                                 size_t offset, size_t line);
+
+/*
+  Prepares an empty descriptor, the caller fills next, classOf and tokens
+
+  @language: descriptor to be initialized
+  @symbols: size of the alphabet, eof included
+  @finalStart: first final state
+  @failState: state of unrecognized lexemes
+
+  Return: 1 if the sizes fit, 0 if not
+*/
+static inline int initDfaLanguage(dfaLanguage *language, int symbols, int finalStart, int failState)
+{
+  if (symbols > DFA_MAX_SYMBOLS || failState >= DFA_MAX_STATES || finalStart > failState)
+    return 0;
+
+  memset(language, 0, sizeof(dfaLanguage));
+  language->symbols = symbols;
+  language->finalStart = finalStart;
+  language->failState = failState;
+  language->utf8Symbol = DFA_NO_UTF8;
+  for (int state = 0; state < DFA_MAX_STATES; state++)
+  {
+    language->tokens[state] = DFA_ERROR;
+    language->skipTo[state] = NO_SKIP;
+  }
+  return 1;
+}
+
+/*
+  Fills the action flags from per-character rules
+
+  @language: descriptor with classOf filled
+  @consume: 1 if the state reached consumes the character
+  @buffer: 1 if the character is part of the lexeme
+
+  the rules are evaluated once per symbol with one of its bytes, so they have
+  to give the same answer for every byte of a symbol
+
+  Return: none
+*/
+static inline void dfaDeriveActions(dfaLanguage *language, int (*consume)(int state, char ch),
+                                    int (*buffer)(int state, char ch))
+{
+  for (int state = 0; state <= language->failState; state++)
+  {
+    int seen[DFA_MAX_SYMBOLS] = {0};
+    for (int byte = 0; byte < 256; byte++)
+    {
+      int symbol = language->classOf[byte];
+      if (seen[symbol])
+        continue;
+      seen[symbol] = 1;
+      language->actions[state][symbol] = (consume(state, (char)byte) ? DFA_CONSUME : 0) |
+                                         (buffer(state, (char)byte) ? DFA_BUFFER : 0);
+    }
+  }
+}
+
+/*
+  Finds the states that loop on themselves until a single byte shows up
+
+  @language: complete descriptor
+
+  a state qualifies when every symbol but one goes back to it consuming the
+  character, and that symbol belongs to exactly one byte, e.g. a string literal
+  only leaves on its closing quote
+  symbols without bytes (a separate end of input) don't count
+
+  Return: none
+*/
+static inline void dfaBuildSkipTable(dfaLanguage *language)
+{
+  int present[DFA_MAX_SYMBOLS] = {0};
+  for (int byte = 0; byte < 256; byte++)
+    present[language->classOf[byte]] = 1;
+
+  for (int state = 0; state < language->finalStart; state++)
+  {
+    int exit = -1;
+    language->skipTo[state] = NO_SKIP;
+
+    for (int symbol = 0; symbol < language->symbols; symbol++)
+    {
+      if (!present[symbol])
+        continue;
+      if (language->next[state][symbol] == state && (language->actions[state][symbol] & DFA_CONSUME))
+        continue;
+      if (exit != -1)
+      {
+        exit = -2;
+        break;
+      }
+      exit = symbol;
+    }
+    if (exit < 0)
+      continue;
+
+    int terminator = NO_SKIP;
+    for (int byte = 0; byte < 256; byte++)
+    {
+      if (language->classOf[byte] != exit)
+        continue;
+      if (terminator != NO_SKIP)
+      {
+        terminator = NO_SKIP;
+        break;
+      }
+      terminator = byte;
+    }
+    language->skipTo[state] = terminator;
+  }
+}
+
+/*
+  Builds a descriptor from longest-match tables (python/lexgen.py)
+
+  @language: descriptor to be filled
+  @classOf: byte -> class
+  @next: state x class -> state, classes columns per row
+  @accept: state -> token id, none if it doesn't accept
+  @states, @classes: size of the tables
+  @dead: state with no way out
+  @none: accept value of the states that don't accept
+
+  the longest match is turned into transitions into final states: leaving an
+  accepting state into the dead state ends its token without consuming the
+  character, one final state per token id, and the end of input is an extra
+  symbol that does the same
+  that only works when the longest match never has to back up more than one
+  character, i.e. every state reachable from an accepting one accepts too
+
+  Return: 1 on success, 0 if the tables don't fit or need more lookahead
+*/
+static inline int dfaFromLongestMatch(dfaLanguage *language, const uint8_t classOf[256], const uint8_t *next,
+                                      const uint8_t *accept, int states, int classes, int dead, int none)
+{
+  int finals[256];
+  int finalCount = 0;
+  for (int id = 0; id < 256; id++)
+    finals[id] = -1;
+  for (int state = 0; state < states; state++)
+    if (accept[state] != none && finals[accept[state]] < 0)
+      finals[accept[state]] = finalCount++;
+
+  if (!initDfaLanguage(language, classes + 1, states, states + finalCount))
+    return 0;
+
+  for (int state = 0; state < states; state++)
+    for (int symbol = 0; symbol < classes; symbol++)
+    {
+      int target = next[state * classes + symbol];
+      if (accept[state] != none && target != dead && accept[target] == none)
+        return 0;
+    }
+
+  memcpy(language->classOf, classOf, 256);
+  language->eofSymbol = classes;
+  for (int id = 0; id < 256; id++)
+    if (finals[id] >= 0)
+      language->tokens[states + finals[id]] = id;
+
+  for (int state = 0; state < states; state++)
+    for (int symbol = 0; symbol <= classes; symbol++)
+    {
+      int target = symbol < classes ? next[state * classes + symbol] : dead;
+      int accepting = accept[state] != none;
+
+      if (target != dead)
+      {
+        language->next[state][symbol] = target;
+        language->actions[target][symbol] = DFA_CONSUME | DFA_BUFFER;
+      }
+      else if (accepting)
+        language->next[state][symbol] = states + finals[accept[state]];
+      else
+      {
+        // no token matches, the bytes up to this one become an error
+        language->next[state][symbol] = language->failState;
+        language->actions[language->failState][symbol] = symbol < classes ? DFA_CONSUME | DFA_BUFFER : 0;
+      }
+    }
+
+  dfaBuildSkipTable(language);
+  return 1;
+}
+
+/*
+  Measures the UTF-8 sequence at the start of some bytes
+
+  @bytes: first byte of the sequence, not ASCII
+  @available: bytes that can be read
+  @final: 1 if no more bytes follow the available ones
+
+  follows RFC 3629: no overlong forms, no surrogates, nothing past U+10FFFF
+
+  Return: length of the sequence (2 to 4), 0 if the first byte doesn't start a
+  well-formed one, -1 if more bytes are needed to tell
+*/
+static inline int dfaUtf8Length(const uint8_t *bytes, size_t available, int final)
+{
+  uint8_t lead = bytes[0];
+  // range of the second byte, the first one already rules out the rest
+  uint8_t low = 0x80;
+  uint8_t high = 0xBF;
+  int length;
+
+  if (lead >= 0xC2 && lead <= 0xDF)
+    length = 2;
+  else if (lead >= 0xE0 && lead <= 0xEF)
+  {
+    length = 3;
+    low = lead == 0xE0 ? 0xA0 : low;
+    high = lead == 0xED ? 0x9F : high;
+  }
+  else if (lead >= 0xF0 && lead <= 0xF4)
+  {
+    length = 4;
+    low = lead == 0xF0 ? 0x90 : low;
+    high = lead == 0xF4 ? 0x8F : high;
+  }
+  else
+    return 0;
+
+  for (int i = 1; i < length; i++)
+  {
+    if ((size_t)i >= available)
+      return final ? 0 : -1;
+    if (i == 1 ? bytes[i] < low || bytes[i] > high : (bytes[i] & 0xC0) != 0x80)
+      return 0;
+  }
+  return length;
+}
+
+/*
+  Determines if a buffer starts with a UTF-8 byte order mark
+
+  Return: 1 if it does, 0 if not
+*/
+static inline int dfaHasBom(const char *data, size_t length)
+{
+  return length >= 3 && !memcmp(data, "\xEF\xBB\xBF", 3);
+}
+
+/*
+  Gets the token id of a final state
+
+  @language: descriptor of the language
+  @state: accepting final state
+  @lexeme: start of the lexeme, doesn't need to be null terminated
+  @length: length of the lexeme
+
+  Return: token id
+*/
+static inline int dfaTokenId(const dfaLanguage *language, int state, const char *lexeme, size_t length)
+{
+  int id = language->tokens[state];
+  if (id == DFA_KEYWORD)
+    id = language->keyword ? language->keyword(lexeme, length) : 0;
+  return id;
+}
+
+/*
+  Determines if a state accepts a token
+
+  @language: descriptor of the language
+  @state: final state
+
+  Return: 1 if it is accepted, 0 if not
+*/
+static inline int dfaAccepts(const dfaLanguage *language, int state)
+{
+  return state >= language->finalStart && state < language->failState;
+}
+
+/*
+  Push lexer, the input is fed in chunks of any size
+
+  the DFA state and the partial lexeme are kept between calls, so a string,
+  comment or identifier can be split across chunk boundaries
+  memory use is constant, lexemes are cut at DFA_BUFFER_SIZE characters
+
+  @offset, @line: position of the next character
+  @lexemeOffset, @lexemeLine: position of the lexeme in progress, measured
+  like dfaScanRange does
+  @pending: non-ASCII bytes held back until their UTF-8 sequence is complete,
+  a sequence can be split across chunks
+*/
+struct dfaLexer
+{
+  const dfaLanguage *language;
+  int state;
+  char buffer[DFA_BUFFER_SIZE];
+  int bufferLen;
+  dfaTokenCallback onToken;
+  void *context;
+  size_t offset;
+  size_t line;
+  size_t lexemeOffset;
+  size_t lexemeLine;
+  uint8_t pending[4];
+  int pendingLen;
+};
+typedef struct dfaLexer dfaLexer;
+
+/*
+  Prepares a lexer for a new input
+
+  @lexer: lexer to be initialized
+  @language: descriptor of the language
+  @onToken: function called for every lexeme
+  @context: pointer passed to onToken
+
+  Return: none
+*/
+static inline void initDfaLexer(dfaLexer *lexer, const dfaLanguage *language, dfaTokenCallback onToken, void *context)
+{
+  lexer->language = language;
+  lexer->state = 0;
+  lexer->bufferLen = 0;
+  lexer->onToken = onToken;
+  lexer->context = context;
+  lexer->offset = 0;
+  lexer->line = 1;
+  lexer->lexemeOffset = 0;
+  lexer->lexemeLine = 1;
+  lexer->pendingLen = 0;
+}
+
+/*
+  Hands the lexeme in a final state to the callback and starts the next one
+
+  @lexer: lexer in a final state
+
+  Return: none
+*/
+static inline void dfaEmit(dfaLexer *lexer)
+{
+  lexer->buffer[lexer->bufferLen] = '\0';
+  if (dfaAccepts(lexer->language, lexer->state))
+    lexer->onToken(lexer->context, dfaTokenId(lexer->language, lexer->state, lexer->buffer, lexer->bufferLen),
+                   lexer->buffer, lexer->bufferLen, lexer->lexemeOffset, lexer->lexemeLine);
+  else if (lexer->bufferLen > 0)
+    lexer->onToken(lexer->context, DFA_ERROR, lexer->buffer, lexer->bufferLen,
+                   lexer->lexemeOffset, lexer->lexemeLine);
+
+  lexer->state = 0;
+  lexer->bufferLen = 0;
+}
+
+/*
+  Runs one character through the DFA
+
+  @lexer: lexer to be used
+  @ch: character
+  @symbol: symbol of the character
+
+  Return: none
+*/
+static inline void dfaStep(dfaLexer *lexer, char ch, int symbol)
+{
+  const dfaLanguage *language = lexer->language;
+
+  // the same character is reprocessed from state 0 while the DFA doesn't advance
+  for (;;)
+  {
+    // a lexeme starts where the DFA leaves state 0, or at its first buffered character
+    if (lexer->state == 0)
+    {
+      lexer->lexemeOffset = lexer->offset;
+      lexer->lexemeLine = lexer->line;
+    }
+    int state = language->next[lexer->state][symbol];
+    int action = language->actions[state][symbol];
+    lexer->state = state;
+    if ((action & DFA_BUFFER) && lexer->bufferLen < DFA_BUFFER_SIZE - 1)
+    {
+      if (lexer->bufferLen == 0)
+      {
+        lexer->lexemeOffset = lexer->offset;
+        lexer->lexemeLine = lexer->line;
+      }
+      lexer->buffer[lexer->bufferLen++] = ch;
+    }
+    if (state >= language->finalStart)
+      dfaEmit(lexer);
+    if (action & DFA_CONSUME)
+      break;
+  }
+
+  lexer->offset++;
+  if (ch == '\n')
+    lexer->line++;
+}
+
+/*
+  Runs the held back bytes through the DFA once their sequences are known
+
+  @lexer: lexer to be used
+  @final: 1 if the input is over, incomplete sequences become malformed
+
+  Return: none
+*/
+static inline void dfaDecodePending(dfaLexer *lexer, int final)
+{
+  const dfaLanguage *language = lexer->language;
+
+  while (lexer->pendingLen > 0)
+  {
+    uint8_t *pending = lexer->pending;
+    int length = pending[0] < 0x80 ? 0 : dfaUtf8Length(pending, lexer->pendingLen, final);
+    if (length < 0)
+      return;
+
+    if (length == 0)
+    {
+      dfaStep(lexer, (char)pending[0], language->classOf[pending[0]]);
+      length = 1;
+    }
+    else if (lexer->offset == 0 && dfaHasBom((const char *)pending, length))
+      lexer->offset += length;
+    else
+      for (int i = 0; i < length; i++)
+        dfaStep(lexer, (char)pending[i], language->utf8Symbol);
+
+    lexer->pendingLen -= length;
+    memmove(pending, pending + length, lexer->pendingLen);
+  }
+}
+
+/*
+  Scans the next chunk of the input
+
+  @lexer: lexer to be used
+  @data: chunk of the input
+  @length: length of the chunk
+
+  Return: none
+*/
+static inline void dfaFeed(dfaLexer *lexer, const char *data, size_t length)
+{
+  const dfaLanguage *language = lexer->language;
+  size_t i = 0;
+
+  while (i < length)
+  {
+    if (lexer->pendingLen == 0)
+    {
+      size_t asciiEnd = findNonAscii(data + i, data + length) - data;
+      for (; i < asciiEnd; i++)
+        dfaStep(lexer, data[i], language->classOf[(uint8_t)data[i]]);
+      if (i == length)
+        break;
+    }
+
+    // a non-ASCII byte, or the rest of a sequence started earlier
+    uint8_t byte = data[i++];
+    if (language->utf8Symbol == DFA_NO_UTF8)
+      dfaStep(lexer, (char)byte, language->classOf[byte]);
+    else
+    {
+      lexer->pending[lexer->pendingLen++] = byte;
+      dfaDecodePending(lexer, 0);
+    }
+  }
+}
+
+/*
+  Closes the input, flushing the lexeme in progress
+
+  @lexer: lexer to be used
+
+  the end of input is processed as eofSymbol, a state that would loop on it
+  forever (unterminated strings and comments) becomes an error
+
+  Return: none
+*/
+static inline void dfaFinish(dfaLexer *lexer)
+{
+  const dfaLanguage *language = lexer->language;
+
+  dfaDecodePending(lexer, 1);
+  while (lexer->state != 0 || lexer->bufferLen > 0)
+  {
+    int previous = lexer->state;
+    lexer->state = language->next[lexer->state][language->eofSymbol];
+    if (lexer->state == previous)
+      lexer->state = language->failState;
+    if (lexer->state >= language->finalStart)
+      dfaEmit(lexer);
+  }
+}
+
+/*
+  Symbols of the input of a buffer scan
+
+  @asciiEnd: the bytes from the last check up to here are ASCII
+  @runStart, @runCount, @run: symbols of the last non-ASCII run decoded
+*/
+struct dfaReader
+{
+  size_t asciiEnd;
+  size_t runStart;
+  size_t runCount;
+  uint8_t run[DFA_RUN_SIZE];
+};
+typedef struct dfaReader dfaReader;
+
+/*
+  Decodes the non-ASCII run starting at a position
+
+  @language: descriptor of the language
+  @data, @length: input buffer
+  @position: first byte of the run
+  @reader: reader to store the symbols in
+
+  up to DFA_RUN_SIZE bytes are decoded, the run stops at the next ASCII byte
+  and never splits a sequence
+
+  Return: none
+*/
+static inline void dfaDecodeRun(const dfaLanguage *language, const char *data, size_t length, size_t position,
+                                dfaReader *reader)
+{
+  const uint8_t *bytes = (const uint8_t *)data;
+  size_t end = position;
+
+  while (end < length && bytes[end] >= 0x80)
+  {
+    int sequence = dfaUtf8Length(bytes + end, length - end, 1);
+    if (sequence == 0)
+    {
+      if (end - position == DFA_RUN_SIZE)
+        break;
+      reader->run[end - position] = language->classOf[bytes[end]];
+      end++;
+      continue;
+    }
+    if (end - position + sequence > DFA_RUN_SIZE)
+      break;
+    for (int i = 0; i < sequence; i++)
+      reader->run[end - position + i] = language->utf8Symbol;
+    end += sequence;
+  }
+
+  reader->runStart = position;
+  reader->runCount = end - position;
+}
+
+/*
+  Gets the symbol of a byte outside the known ASCII block
+
+  @language: descriptor of the language
+  @data, @length: input buffer
+  @position: position of the byte, length for the end of input
+  @reader: reader of the scan
+
+  the sequences are decoded left to right, so the positions must not go back
+  into a run that was already left
+
+  Return: symbol of the byte
+*/
+static inline int dfaSymbolSlow(const dfaLanguage *language, const char *data, size_t length, size_t position,
+                                dfaReader *reader)
+{
+  if (position >= length)
+    return language->eofSymbol;
+
+  uint8_t byte = (uint8_t)data[position];
+  if (byte < 0x80)
+  {
+    size_t blockEnd = length - position > DFA_ASCII_BLOCK ? position + DFA_ASCII_BLOCK : length;
+    reader->asciiEnd = findNonAscii(data + position, data + blockEnd) - data;
+    return language->classOf[byte];
+  }
+  if (language->utf8Symbol == DFA_NO_UTF8)
+    return language->classOf[byte];
+
+  if (position - reader->runStart >= reader->runCount)
+    dfaDecodeRun(language, data, length, position, reader);
+  return reader->run[position - reader->runStart];
+}
+
+/*
+  Gets the symbol of a byte
+
+  Return: symbol of the byte, eofSymbol at the end of input
+*/
+static inline int dfaSymbol(const dfaLanguage *language, const char *data, size_t length, size_t position,
+                            dfaReader *reader)
+{
+  if (position < reader->asciiEnd)
+    return language->classOf[(uint8_t)data[position]];
+  return dfaSymbolSlow(language, data, length, position, reader);
+}
+
+/*
+  Position of a buffer scan, enough to resume it later
+
+  @state: DFA state, 0 between lexemes
+  @lexemeStart, @lexemeEnd: view of the lexeme in progress
+  @lineOffset: where the line breaks have been counted up to
+  @line: line breaks between the start of the scan and lineOffset
+*/
+struct dfaCursor
+{
+  size_t position;
+  int state;
+  size_t lexemeStart;
+  size_t lexemeEnd;
+  size_t lineOffset;
+  size_t line;
+};
+typedef struct dfaCursor dfaCursor;
+
+/*
+  Scans part of an input buffer in place
+
+  @language: descriptor of the language
+  @data, @length: input buffer
+  @skip: 1 to jump over the runs of the states in skipTo with findByte
+  @cursor: where the scan starts, updated with where it stopped
+  @limit: position where the scan stops, must be a line break unless it's the end of the buffer
+  @onToken: function called for every lexeme, the lexeme is a view into data
+  @context: pointer passed to onToken
+
+  the view spans from the first to the last character that the dfaLexer would
+  have buffered, without its length limit
+  tokens get the line of the cursor plus the line breaks since its lineOffset
+  (1 for the first line of a whole input)
+
+  at the limit, a lexeme that the line break closes without being consumed is
+  still finished here, so a fresh scan starting at the limit in state 0 gives
+  the same result as going on from the cursor
+
+  Return: 1 if a fresh scan from the limit is equivalent, 0 if the scan has to
+  be resumed from the cursor (e.g. the limit is inside a string or comment)
+*/
+static inline int dfaScanRange(const dfaLanguage *language, const char *data, size_t length, int skip,
+                               dfaCursor *cursor, size_t limit, dfaTokenCallback onToken, void *context)
+{
+  size_t position = cursor->position;
+  size_t skipEnd = limit < length ? limit : length;
+
+  // lexeme view, lexemeEnd == lexemeStart while nothing has been buffered
+  size_t lexemeStart = cursor->lexemeStart;
+  size_t lexemeEnd = cursor->lexemeEnd;
+
+  // line breaks are only counted between tokens, not per transition
+  size_t lineOffset = cursor->lineOffset;
+  size_t line = cursor->line;
+
+  int state = cursor->state;
+  int stopping = 0;
+
+  if (position == 0 && state == 0 && language->utf8Symbol != DFA_NO_UTF8 && dfaHasBom(data, length))
+    position = lexemeStart = lexemeEnd = 3;
+
+  dfaReader reader = {position, position, 0, {0}};
+  int symbol = dfaSymbol(language, data, length, position, &reader);
+
+  while (position < length)
+  {
+    if (state == 0)
+      lexemeStart = lexemeEnd = position;
+
+    while (state < language->finalStart)
+    {
+      if (position == limit && limit < length && !stopping)
+      {
+        int next = language->next[state][symbol];
+        if (next < language->finalStart || (language->actions[next][symbol] & DFA_CONSUME))
+        {
+          // nothing pending and the same state a fresh scan reaches
+          int synced = lexemeEnd == lexemeStart && next == language->next[0][symbol];
+          cursor->position = position;
+          cursor->state = synced ? 0 : state;
+          cursor->lexemeStart = lexemeStart;
+          cursor->lexemeEnd = lexemeEnd;
+          cursor->lineOffset = lineOffset;
+          cursor->line = line;
+          return synced;
+        }
+        stopping = 1;
+      }
+
+      // every byte of the run would be buffered, so the view just grows to the terminator
+      if (skip && language->skipTo[state] != NO_SKIP && position < length && lexemeEnd > lexemeStart)
+      {
+        const char *stop = findByte(data + position, data + skipEnd, (char)language->skipTo[state]);
+        if (stop > data + position)
+        {
+          position = stop - data;
+          lexemeEnd = position;
+          symbol = dfaSymbol(language, data, length, position, &reader);
+          continue;
+        }
+      }
+
+      int previous = state;
+      state = language->next[state][symbol];
+      if (position >= length && state == previous)
+      {
+        state = language->failState;
+        break;
+      }
+      if (position >= length)
+        continue;
+
+      int action = language->actions[state][symbol];
+      // views have no length limit
+      if (action & DFA_BUFFER)
+      {
+        if (lexemeEnd == lexemeStart)
+          lexemeStart = position;
+        lexemeEnd = position + 1;
+      }
+      if (action & DFA_CONSUME)
+        symbol = dfaSymbol(language, data, length, ++position, &reader);
+    }
+
+    int accepted = dfaAccepts(language, state);
+    if (accepted || lexemeEnd > lexemeStart)
+    {
+      line += countLines(data + lineOffset, data + lexemeStart);
+      lineOffset = lexemeStart;
+      onToken(context, accepted ? dfaTokenId(language, state, data + lexemeStart, lexemeEnd - lexemeStart) : DFA_ERROR,
+              data + lexemeStart, lexemeEnd - lexemeStart, lexemeStart, line + 1);
+    }
+
+    state = 0;
+    if (stopping)
+      break;
+  }
+
+  cursor->position = position;
+  cursor->state = 0;
+  cursor->lexemeStart = cursor->lexemeEnd = position;
+  cursor->lineOffset = lineOffset;
+  cursor->line = line;
+  return 1;
+}
+
+#endif
@@ -0,0 +1,519 @@
+#ifndef EARLEY_H
+#define EARLEY_H
+
+/*
+  Earley recognizer for the grammar files (grammar5.md and its revisions),
+  read when the program starts instead of generated into tables or code
+
+  it accepts any context-free grammar, ambiguous, left recursive or with
+  nullable symbols anywhere, in O(n³) time at worst, and in linear time on
+  the unambiguous inputs of this grammar:
+  - the items a set predicts (X -> · α) aren't stored, a bitset of the
+    predicted nonterminals per position stands for them
+  - nullable symbols are skipped as they are predicted (Aycock and Horspool),
+    so a set is final once it has been processed
+  - deterministic chains of completions, the right recursive lists, complete
+    through one transitive item per set (Leo) instead of one item per level
+  every set is contiguous in one array, sorted by the nonterminal its items
+  wait for once the set is final
+*/
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "tokfile.h"
+
+// a terminal of the grammar files and the token id the scanner gives it
+struct earleyTerminal
+{
+  const char *name;
+  int id;
+};
+
+// counters of a parse
+struct earleyStats
+{
+  size_t items = 0;
+  size_t predictions = 0;
+  size_t completions = 0;
+  // completions that went through a transitive item
+  size_t transitive = 0;
+};
+
+/*
+  Grammar read from a file as python/llgen.py reads it: the lines with ->,
+  "X -> a b | c", consecutive lines of a nonterminal are one definition and
+  then the first definition wins, <!-- --> comments are skipped, ε or e is
+  the empty alternative, the symbols no line defines are terminals, written
+  _name_ or name
+*/
+class EarleyGrammar
+{
+public:
+  int terminals;
+  int nonterminals;
+  std::vector<std::string> names;
+  // token id -> terminal, -1 for the ids the grammar doesn't use
+  std::vector<int> terminalOf;
+  // symbols: terminals first, then the nonterminals, the first one is the start
+  std::vector<int> lhs;
+  std::vector<uint32_t> rhsStart;
+  std::vector<int> rhs;
+
+  // slot: production with a dot, the slots of production p start at rhsStart[p] + p
+  std::vector<uint32_t> slotProduction;
+  // symbol after the dot, -1 at the end
+  std::vector<int> slotNext;
+  std::vector<uint8_t> nullable;
+  // words of a nonterminal bitset, closure: the nonterminals predicting one predicts
+  int words;
+  std::vector<uint64_t> closure;
+  // slots after the first symbol: of the productions starting with each
+  // nonterminal, each terminal, and of the ones of each nonterminal that start
+  // with a nullable nonterminal
+  std::vector<std::vector<uint32_t>> startsWith;
+  std::vector<std::vector<uint32_t>> scanStarts;
+  std::vector<std::vector<uint32_t>> nullableStarts;
+  // root -> start, completed over the whole input when it is accepted
+  int root;
+  uint32_t rootEnd;
+
+  /*
+    @filename: grammar file
+    @tokens: name and token id of every terminal the file uses, token ids go
+    through grammarTokenId() before the lookup
+  */
+  EarleyGrammar(const std::string &filename, const std::vector<earleyTerminal> &tokens)
+  {
+    std::ifstream file(filename);
+    if (!file)
+      throw std::runtime_error(filename + ": can't be read");
+
+    std::stringstream contents;
+    contents << file.rdbuf();
+    std::string text = contents.str();
+    for (size_t open = text.find("<!--"); open != std::string::npos; open = text.find("<!--", open))
+    {
+      size_t close = text.find("-->", open);
+      text.erase(open, close == std::string::npos ? std::string::npos : close + 3 - open);
+    }
+
+    std::vector<std::pair<std::string, std::vector<std::vector<std::string>>>> rules;
+    std::unordered_map<std::string, int> defined;
+    std::string last;
+    std::istringstream lines(text);
+    std::string line;
+    while (std::getline(lines, line))
+    {
+      size_t arrow = line.find("->");
+      if (arrow == std::string::npos)
+        continue;
+      std::string left;
+      std::istringstream leftWords(line.substr(0, arrow));
+      leftWords >> left;
+      std::string extra;
+      if (left.empty() || leftWords >> extra)
+        continue;
+      // the line right after a definition of the same nonterminal goes on with it
+      if (left != last && defined.count(left))
+      {
+        last.clear();
+        continue;
+      }
+      if (left != last)
+      {
+        defined[left] = (int)rules.size();
+        rules.emplace_back(left, std::vector<std::vector<std::string>>());
+        last = left;
+      }
+
+      std::string right = line.substr(arrow + 2);
+      for (size_t start = 0, bar;; start = bar + 1)
+      {
+        bar = right.find('|', start);
+        std::istringstream words(right.substr(start, bar == std::string::npos ? std::string::npos : bar - start));
+        std::vector<std::string> alternative;
+        std::string symbol;
+        while (words >> symbol)
+          if (symbol != "ε" && symbol != "e")
+            alternative.push_back(symbol);
+        rules.back().second.push_back(alternative);
+        if (bar == std::string::npos)
+          break;
+      }
+    }
+    if (rules.empty())
+      throw std::runtime_error(filename + ": no productions");
+
+    std::unordered_map<std::string, int> terminalIndex;
+    terminalOf.assign(256, -1);
+    for (const earleyTerminal &token : tokens)
+    {
+      terminalIndex[token.name] = (int)names.size();
+      terminalOf[token.id] = (int)names.size();
+      names.push_back(token.name);
+    }
+    terminals = (int)names.size();
+    nonterminals = (int)rules.size() + 1;
+    for (auto &rule : rules)
+      names.push_back(rule.first);
+    root = nonterminals - 1;
+    names.push_back("<root>");
+
+    for (size_t n = 0; n < rules.size(); n++)
+      for (auto &alternative : rules[n].second)
+      {
+        lhs.push_back((int)n);
+        rhsStart.push_back((uint32_t)rhs.size());
+        for (const std::string &symbol : alternative)
+        {
+          if (defined.count(symbol))
+          {
+            rhs.push_back(terminals + defined[symbol]);
+            continue;
+          }
+          std::string name = symbol.size() > 2 && symbol.front() == '_' && symbol.back() == '_'
+                                 ? symbol.substr(1, symbol.size() - 2)
+                                 : symbol;
+          if (!terminalIndex.count(name))
+            throw std::runtime_error(filename + ": terminal '" + name + "' has no token id");
+          rhs.push_back(terminalIndex[name]);
+        }
+      }
+    lhs.push_back(root);
+    rhsStart.push_back((uint32_t)rhs.size());
+    rhs.push_back(terminals);
+    rhsStart.push_back((uint32_t)rhs.size());
+    rootEnd = slotOf((int)lhs.size() - 1, 1);
+
+    prepare();
+  }
+
+  int productions() const
+  {
+    return (int)lhs.size();
+  }
+
+  uint32_t slotOf(int production, int dot) const
+  {
+    return rhsStart[production] + production + dot;
+  }
+
+  bool isNonterminal(int symbol) const
+  {
+    return symbol >= terminals;
+  }
+
+private:
+  // nullable symbols, prediction closures and the slot tables
+  void prepare()
+  {
+    for (int p = 0; p < productions(); p++)
+    {
+      for (uint32_t i = rhsStart[p]; i < rhsStart[p + 1]; i++)
+      {
+        slotProduction.push_back(p);
+        slotNext.push_back(rhs[i]);
+      }
+      slotProduction.push_back(p);
+      slotNext.push_back(-1);
+    }
+
+    nullable.assign(nonterminals, 0);
+    for (bool changed = true; changed;)
+    {
+      changed = false;
+      for (int p = 0; p < productions(); p++)
+      {
+        if (nullable[lhs[p]])
+          continue;
+        bool empty = true;
+        for (uint32_t i = rhsStart[p]; i < rhsStart[p + 1] && empty; i++)
+          empty = isNonterminal(rhs[i]) && nullable[rhs[i] - terminals];
+        if (empty)
+          nullable[lhs[p]] = changed = true;
+      }
+    }
+
+    words = (nonterminals + 63) / 64;
+    closure.assign((size_t)nonterminals * words, 0);
+    for (int n = 0; n < nonterminals; n++)
+      closure[(size_t)n * words + n / 64] |= 1ull << (n % 64);
+    for (bool changed = true; changed;)
+    {
+      changed = false;
+      for (int p = 0; p < productions(); p++)
+      {
+        if (rhsStart[p] == rhsStart[p + 1] || !isNonterminal(rhs[rhsStart[p]]))
+          continue;
+        uint64_t *into = &closure[(size_t)lhs[p] * words];
+        const uint64_t *from = &closure[(size_t)(rhs[rhsStart[p]] - terminals) * words];
+        for (int w = 0; w < words; w++)
+          if (from[w] & ~into[w])
+          {
+            into[w] |= from[w];
+            changed = true;
+          }
+      }
+    }
+
+    startsWith.assign(nonterminals, {});
+    scanStarts.assign(terminals, {});
+    nullableStarts.assign(nonterminals, {});
+    for (int p = 0; p < productions(); p++)
+    {
+      if (rhsStart[p] == rhsStart[p + 1])
+        continue;
+      int first = rhs[rhsStart[p]];
+      if (!isNonterminal(first))
+      {
+        scanStarts[first].push_back(slotOf(p, 1));
+        continue;
+      }
+      startsWith[first - terminals].push_back(slotOf(p, 1));
+      if (nullable[first - terminals])
+        nullableStarts[lhs[p]].push_back(slotOf(p, 1));
+    }
+  }
+};
+
+class EarleyParser
+{
+private:
+  struct item
+  {
+    uint32_t slot;
+    uint32_t origin;
+  };
+
+  static constexpr uint64_t NO_ITEM = UINT64_MAX;
+
+  const EarleyGrammar &grammar;
+  // non-owning, the scanner's stream or a mapped token file outlives the parser
+  tokenSpan tokens;
+
+  // set i is items[setStart[i], setStart[i + 1])
+  std::vector<item> items;
+  std::vector<size_t> setStart;
+  // predicted nonterminals of every set, grammar.words per set
+  std::vector<uint64_t> predicted;
+  // items of the set being processed, then of the next one
+  std::unordered_set<uint64_t> seen;
+  std::vector<item> next;
+  // (set, nonterminal) -> transitive item, NO_ITEM if the completions there aren't deterministic
+  std::unordered_map<uint64_t, uint64_t> transitive;
+
+  size_t errorPos = 0;
+  earleyStats stats;
+
+  static uint64_t keyOf(item it)
+  {
+    return (uint64_t)it.slot << 32 | it.origin;
+  }
+
+  int column(size_t position)
+  {
+    return position < tokens.count ? grammar.terminalOf[grammarTokenId(tokens[position])] : -1;
+  }
+
+  bool isPredicted(size_t set, int nonterminal)
+  {
+    return predicted[set * grammar.words + nonterminal / 64] >> (nonterminal % 64) & 1;
+  }
+
+  // sort key of a final set: the nonterminal an item waits for, nonterminals for the others
+  int waitsFor(item it)
+  {
+    int symbol = grammar.slotNext[it.slot];
+    return grammar.isNonterminal(symbol) ? symbol - grammar.terminals : grammar.nonterminals;
+  }
+
+  // indexes of the items of a final set that wait for a nonterminal, items grows while they're used
+  std::pair<size_t, size_t> waiting(size_t set, int nonterminal)
+  {
+    auto first = std::partition_point(items.begin() + setStart[set], items.begin() + setStart[set + 1],
+                                      [&](const item &it)
+                                      { return waitsFor(it) < nonterminal; });
+    auto last = std::partition_point(first, items.begin() + setStart[set + 1], [&](const item &it)
+                                     { return waitsFor(it) == nonterminal; });
+    return {(size_t)(first - items.begin()), (size_t)(last - items.begin())};
+  }
+
+  void add(item it)
+  {
+    if (seen.insert(keyOf(it)).second)
+      items.push_back(it);
+  }
+
+  // predicts a nonterminal in the current set, with everything it predicts
+  void predict(size_t set, int nonterminal)
+  {
+    uint64_t *bits = &predicted[set * grammar.words];
+    const uint64_t *closure = &grammar.closure[(size_t)nonterminal * grammar.words];
+    for (int w = 0; w < grammar.words; w++)
+    {
+      uint64_t fresh = closure[w] & ~bits[w];
+      bits[w] |= fresh;
+      for (; fresh; fresh &= fresh - 1)
+      {
+        int predictedNonterminal = w * 64 + __builtin_ctzll(fresh);
+        stats.predictions++;
+        for (uint32_t slot : grammar.nullableStarts[predictedNonterminal])
+          add({slot, (uint32_t)set});
+      }
+    }
+  }
+
+  /*
+    Gets the transitive item of a nonterminal completed from a set: when a
+    single item there waits for it and that item is complete once it
+    advances, completing the nonterminal only completes that item, and so on
+    up the chain
+
+    @set: final set the nonterminal started at
+    @nonterminal: the completed nonterminal
+
+    Return: the top of the chain, NO_ITEM if the first step isn't deterministic
+  */
+  uint64_t transitiveItem(size_t set, int nonterminal)
+  {
+    uint64_t key = (uint64_t)set << 32 | (uint32_t)nonterminal;
+    auto found = transitive.find(key);
+    if (found != transitive.end())
+      return found->second;
+    // a unit cycle comes back here and stops
+    transitive[key] = NO_ITEM;
+
+    auto range = waiting(set, nonterminal);
+    size_t count = range.second - range.first;
+    item advanced = {0, 0};
+    if (count == 1)
+      advanced = {items[range.first].slot + 1, items[range.first].origin};
+    for (uint32_t slot : grammar.startsWith[nonterminal])
+      if (isPredicted(set, grammar.lhs[grammar.slotProduction[slot]]) && ++count == 1)
+        advanced = {slot, (uint32_t)set};
+    if (count != 1 || grammar.slotNext[advanced.slot] != -1)
+      return NO_ITEM;
+
+    uint64_t above = transitiveItem(advanced.origin, grammar.lhs[grammar.slotProduction[advanced.slot]]);
+    uint64_t result = above != NO_ITEM ? above : keyOf(advanced);
+    transitive[key] = result;
+    return result;
+  }
+
+  // advances the items of a final set that wait for a nonterminal completed in the current one
+  void complete(size_t set, int nonterminal)
+  {
+    stats.completions++;
+    uint64_t top = transitiveItem(set, nonterminal);
+    if (top != NO_ITEM)
+    {
+      stats.transitive++;
+      add({(uint32_t)(top >> 32), (uint32_t)top});
+      return;
+    }
+
+    auto range = waiting(set, nonterminal);
+    for (size_t i = range.first; i < range.second; i++)
+      add({items[i].slot + 1, items[i].origin});
+    for (uint32_t slot : grammar.startsWith[nonterminal])
+      if (isPredicted(set, grammar.lhs[grammar.slotProduction[slot]]))
+        add({slot, (uint32_t)set});
+  }
+
+public:
+  /*
+    @grammar: grammar to be used, outlives the parser
+    @tokens: stream to be parsed
+  */
+  EarleyParser(const EarleyGrammar &grammar, tokenSpan tokens)
+      : grammar(grammar), tokens(tokens) {}
+
+  /*
+    Recognizes the whole stream, once
+
+    Return: true if it derives from the start symbol, if not the error is at
+    getErrorPosition()
+  */
+  bool parse()
+  {
+    size_t count = tokens.count;
+    predicted.assign((count + 1) * grammar.words, 0);
+    setStart.assign(1, 0);
+    predict(0, grammar.root);
+
+    for (size_t set = 0;; set++)
+    {
+      for (size_t i = setStart[set]; i < items.size(); i++)
+      {
+        item it = items[i];
+        int symbol = grammar.slotNext[it.slot];
+        if (symbol == -1)
+        {
+          // a nonterminal completed where it started was skipped when it was predicted
+          if (it.origin < set)
+            complete(it.origin, grammar.lhs[grammar.slotProduction[it.slot]]);
+        }
+        else if (!grammar.isNonterminal(symbol))
+        {
+          if (symbol == column(set))
+            next.push_back({it.slot + 1, it.origin});
+        }
+        else
+        {
+          predict(set, symbol - grammar.terminals);
+          if (grammar.nullable[symbol - grammar.terminals])
+            add({it.slot + 1, it.origin});
+        }
+      }
+
+      int terminal = column(set);
+      if (terminal != -1)
+        for (uint32_t slot : grammar.scanStarts[terminal])
+          if (isPredicted(set, grammar.lhs[grammar.slotProduction[slot]]))
+            next.push_back({slot, (uint32_t)set});
+
+      std::sort(items.begin() + setStart[set], items.end(), [&](const item &a, const item &b)
+                { return waitsFor(a) < waitsFor(b); });
+      setStart.push_back(items.size());
+      stats.items = items.size();
+
+      if (set == count)
+        break;
+      if (next.empty())
+      {
+        errorPos = set;
+        return false;
+      }
+      seen.clear();
+      for (const item &it : next)
+        add(it);
+      next.clear();
+    }
+
+    for (size_t i = setStart[count]; i < setStart[count + 1]; i++)
+      if (items[i].slot == grammar.rootEnd && items[i].origin == 0)
+        return true;
+    errorPos = count;
+    return false;
+  }
+
+  // position of the token no item could go on with, the token count for a premature end
+  size_t getErrorPosition()
+  {
+    return errorPos;
+  }
+
+  // size of the sets and completions of the last parse
+  const earleyStats &getStats()
+  {
+    return stats;
+  }
+};
+
+#endif
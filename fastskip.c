@@ -0,0 +1,103 @@
+#include <stddef.h>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+#define NO_SKIP -1
+
+/*
+  Finds the next occurrence of a byte
+
+  @position: where the search starts
+  @end: end of the buffer
+  @target: byte to look for
+
+  compares 32 (AVX2) or 16 (SSE2) bytes per step, the tail and builds without
+  either instruction set use the scalar loop
+
+  Return: pointer to the byte, or end if it doesn't appear
+*/
+const char *findByte(const char *position, const char *end, char target)
+{
+#if defined(__AVX2__)
+  __m256i wide = _mm256_set1_epi8(target);
+  while (end - position >= 32)
+  {
+    __m256i block = _mm256_loadu_si256((const __m256i *)position);
+    unsigned mask = _mm256_movemask_epi8(_mm256_cmpeq_epi8(block, wide));
+    if (mask)
+      return position + __builtin_ctz(mask);
+    position += 32;
+  }
+#endif
+#if defined(__SSE2__)
+  __m128i narrow = _mm_set1_epi8(target);
+  while (end - position >= 16)
+  {
+    __m128i block = _mm_loadu_si128((const __m128i *)position);
+    unsigned mask = _mm_movemask_epi8(_mm_cmpeq_epi8(block, narrow));
+    if (mask)
+      return position + __builtin_ctz(mask);
+    position += 16;
+  }
+#endif
+  while (position < end && *position != target)
+    position++;
+  return position;
+}
+
+/*
+  Finds the next byte outside of ASCII
+
+  @position: where the search starts
+  @end: end of the buffer
+
+  the sign bits of 32 (AVX2) or 16 (SSE2) bytes are tested per step, so a pure
+  ASCII block costs a load and a movemask
+
+  Return: pointer to the byte, or end if the range is pure ASCII
+*/
+const char *findNonAscii(const char *position, const char *end)
+{
+#if defined(__AVX2__)
+  while (end - position >= 32)
+  {
+    unsigned mask = _mm256_movemask_epi8(_mm256_loadu_si256((const __m256i *)position));
+    if (mask)
+      return position + __builtin_ctz(mask);
+    position += 32;
+  }
+#endif
+#if defined(__SSE2__)
+  while (end - position >= 16)
+  {
+    unsigned mask = _mm_movemask_epi8(_mm_loadu_si128((const __m128i *)position));
+    if (mask)
+      return position + __builtin_ctz(mask);
+    position += 16;
+  }
+#endif
+  while (position < end && !(*position & 0x80))
+    position++;
+  return position;
+}
+
+/*
+  Counts the line breaks in a range
+
+  @position: start of the range
+  @end: end of the range
+
+  Return: number of '\n' between position and end
+*/
+size_t countLines(const char *position, const char *end)
+{
+  size_t lines = 0;
+  while ((position = findByte(position, end, '\n')) < end)
+  {
+    lines++;
+    position++;
+  }
+  return lines;
+}
@@ -0,0 +1,681 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <algorithm>
+#include <stdexcept>
+#include <math.h>
+#include "tokfile.h"
+#include "grammar5_tables.h"
+
+/*
+  Generalized LL parser (GLL, Scott and Johnstone) for the ambiguous paradigm
+  grammar
+
+  RecursiveDescentParser (parser100.cpp) tries the alternatives one after the
+  other and keeps the first that works, so an input that derives as OOP, PP and
+  MIXED only ever reports one of them
+  here every alternative the lookahead allows is followed at once: calls share
+  a graph structured stack (GSS), a nonterminal is parsed once per position
+  whatever the number of callers, and the results go into a shared packed
+  parse forest (SPPF) that holds every derivation of the input
+  one pass over the tokens, cubic time in the worst case and close to linear
+  when FIRST+ keeps the live alternatives down
+  right-recursive lists (STATEMENTS and STATEMENTS', IDS, ...) are parsed as a
+  loop: a production that ends calling back into its own list goes on in the
+  GSS node the list was entered with, so the forest gets one node per end of
+  the list and not one per element and end
+
+  the grammar comes from the tables python/llgen.py generates, the same ones
+  the LL(1) driver (ll1.h) reads
+*/
+
+// generated tables of a grammar, the part a GLL parse reads
+struct gllGrammar
+{
+  const uint8_t *columnOf;
+  const uint16_t *rhsStart;
+  const uint8_t *rhs;
+  const uint8_t *lhs;
+  const uint8_t *firstProduction;
+  const uint32_t *firstPlus;
+  int columns;
+  int productions;
+};
+
+static const gllGrammar paradigmGrammar = {grammar5ColumnOf, grammar5RhsStart, grammar5Rhs, grammar5Lhs,
+                                           grammar5FirstProduction, grammar5FirstPlus, GRAMMAR5_COLUMNS,
+                                           GRAMMAR5_PRODUCTIONS};
+
+// counters of a parse
+struct gllStats
+{
+  size_t descriptors = 0;
+  size_t gssNodes = 0;
+  size_t gssEdges = 0;
+  size_t sppfNodes = 0;
+  size_t packedNodes = 0;
+};
+
+// a nonterminal that derives [left, right) of the input through one production
+struct gllDerivation
+{
+  int production;
+  size_t left;
+  size_t right;
+};
+
+class GLLParser
+{
+private:
+  static constexpr uint32_t NO_NODE = UINT32_MAX;
+  // SPPF labels: terminal columns, then nonterminals from GRAMMAR5_NONTERMINAL_BASE,
+  // ε, and the grammar slots (X -> α · β) of the intermediate nodes
+  static constexpr uint32_t EPSILON_LABEL = GRAMMAR5_NONE;
+  static constexpr uint32_t SLOT_LABEL = 256;
+  // positions are packed in 24 bits in the node keys
+  static constexpr size_t MAX_TOKENS = (1u << 24) - 1;
+
+  struct sppfNode
+  {
+    uint32_t label;
+    uint32_t left;
+    uint32_t right;
+    uint32_t firstPacked;
+  };
+
+  // one way to derive a node: the slot it was completed at, split at pivot
+  struct packedNode
+  {
+    uint32_t slot;
+    uint32_t pivot;
+    uint32_t leftChild;
+    uint32_t rightChild;
+    uint32_t next;
+  };
+
+  // call of a nonterminal: the slot to return to and where the call started
+  struct gssNode
+  {
+    uint32_t slot;
+    uint32_t position;
+    uint32_t firstEdge;
+    uint32_t firstPopped;
+  };
+
+  // caller of a GSS node and the SPPF node of what it had parsed so far
+  struct gssEdge
+  {
+    uint32_t target;
+    uint32_t sppf;
+    uint32_t next;
+  };
+
+  // results a GSS node already returned, replayed for callers that come later
+  struct gssPopped
+  {
+    uint32_t sppf;
+    uint32_t next;
+  };
+
+  // unit of work: go on from slot with the stack top gss at position
+  struct descriptor
+  {
+    uint32_t slot;
+    uint32_t gss;
+    uint32_t position;
+    uint32_t sppf;
+  };
+
+  // key of the sets that keep descriptors, GSS edges, popped results and packed nodes unique
+  struct tripleKey
+  {
+    uint32_t a;
+    uint32_t b;
+    uint32_t c;
+
+    bool operator==(const tripleKey &other) const
+    {
+      return a == other.a && b == other.b && c == other.c;
+    }
+  };
+
+  struct tripleHash
+  {
+    size_t operator()(const tripleKey &key) const
+    {
+      return std::hash<uint64_t>()(((uint64_t)key.a << 32 | key.b) * 0x9e3779b97f4a7c15ull ^ key.c);
+    }
+  };
+
+  // non-owning, the scanner's stream or a mapped token file outlives the parser
+  tokenSpan tokens;
+  const gllGrammar &grammar;
+  int start;
+
+  // slot -> production and dot, the slots of production p start at rhsStart[p] + p
+  std::vector<uint16_t> slotProduction;
+  std::vector<uint16_t> slotDot;
+  uint32_t rootSlot;
+  // production -> 1 if its last symbol loops back into the list it belongs to
+  std::vector<uint8_t> loops;
+  // nonterminal -> the one its list is entered through, itself outside lists
+  std::vector<uint8_t> listHead;
+
+  std::vector<sppfNode> nodes;
+  std::vector<packedNode> packed;
+  std::unordered_map<uint64_t, uint32_t> nodeIndex;
+  // (parent, slot, left child), the left child is the split point, or inside a list
+  // the element the production was reached from
+  std::unordered_set<tripleKey, tripleHash> packedIndex;
+  std::vector<gssNode> gss;
+  std::vector<gssEdge> edges;
+  std::vector<gssPopped> popped;
+  std::unordered_map<uint64_t, uint32_t> gssIndex;
+  // (node, target, sppf) and (node, sppf, 0), a call returns once per end position
+  std::unordered_set<tripleKey, tripleHash> edgeIndex;
+  std::unordered_set<tripleKey, tripleHash> poppedIndex;
+
+  // descriptors by position, every add is at the current position or later
+  std::vector<std::vector<descriptor>> pending;
+  std::unordered_set<tripleKey, tripleHash> seen;
+
+  uint32_t root = NO_NODE;
+  size_t furthest = 0;
+  gllStats stats;
+
+  int column(size_t position)
+  {
+    return position < tokens.count ? grammar.columnOf[tokens.ids[position]] : grammar.columns - 1;
+  }
+
+  uint32_t slotOf(int production, int dot)
+  {
+    return grammar.rhsStart[production] + production + dot;
+  }
+
+  int rhsLength(int production)
+  {
+    return grammar.rhsStart[production + 1] - grammar.rhsStart[production];
+  }
+
+  // last symbol of a production when it is a nonterminal, -1 if not
+  int lastNonterminal(int production)
+  {
+    int length = rhsLength(production);
+    if (!length || grammar.rhs[grammar.rhsStart[production] + length - 1] < GRAMMAR5_NONTERMINAL_BASE)
+      return -1;
+    return grammar.rhs[grammar.rhsStart[production] + length - 1] - GRAMMAR5_NONTERMINAL_BASE;
+  }
+
+  /*
+    Finds the right-recursive lists of the grammar: nonterminals that call each
+    other in a cycle from the last symbol of their productions, like
+    STATEMENTS -> STATEMENT STATEMENTS' and STATEMENTS' -> STATEMENTS | ε
+
+    a list is parsed as a loop when it is entered through one nonterminal only
+    and at most one of its productions is a lone call to another of its
+    nonterminals, so no two ways into an element lead to the same descriptor
+
+    Return: none
+  */
+  void findLists()
+  {
+    int nonterminals = grammar.lhs[grammar.productions - 1] + 1;
+    // reaches[a * nonterminals + b]: b is the last symbol of a, or of a nonterminal a reaches
+    std::vector<uint8_t> reaches(nonterminals * nonterminals, 0);
+    for (int p = 0; p < grammar.productions; p++)
+      if (lastNonterminal(p) >= 0)
+        reaches[grammar.lhs[p] * nonterminals + lastNonterminal(p)] = 1;
+    for (int k = 0; k < nonterminals; k++)
+      for (int a = 0; a < nonterminals; a++)
+        if (reaches[a * nonterminals + k])
+          for (int b = 0; b < nonterminals; b++)
+            reaches[a * nonterminals + b] |= reaches[k * nonterminals + b];
+
+    loops.assign(grammar.productions, 0);
+    for (int p = 0; p < grammar.productions; p++)
+      if (lastNonterminal(p) >= 0 && reaches[lastNonterminal(p) * nonterminals + grammar.lhs[p]])
+        loops[p] = 1;
+
+    // nonterminals called from outside their list, or the start symbol
+    std::vector<uint8_t> entered(nonterminals, 0);
+    entered[start] = 1;
+    for (int p = 0; p < grammar.productions; p++)
+      for (int dot = 0; dot < rhsLength(p); dot++)
+      {
+        int symbol = grammar.rhs[grammar.rhsStart[p] + dot];
+        if (symbol >= GRAMMAR5_NONTERMINAL_BASE && !(loops[p] && dot == rhsLength(p) - 1))
+          entered[symbol - GRAMMAR5_NONTERMINAL_BASE] = 1;
+      }
+
+    listHead.resize(nonterminals);
+    std::vector<uint8_t> looping(nonterminals, 0);
+    for (int a = 0; a < nonterminals; a++)
+    {
+      listHead[a] = a;
+      if (!reaches[a * nonterminals + a])
+        continue;
+      int entries = 0;
+      int lone = 0;
+      int head = a;
+      for (int b = 0; b < nonterminals; b++)
+      {
+        if (!reaches[a * nonterminals + b] || !reaches[b * nonterminals + a])
+          continue;
+        if (entered[b])
+        {
+          entries++;
+          head = b;
+        }
+        // a lone call to itself is a cycle of the grammar, it counts as two
+        for (int p = grammar.firstProduction[b]; p < grammar.firstProduction[b + 1]; p++)
+          if (loops[p] && rhsLength(p) == 1)
+            lone += lastNonterminal(p) == b ? 2 : 1;
+      }
+      if (entries == 1 && lone <= 1)
+      {
+        listHead[a] = head;
+        looping[a] = 1;
+      }
+    }
+    // the other lists are parsed with a call per element
+    for (int p = 0; p < grammar.productions; p++)
+      loops[p] &= looping[grammar.lhs[p]];
+  }
+
+  // finds or creates the SPPF node (label, left, right)
+  uint32_t node(uint32_t label, size_t left, size_t right)
+  {
+    uint64_t key = (uint64_t)label << 48 | (uint64_t)left << 24 | right;
+    auto found = nodeIndex.find(key);
+    if (found != nodeIndex.end())
+      return found->second;
+    nodes.push_back({label, (uint32_t)left, (uint32_t)right, NO_NODE});
+    nodeIndex.emplace(key, (uint32_t)(nodes.size() - 1));
+    return (uint32_t)(nodes.size() - 1);
+  }
+
+  void addPacked(uint32_t parent, uint32_t slot, uint32_t pivot, uint32_t leftChild, uint32_t rightChild)
+  {
+    if (!packedIndex.insert({parent, slot, leftChild}).second)
+      return;
+    packed.push_back({slot, pivot, leftChild, rightChild, nodes[parent].firstPacked});
+    nodes[parent].firstPacked = (uint32_t)(packed.size() - 1);
+  }
+
+  /*
+    Joins what a production had parsed (w) with the symbol that follows (z),
+    the SPPF is binarised so every node has at most two children
+
+    @slot: slot after the symbol
+    @w: node of the symbols before it, NO_NODE at the start of the production,
+    inside a list the elements before the production
+    @z: node of the symbol
+
+    Return: node of everything up to slot, the nonterminal node once the
+    production is complete, the one of the whole list inside a list
+  */
+  uint32_t extend(uint32_t slot, uint32_t w, uint32_t z)
+  {
+    int production = slotProduction[slot];
+    int dot = slotDot[slot];
+    int length = rhsLength(production);
+    // a single symbol that isn't the whole production needs no node of its own,
+    // unless the list goes on from it
+    if (dot == 1 && dot < length && w == NO_NODE && !(loops[production] && dot == length - 1))
+      return z;
+
+    uint32_t label = dot == length ? GRAMMAR5_NONTERMINAL_BASE + listHead[grammar.lhs[production]] : SLOT_LABEL + slot;
+    uint32_t left = w == NO_NODE ? nodes[z].left : nodes[w].left;
+    uint32_t parent = node(label, left, nodes[z].right);
+    addPacked(parent, slot, nodes[z].left, w, z);
+    return parent;
+  }
+
+  void add(uint32_t slot, uint32_t u, size_t position, uint32_t w)
+  {
+    pending[position].push_back({slot, u, (uint32_t)position, w});
+  }
+
+  /*
+    Calls a nonterminal: the GSS node (slot, position) is shared by every caller
+    that returns to slot from there, a caller that comes after the nonterminal
+    already returned gets those results replayed
+
+    @slot: where the caller goes on once the nonterminal is parsed
+    @u: stack top of the caller
+    @position: where the nonterminal starts
+    @w: SPPF node of what the caller had parsed
+
+    Return: the GSS node of the call
+  */
+  uint32_t create(uint32_t slot, uint32_t u, size_t position, uint32_t w)
+  {
+    uint64_t key = (uint64_t)slot << 32 | position;
+    auto found = gssIndex.find(key);
+    uint32_t v;
+    if (found == gssIndex.end())
+    {
+      gss.push_back({slot, (uint32_t)position, NO_NODE, NO_NODE});
+      v = (uint32_t)(gss.size() - 1);
+      gssIndex.emplace(key, v);
+    }
+    else
+      v = found->second;
+
+    if (!edgeIndex.insert({v, u, w}).second)
+      return v;
+    edges.push_back({u, w, gss[v].firstEdge});
+    gss[v].firstEdge = (uint32_t)(edges.size() - 1);
+
+    for (uint32_t p = gss[v].firstPopped; p != NO_NODE; p = popped[p].next)
+    {
+      uint32_t z = popped[p].sppf;
+      add(slot, u, nodes[z].right, extend(slot, w, z));
+    }
+    return v;
+  }
+
+  // returns from a call with the node z of the nonterminal, to every caller of u
+  void pop(uint32_t u, size_t position, uint32_t z)
+  {
+    if (gss[u].slot == rootSlot)
+      return;
+    if (!poppedIndex.insert({u, z, 0}).second)
+      return;
+    popped.push_back({z, gss[u].firstPopped});
+    gss[u].firstPopped = (uint32_t)(popped.size() - 1);
+
+    uint32_t slot = gss[u].slot;
+    for (uint32_t e = gss[u].firstEdge; e != NO_NODE; e = edges[e].next)
+      add(slot, edges[e].target, position, extend(slot, edges[e].sppf, z));
+  }
+
+  // queues the alternatives of a nonterminal whose FIRST+ holds the current token,
+  // w is what the list had parsed when the nonterminal goes on with it
+  void call(int nonterminal, uint32_t u, size_t position, uint32_t w = NO_NODE)
+  {
+    furthest = std::max(furthest, position);
+    int c = column(position);
+    if (c == GRAMMAR5_NONE)
+      return;
+    for (int p = grammar.firstProduction[nonterminal]; p < grammar.firstProduction[nonterminal + 1]; p++)
+      if (grammar.firstPlus[p] >> c & 1)
+        add(slotOf(p, 0), u, position, w);
+  }
+
+  // runs a descriptor until it calls a nonterminal, finishes its production or fails
+  void run(descriptor d)
+  {
+    uint32_t slot = d.slot;
+    uint32_t u = d.gss;
+    size_t position = d.position;
+    uint32_t w = d.sppf;
+    int production = slotProduction[slot];
+    int length = rhsLength(production);
+
+    if (length == 0)
+    {
+      pop(u, position, extend(slot, w, node(EPSILON_LABEL, position, position)));
+      return;
+    }
+
+    for (int dot = slotDot[slot]; dot < length;)
+    {
+      int symbol = grammar.rhs[grammar.rhsStart[production] + dot++];
+      if (symbol < GRAMMAR5_NONTERMINAL_BASE)
+      {
+        furthest = std::max(furthest, position);
+        if (column(position) != symbol)
+          return;
+        uint32_t terminal = node(symbol, position, position + 1);
+        position++;
+        w = extend(slotOf(production, dot), w, terminal);
+        continue;
+      }
+      // the list goes on without a call of its own, it returns where it was entered
+      if (loops[production] && dot == length)
+      {
+        call(symbol - GRAMMAR5_NONTERMINAL_BASE, u, position, w);
+        return;
+      }
+      u = create(slotOf(production, dot), u, position, w);
+      call(symbol - GRAMMAR5_NONTERMINAL_BASE, u, position);
+      return;
+    }
+    pop(u, position, w);
+  }
+
+  // nodes reachable from the root, the ones that belong to some derivation of the input
+  std::vector<uint32_t> reachable()
+  {
+    std::vector<uint32_t> order;
+    if (root == NO_NODE)
+      return order;
+    std::vector<uint8_t> visited(nodes.size(), 0);
+    std::vector<uint32_t> stack{root};
+    visited[root] = 1;
+    while (!stack.empty())
+    {
+      uint32_t n = stack.back();
+      stack.pop_back();
+      order.push_back(n);
+      for (uint32_t p = nodes[n].firstPacked; p != NO_NODE; p = packed[p].next)
+        for (uint32_t child : {packed[p].leftChild, packed[p].rightChild})
+          if (child != NO_NODE && !visited[child])
+          {
+            visited[child] = 1;
+            stack.push_back(child);
+          }
+    }
+    return order;
+  }
+
+public:
+  /*
+    @tokens: stream to be parsed, up to 2^24 - 1 tokens
+    @grammar: generated tables, the paradigm grammar (grammar5.md) by default
+    @start: nonterminal the input has to derive
+  */
+  GLLParser(tokenSpan tokens, const gllGrammar &grammar = paradigmGrammar, int start = 0)
+      : tokens(tokens), grammar(grammar), start(start)
+  {
+    if (tokens.count > MAX_TOKENS)
+      throw std::length_error("too many tokens for the GLL parser");
+    for (int p = 0; p < grammar.productions; p++)
+      for (int dot = 0; dot <= rhsLength(p); dot++)
+      {
+        slotProduction.push_back(p);
+        slotDot.push_back(dot);
+      }
+    rootSlot = (uint32_t)slotProduction.size();
+    findLists();
+  }
+
+  /*
+    Parses the whole stream, once
+
+    Return: true if it derives from the start symbol, the forest then holds
+    every derivation
+  */
+  bool parse()
+  {
+    size_t count = tokens.count;
+    pending.assign(count + 1, {});
+    gss.push_back({rootSlot, 0, NO_NODE, NO_NODE});
+    call(start, 0, 0);
+
+    for (size_t position = 0; position <= count; position++)
+    {
+      // later positions only get descriptors from here on, so duplicates are per position
+      seen.clear();
+      std::vector<descriptor> &bucket = pending[position];
+      while (!bucket.empty())
+      {
+        descriptor d = bucket.back();
+        bucket.pop_back();
+        if (!seen.insert({d.slot, d.gss, d.sppf}).second)
+          continue;
+        stats.descriptors++;
+        run(d);
+      }
+      std::vector<descriptor>().swap(bucket);
+    }
+
+    auto found = nodeIndex.find((uint64_t)(GRAMMAR5_NONTERMINAL_BASE + start) << 48 | (uint64_t)count);
+    root = found == nodeIndex.end() ? NO_NODE : found->second;
+    stats.gssNodes = gss.size();
+    stats.gssEdges = edges.size();
+    stats.sppfNodes = nodes.size();
+    stats.packedNodes = packed.size();
+    return root != NO_NODE;
+  }
+
+  // last position a terminal or a nonterminal was tried at, the error of a rejected input
+  size_t getErrorPosition()
+  {
+    return furthest;
+  }
+
+  /*
+    Counts the derivation trees of the input, shared subtrees multiply
+
+    Return: number of trees, 0 if the input was rejected, INFINITY if the
+    forest has a cycle (a nonterminal that derives itself)
+  */
+  double countDerivations()
+  {
+    if (root == NO_NODE)
+      return 0;
+    enum
+    {
+      NEW,
+      ACTIVE,
+      DONE
+    };
+    std::vector<uint8_t> state(nodes.size(), NEW);
+    std::vector<double> count(nodes.size(), 0);
+    std::vector<uint32_t> stack{root};
+    // post-order on an explicit stack, the forest is as deep as the input is long
+    while (!stack.empty())
+    {
+      uint32_t n = stack.back();
+      if (state[n] == DONE)
+      {
+        stack.pop_back();
+        continue;
+      }
+      if (state[n] == NEW)
+      {
+        state[n] = ACTIVE;
+        for (uint32_t p = nodes[n].firstPacked; p != NO_NODE; p = packed[p].next)
+          for (uint32_t child : {packed[p].leftChild, packed[p].rightChild})
+            if (child != NO_NODE && state[child] == NEW)
+              stack.push_back(child);
+        continue;
+      }
+
+      double total = nodes[n].firstPacked == NO_NODE ? 1 : 0;
+      for (uint32_t p = nodes[n].firstPacked; p != NO_NODE; p = packed[p].next)
+      {
+        double trees = 1;
+        for (uint32_t child : {packed[p].leftChild, packed[p].rightChild})
+          if (child != NO_NODE)
+            trees *= state[child] == DONE ? count[child] : INFINITY;
+        total += trees;
+      }
+      count[n] = total;
+      state[n] = DONE;
+      stack.pop_back();
+    }
+    return count[root];
+  }
+
+  /*
+    Lists the ways a nonterminal takes part in the derivations of the input
+
+    @nonterminal: index of the nonterminal (GRAMMAR5_PARADIGM, ...)
+
+    the nonterminals of a list parsed as a loop are folded into the one it is
+    entered through, with the production that ended the list (STATEMENTS gets
+    the spans of whole lists, ended by STATEMENTS' -> ε, STATEMENTS' none)
+
+    Return: one entry per production and span that some derivation uses,
+    ordered by span
+  */
+  std::vector<gllDerivation> derivationsOf(int nonterminal)
+  {
+    std::vector<gllDerivation> found;
+    for (uint32_t n : reachable())
+    {
+      if (nodes[n].label != (uint32_t)(GRAMMAR5_NONTERMINAL_BASE + nonterminal))
+        continue;
+      for (uint32_t p = nodes[n].firstPacked; p != NO_NODE; p = packed[p].next)
+        found.push_back({slotProduction[packed[p].slot], nodes[n].left, nodes[n].right});
+    }
+    std::sort(found.begin(), found.end(), [](const gllDerivation &a, const gllDerivation &b)
+              { return a.left != b.left ? a.left < b.left : a.right != b.right ? a.right < b.right : a.production < b.production; });
+    found.erase(std::unique(found.begin(), found.end(), [](const gllDerivation &a, const gllDerivation &b)
+                            { return a.production == b.production && a.left == b.left && a.right == b.right; }),
+                found.end());
+    return found;
+  }
+
+  // sizes of the structures the last parse built
+  const gllStats &getStats()
+  {
+    return stats;
+  }
+};
+
+#ifndef GLLPARSER_NO_MAIN
+// Example usage
+// argv[1]: optional token file written by the scanner (tokfile.h), replaces the example tokens
+// prints every paradigm the input derives as, with the tokens it covers
+int main(int argc, char **argv)
+{
+  // statements, then either a python function and class (MIXED) or more statements and the class (OOP)
+  std::vector<uint8_t> example = {9, 0, 8, 0, 8, 2, 4, 5, 8, 2, 4, 5, 9, 1, 0, 8, 0};
+  tokenSpan tokens = tokenSpanOf(example.data(), example.size());
+
+  // mapped until the process exits, the parser reads the file in place
+  tokfile file;
+  if (argc > 1)
+  {
+    if (!tokfileMap(argv[1], &file))
+    {
+      std::cout << argv[1] << " is not a token file\n";
+      return 1;
+    }
+    tokens = file.tokens;
+  }
+
+  try
+  {
+    GLLParser parser(tokens);
+    if (!parser.parse())
+    {
+      std::cout << "\nerror at position " << parser.getErrorPosition() << "\n";
+      return 1;
+    }
+
+    for (const gllDerivation &paradigm : parser.derivationsOf(GRAMMAR5_PARADIGM))
+    {
+      int alternative = grammar5Rhs[grammar5RhsStart[paradigm.production]] - GRAMMAR5_NONTERMINAL_BASE;
+      std::cout << grammar5NonterminalNames[alternative] << " [" << paradigm.left << ", " << paradigm.right << ")\n";
+    }
+    const gllStats &stats = parser.getStats();
+    std::cout << "derivations: " << parser.countDerivations() << "\n"
+              << "descriptors: " << stats.descriptors << ", gss: " << stats.gssNodes << " nodes / " << stats.gssEdges
+              << " edges, sppf: " << stats.sppfNodes << " nodes / " << stats.packedNodes << " packed\n";
+  }
+  catch (const std::exception &e)
+  {
+    // more tokens than the node keys hold (std::length_error)
+    std::cout << "\n" << e.what() << "\n";
+    return 1;
+  }
+}
+#endif
@@ -0,0 +1,980 @@
+// generated by python/rdgen.py --memo from grammar5.md, do not edit
+#ifndef GRAMMAR5_MEMO_PARSER_H
+#define GRAMMAR5_MEMO_PARSER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+#include "tokenstream.h"
+
+class Grammar5MemoParser
+{
+private:
+  // terminal columns, COLUMN_END past the last token
+  enum column
+  {
+    COLUMN_ID,
+    COLUMN_CLASS,
+    COLUMN_DEF,
+    COLUMN_MAIN,
+    COLUMN_OPEN_PAREN,
+    COLUMN_CLOSE_PAREN,
+    COLUMN_OPEN_BRACE,
+    COLUMN_CLOSE_BRACE,
+    COLUMN_INDENT,
+    COLUMN_NOINDENT,
+    COLUMN_END,
+    COLUMN_NONE = 255
+  };
+
+  // nonterminals, rows of the memo
+  enum nonterminal
+  {
+    S,
+    S_PRIME,
+    PARADIGM,
+    OOP,
+    CLASS,
+    CLASSCOMPLEMENT,
+    CLASSCOMPLEMENT_PRIME,
+    MAIN,
+    PYCLASS,
+    PYCLASS_PRIME,
+    PYCLASS_DOUBLE_PRIME,
+    PP,
+    PP_PRIME,
+    PP_DOUBLE_PRIME,
+    FUNC,
+    FUNC_PRIME,
+    PYFUNC,
+    PYFUNC_PRIME,
+    MIXED,
+    MIXEDN,
+    MIXEDCOMPLEMENT,
+    PYMIXED,
+    PYMIXEDCOMPLEMENT,
+    INDENTEDBLOCK,
+    INDENTEDBLOCK_PRIME,
+    INDENTEDBLOCK_DOUBLE_PRIME,
+    PYSTATEMENTS,
+    PYSTATEMENTS_PRIME,
+    PYSTATEMENT,
+    PYSTATEMENT_PRIME,
+    PYSTATEMENT_DOUBLE_PRIME,
+    PYSTATEMENT_TRIPLE_PRIME,
+    PYSTATEMENT_QUADRUPLE_PRIME,
+    PYSTATEMENT_QUINTUPLE_PRIME,
+    STATEMENTS,
+    STATEMENTS_PRIME,
+    STATEMENT,
+    STATEMENT_PRIME,
+    STATEMENT_DOUBLE_PRIME,
+    PREFIX,
+    IDS,
+    NONTERMINALS
+  };
+
+  // token id -> column
+  static constexpr uint8_t columnOf[256] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
+
+  // non-owning, the scanner's stream or a mapped token file outlives the parser
+  tokenSpan tokens;
+  size_t position = 0;
+  // position of the last mismatch
+  size_t errorPos = 0;
+
+  /*
+    one entry per (nonterminal, position): MEMO_UNKNOWN, MEMO_FAILED plus
+    the position of the error, or the position where it ended plus one
+  */
+  static constexpr uint32_t MEMO_UNKNOWN = 0;
+  static constexpr uint32_t MEMO_FAILED = 0x80000000u;
+  std::vector<uint32_t> memo;
+
+  int column()
+  {
+    return position < tokens.count ? (int)columnOf[tokens.ids[position]] : (int)COLUMN_END;
+  }
+
+  bool fail()
+  {
+    errorPos = position;
+    return false;
+  }
+
+  bool match(int expected)
+  {
+    if (column() != expected)
+      return fail();
+    position++;
+    return true;
+  }
+
+  // goes back to a checkpoint, always true so it chains with &&
+  bool backtrack(size_t checkpoint)
+  {
+    position = checkpoint;
+    return true;
+  }
+
+  // replays the outcome of a nonterminal already parsed at the current position
+  bool recall(int nonterminal, bool &matched)
+  {
+    uint32_t entry = memo[nonterminal * (tokens.count + 1) + position];
+    if (entry == MEMO_UNKNOWN)
+      return false;
+    matched = !(entry & MEMO_FAILED);
+    if (matched)
+      position = entry - 1;
+    else
+      errorPos = entry & ~MEMO_FAILED;
+    return true;
+  }
+
+  bool store(int nonterminal, size_t start, bool matched)
+  {
+    memo[nonterminal * (tokens.count + 1) + start] =
+        matched ? (uint32_t)position + 1 : MEMO_FAILED | (uint32_t)errorPos;
+    return matched;
+  }
+
+  // S -> PARADIGM S' | STATEMENTS PARADIGM S' | PYSTATEMENTS PARADIGM S'
+  bool parseS()
+  {
+    bool matched;
+    if (recall(S, matched))
+      return matched;
+    size_t initial = position;
+
+    switch (column())
+    {
+    case COLUMN_ID:
+      return store(S, initial, (parsePARADIGM() && parseSPrime()) ||
+                               (backtrack(initial) && parsePYSTATEMENTS() && parsePARADIGM() && parseSPrime()));
+    case COLUMN_CLASS:
+    case COLUMN_DEF:
+      return store(S, initial, parsePARADIGM() && parseSPrime());
+    case COLUMN_INDENT:
+      return store(S, initial, (parsePARADIGM() && parseSPrime()) ||
+                               (backtrack(initial) && parseSTATEMENTS() && parsePARADIGM() && parseSPrime()));
+    case COLUMN_NOINDENT:
+      return store(S, initial, (parsePARADIGM() && parseSPrime()) ||
+                               (backtrack(initial) && parseSTATEMENTS() && parsePARADIGM() && parseSPrime()) ||
+                               (backtrack(initial) && parsePYSTATEMENTS() && parsePARADIGM() && parseSPrime()));
+    }
+    return store(S, initial, fail());
+  }
+
+  // S' -> STATEMENTS | PYSTATEMENTS | ε
+  bool parseSPrime()
+  {
+    bool matched;
+    if (recall(S_PRIME, matched))
+      return matched;
+    size_t initial = position;
+
+    switch (column())
+    {
+    case COLUMN_ID:
+      return store(S_PRIME, initial, parsePYSTATEMENTS() ||
+                                     backtrack(initial));
+    case COLUMN_INDENT:
+      return store(S_PRIME, initial, parseSTATEMENTS() ||
+                                     backtrack(initial));
+    case COLUMN_NOINDENT:
+      return store(S_PRIME, initial, parseSTATEMENTS() ||
+                                     (backtrack(initial) && parsePYSTATEMENTS()) ||
+                                     backtrack(initial));
+    }
+    return store(S_PRIME, initial, true);
+  }
+
+  // PARADIGM -> OOP | PP | MIXED
+  bool parsePARADIGM()
+  {
+    bool matched;
+    if (recall(PARADIGM, matched))
+      return matched;
+    size_t initial = position;
+
+    switch (column())
+    {
+    case COLUMN_ID:
+    case COLUMN_INDENT:
+    case COLUMN_NOINDENT:
+      return store(PARADIGM, initial, parseOOP() ||
+                                      (backtrack(initial) && parsePP()) ||
+                                      (backtrack(initial) && parseMIXED()));
+    case COLUMN_CLASS:
+      return store(PARADIGM, initial, parseOOP() ||
+                                      (backtrack(initial) && parseMIXED()));
+    case COLUMN_DEF:
+      return store(PARADIGM, initial, parsePP() ||
+                                      (backtrack(initial) && parseMIXED()));
+    }
+    return store(PARADIGM, initial, fail());
+  }
+
+  // OOP -> PYCLASS | CLASS
+  bool parseOOP()
+  {
+    bool matched;
+    if (recall(OOP, matched))
+      return matched;
+    size_t initial = position;
+
+    switch (column())
+    {
+    case COLUMN_ID:
+    case COLUMN_INDENT:
+      return store(OOP, initial, parseCLASS());
+    case COLUMN_CLASS:
+    case COLUMN_NOINDENT:
+      return store(OOP, initial, parsePYCLASS() ||
+                                 (backtrack(initial) && parseCLASS()));
+    }
+    return store(OOP, initial, fail());
+  }
+
+  // CLASS -> PREFIX CLASSCOMPLEMENT | CLASSCOMPLEMENT
+  bool parseCLASS()
+  {
+    bool matched;
+    if (recall(CLASS, matched))
+      return matched;
+    size_t initial = position;
+
+    switch (column())
+    {
+    case COLUMN_ID:
+    case COLUMN_CLASS:
+      return store(CLASS, initial, parseCLASSCOMPLEMENT());
+    case COLUMN_INDENT:
+    case COLUMN_NOINDENT:
+      return store(CLASS, initial, parsePREFIX() && parseCLASSCOMPLEMENT());
+    }
+    return store(CLASS, initial, fail());
+  }
+
+  // CLASSCOMPLEMENT -> IDS class IDS { STATEMENTS } CLASSCOMPLEMENT'
+  bool parseCLASSCOMPLEMENT()
+  {
+    bool matched;
+    if (recall(CLASSCOMPLEMENT, matched))
+      return matched;
+    size_t initial = position;
+
+    switch (column())
+    {
+    case COLUMN_ID:
+    case COLUMN_CLASS:
+      return store(CLASSCOMPLEMENT, initial, parseIDS() && match(COLUMN_CLASS) && parseIDS() && match(COLUMN_OPEN_BRACE) && parseSTATEMENTS() && match(COLUMN_CLOSE_BRACE) && parseCLASSCOMPLEMENTPrime());
+    }
+    return store(CLASSCOMPLEMENT, initial, fail());
+  }
+
+  // CLASSCOMPLEMENT' -> MAIN | STATEMENTS CLASS | ε
+  bool parseCLASSCOMPLEMENTPrime()
+  {
+    bool matched;
+    if (recall(CLASSCOMPLEMENT_PRIME, matched))
+      return matched;
+    size_t initial = position;
+
+    switch (column())
+    {
+    case COLUMN_ID:
+    case COLUMN_MAIN:
+      return store(CLASSCOMPLEMENT_PRIME, initial, parseMAIN() ||
+                                                   backtrack(initial));
+    case COLUMN_INDENT:
+    case COLUMN_NOINDENT:
+      return store(CLASSCOMPLEMENT_PRIME, initial, parseMAIN() ||
+                                                   (backtrack(initial) && parseSTATEMENTS() && parseCLASS()) ||
+                                                   backtrack(initial));
+    }
+    return store(CLASSCOMPLEMENT_PRIME, initial, true);
+  }
+
+  // MAIN -> PREFIX IDS main ( IDS ) { STATEMENTS } | IDS main ( IDS ) { STATEMENTS }
+  bool parseMAIN()
+  {
+    bool matched;
+    if (recall(MAIN, matched))
+      return matched;
+    size_t initial = position;
+
+    switch (column())
+    {
+    case COLUMN_ID:
+    case COLUMN_MAIN:
+      return store(MAIN, initial, parseIDS() && match(COLUMN_MAIN) && match(COLUMN_OPEN_PAREN) && parseIDS() && match(COLUMN_CLOSE_PAREN) && match(COLUMN_OPEN_BRACE) && parseSTATEMENTS() && match(COLUMN_CLOSE_BRACE));
+    case COLUMN_INDENT:
+    case COLUMN_NOINDENT:
+      return store(MAIN, initial, parsePREFIX() && parseIDS() && match(COLUMN_MAIN) && match(COLUMN_OPEN_PAREN) && parseIDS() && match(COLUMN_CLOSE_PAREN) && match(COLUMN_OPEN_BRACE) && parseSTATEMENTS() && match(COLUMN_CLOSE_BRACE));
+    }
+    return store(MAIN, initial, fail());
+  }
+
+  // PYCLASS -> noindent class IDS PYCLASS' PYCLASS'' | class IDS PYCLASS' PYCLASS''
+  bool parsePYCLASS()
+  {
+    bool matched;
+    if (recall(PYCLASS, matched))
+      return matched;
+    size_t initial = position;
+
+    switch (column())
+    {
+    case COLUMN_CLASS:
+      return store(PYCLASS, initial, match(COLUMN_CLASS) && parseIDS() && parsePYCLASSPrime() && parsePYCLASSDoublePrime());
+    case COLUMN_NOINDENT:
+      return store(PYCLASS, initial, match(COLUMN_NOINDENT) && match(COLUMN_CLASS) && parseIDS() && parsePYCLASSPrime() && parsePYCLASSDoublePrime());
+    }
+    return store(PYCLASS, initial, fail());
+  }
+
+  // PYCLASS' -> INDENTEDBLOCK | ( IDS ) INDENTEDBLOCK
+  bool parsePYCLASSPrime()
+  {
+    bool matched;
+    if (recall(PYCLASS_PRIME, matched))
+      return matched;
+    size_t initial = position;
+
+    switch (column())
+    {
+    case COLUMN_OPEN_PAREN:
+      return store(PYCLASS_PRIME, initial, match(COLUMN_OPEN_PAREN) && parseIDS() && match(COLUMN_CLOSE_PAREN) && parseINDENTEDBLOCK());
+    case COLUMN_INDENT:
+      return store(PYCLASS_PRIME, initial, parseINDENTEDBLOCK());
+    }
+    return store(PYCLASS_PRIME, initial, fail());
+  }
+
+  // PYCLASS'' -> PYSTATEMENTS PYCLASS | ε
+  bool parsePYCLASSDoublePrime()
+  {
+    bool matched;
+    if (recall(PYCLASS_DOUBLE_PRIME, matched))
+      return matched;
+    size_t initial = position;
+
+    switch (column())
+    {
+    case COLUMN_ID:
+    case COLUMN_NOINDENT:
+      return store(PYCLASS_DOUBLE_PRIME, initial, (parsePYSTATEMENTS() && parsePYCLASS()) ||
+                                                  backtrack(initial));
+    }
+    return store(PYCLASS_DOUBLE_PRIME, initial, true);
+  }
+
+  // PP -> PYFUNC | FUNC
+  bool parsePP()
+  {
+    bool matched;
+    if (recall(PP, matched))
+      return matched;
+    size_t initial = position;
+
+    switch (column())
+    {
+    case COLUMN_ID:
+    case COLUMN_INDENT:
+      return store(PP, initial, parseFUNC());
+    case COLUMN_DEF:
+      return store(PP, initial, parsePYFUNC());
+    case COLUMN_NOINDENT:
+      return store(PP, initial, parsePYFUNC() ||
+                                (backtrack(initial) && parseFUNC()));
+    }
+    return store(PP, initial, fail());
+  }
+
+  // PP' -> MAIN | ε
+  bool parsePPPrime()
+  {
+    bool matched;
+    if (recall(PP_PRIME, matched))
+      return matched;
+    size_t initial = position;
+
+    switch (column())
+    {
+    case COLUMN_ID:
+    case COLUMN_MAIN:
+    case COLUMN_INDENT:
+    case COLUMN_NOINDENT:
+      return store(PP_PRIME, initial, parseMAIN() ||
+                                      backtrack(initial));
+    }
+    return store(PP_PRIME, initial, true);
+  }
+
+  // PP'' -> FUNC | ε
+  bool parsePPDoublePrime()
+  {
+    bool matched;
+    if (recall(PP_DOUBLE_PRIME, matched))
+      return matched;
+    size_t initial = position;
+
+    switch (column())
+    {
+    case COLUMN_ID:
+    case COLUMN_INDENT:
+    case COLUMN_NOINDENT:
+      return store(PP_DOUBLE_PRIME, initial, parseFUNC() ||
+                                             backtrack(initial));
+    }
+    return store(PP_DOUBLE_PRIME, initial, true);
+  }
+
+  // FUNC -> id IDS ( IDS ) { STATEMENTS } FUNC' | PREFIX id IDS ( IDS ) { STATEMENTS } FUNC'
+  bool parseFUNC()
+  {
+    bool matched;
+    if (recall(FUNC, matched))
+      return matched;
+    size_t initial = position;
+
+    switch (column())
+    {
+    case COLUMN_ID:
+      return store(FUNC, initial, match(COLUMN_ID) && parseIDS() && match(COLUMN_OPEN_PAREN) && parseIDS() && match(COLUMN_CLOSE_PAREN) && match(COLUMN_OPEN_BRACE) && parseSTATEMENTS() && match(COLUMN_CLOSE_BRACE) && parseFUNCPrime());
+    case COLUMN_INDENT:
+    case COLUMN_NOINDENT:
+      return store(FUNC, initial, parsePREFIX() && match(COLUMN_ID) && parseIDS() && match(COLUMN_OPEN_PAREN) && parseIDS() && match(COLUMN_CLOSE_PAREN) && match(COLUMN_OPEN_BRACE) && parseSTATEMENTS() && match(COLUMN_CLOSE_BRACE) && parseFUNCPrime());
+    }
+    return store(FUNC, initial, fail());
+  }
+
+  // FUNC' -> STATEMENTS FUNC | ε
+  bool parseFUNCPrime()
+  {
+    bool matched;
+    if (recall(FUNC_PRIME, matched))
+      return matched;
+    size_t initial = position;
+
+    switch (column())
+    {
+    case COLUMN_INDENT:
+    case COLUMN_NOINDENT:
+      return store(FUNC_PRIME, initial, (parseSTATEMENTS() && parseFUNC()) ||
+                                        backtrack(initial));
+    }
+    return store(FUNC_PRIME, initial, true);
+  }
+
+  // PYFUNC -> def IDS ( IDS ) INDENTEDBLOCK PYFUNC' | noindent def main ( IDS ) INDENTEDBLOCK PYFUNC'
+  bool parsePYFUNC()
+  {
+    bool matched;
+    if (recall(PYFUNC, matched))
+      return matched;
+    size_t initial = position;
+
+    switch (column())
+    {
+    case COLUMN_DEF:
+      return store(PYFUNC, initial, match(COLUMN_DEF) && parseIDS() && match(COLUMN_OPEN_PAREN) && parseIDS() && match(COLUMN_CLOSE_PAREN) && parseINDENTEDBLOCK() && parsePYFUNCPrime());
+    case COLUMN_NOINDENT:
+      return store(PYFUNC, initial, match(COLUMN_NOINDENT) && match(COLUMN_DEF) && match(COLUMN_MAIN) && match(COLUMN_OPEN_PAREN) && parseIDS() && match(COLUMN_CLOSE_PAREN) && parseINDENTEDBLOCK() && parsePYFUNCPrime());
+    }
+    return store(PYFUNC, initial, fail());
+  }
+
+  // PYFUNC' -> PYSTATEMENTS PYFUNC | ε
+  bool parsePYFUNCPrime()
+  {
+    bool matched;
+    if (recall(PYFUNC_PRIME, matched))
+      return matched;
+    size_t initial = position;
+
+    switch (column())
+    {
+    case COLUMN_ID:
+    case COLUMN_NOINDENT:
+      return store(PYFUNC_PRIME, initial, (parsePYSTATEMENTS() && parsePYFUNC()) ||
+                                          backtrack(initial));
+    }
+    return store(PYFUNC_PRIME, initial, true);
+  }
+
+  // MIXED -> PYMIXED | MIXEDN
+  bool parseMIXED()
+  {
+    bool matched;
+    if (recall(MIXED, matched))
+      return matched;
+    size_t initial = position;
+
+    switch (column())
+    {
+    case COLUMN_ID:
+    case COLUMN_INDENT:
+      return store(MIXED, initial, parseMIXEDN());
+    case COLUMN_CLASS:
+    case COLUMN_NOINDENT:
+      return store(MIXED, initial, parsePYMIXED() ||
+                                   (backtrack(initial) && parseMIXEDN()));
+    case COLUMN_DEF:
+      return store(MIXED, initial, parsePYMIXED());
+    }
+    return store(MIXED, initial, fail());
+  }
+
+  // MIXEDN -> CLASS FUNC MIXEDCOMPLEMENT | FUNC CLASS MIXEDCOMPLEMENT
+  bool parseMIXEDN()
+  {
+    bool matched;
+    if (recall(MIXEDN, matched))
+      return matched;
+    size_t initial = position;
+
+    switch (column())
+    {
+    case COLUMN_ID:
+    case COLUMN_INDENT:
+    case COLUMN_NOINDENT:
+      return store(MIXEDN, initial, (parseCLASS() && parseFUNC() && parseMIXEDCOMPLEMENT()) ||
+                                    (backtrack(initial) && parseFUNC() && parseCLASS() && parseMIXEDCOMPLEMENT()));
+    case COLUMN_CLASS:
+      return store(MIXEDN, initial, parseCLASS() && parseFUNC() && parseMIXEDCOMPLEMENT());
+    }
+    return store(MIXEDN, initial, fail());
+  }
+
+  // MIXEDCOMPLEMENT -> CLASS | FUNC | MIXEDN | MAIN | ε
+  bool parseMIXEDCOMPLEMENT()
+  {
+    bool matched;
+    if (recall(MIXEDCOMPLEMENT, matched))
+      return matched;
+    size_t initial = position;
+
+    switch (column())
+    {
+    case COLUMN_ID:
+    case COLUMN_INDENT:
+    case COLUMN_NOINDENT:
+      return store(MIXEDCOMPLEMENT, initial, parseCLASS() ||
+                                             (backtrack(initial) && parseFUNC()) ||
+                                             (backtrack(initial) && parseMIXEDN()) ||
+                                             (backtrack(initial) && parseMAIN()) ||
+                                             backtrack(initial));
+    case COLUMN_CLASS:
+      return store(MIXEDCOMPLEMENT, initial, parseCLASS() ||
+                                             (backtrack(initial) && parseMIXEDN()) ||
+                                             backtrack(initial));
+    case COLUMN_MAIN:
+      return store(MIXEDCOMPLEMENT, initial, parseMAIN() ||
+                                             backtrack(initial));
+    }
+    return store(MIXEDCOMPLEMENT, initial, true);
+  }
+
+  // PYMIXED -> PYCLASS PYFUNC PYMIXEDCOMPLEMENT | PYFUNC PYCLASS PYMIXEDCOMPLEMENT
+  bool parsePYMIXED()
+  {
+    bool matched;
+    if (recall(PYMIXED, matched))
+      return matched;
+    size_t initial = position;
+
+    switch (column())
+    {
+    case COLUMN_CLASS:
+      return store(PYMIXED, initial, parsePYCLASS() && parsePYFUNC() && parsePYMIXEDCOMPLEMENT());
+    case COLUMN_DEF:
+      return store(PYMIXED, initial, parsePYFUNC() && parsePYCLASS() && parsePYMIXEDCOMPLEMENT());
+    case COLUMN_NOINDENT:
+      return store(PYMIXED, initial, (parsePYCLASS() && parsePYFUNC() && parsePYMIXEDCOMPLEMENT()) ||
+                                     (backtrack(initial) && parsePYFUNC() && parsePYCLASS() && parsePYMIXEDCOMPLEMENT()));
+    }
+    return store(PYMIXED, initial, fail());
+  }
+
+  // PYMIXEDCOMPLEMENT -> PYCLASS | PYFUNC | PYMIXED | ε
+  bool parsePYMIXEDCOMPLEMENT()
+  {
+    bool matched;
+    if (recall(PYMIXEDCOMPLEMENT, matched))
+      return matched;
+    size_t initial = position;
+
+    switch (column())
+    {
+    case COLUMN_CLASS:
+      return store(PYMIXEDCOMPLEMENT, initial, parsePYCLASS() ||
+                                               (backtrack(initial) && parsePYMIXED()) ||
+                                               backtrack(initial));
+    case COLUMN_DEF:
+      return store(PYMIXEDCOMPLEMENT, initial, parsePYFUNC() ||
+                                               (backtrack(initial) && parsePYMIXED()) ||
+                                               backtrack(initial));
+    case COLUMN_NOINDENT:
+      return store(PYMIXEDCOMPLEMENT, initial, parsePYCLASS() ||
+                                               (backtrack(initial) && parsePYFUNC()) ||
+                                               (backtrack(initial) && parsePYMIXED()) ||
+                                               backtrack(initial));
+    }
+    return store(PYMIXEDCOMPLEMENT, initial, true);
+  }
+
+  // INDENTEDBLOCK -> indent INDENTEDBLOCK' INDENTEDBLOCK''
+  bool parseINDENTEDBLOCK()
+  {
+    bool matched;
+    if (recall(INDENTEDBLOCK, matched))
+      return matched;
+    size_t initial = position;
+
+    switch (column())
+    {
+    case COLUMN_INDENT:
+      return store(INDENTEDBLOCK, initial, match(COLUMN_INDENT) && parseINDENTEDBLOCKPrime() && parseINDENTEDBLOCKDoublePrime());
+    }
+    return store(INDENTEDBLOCK, initial, fail());
+  }
+
+  // INDENTEDBLOCK' -> PYSTATEMENT | def IDS ( IDS )
+  bool parseINDENTEDBLOCKPrime()
+  {
+    bool matched;
+    if (recall(INDENTEDBLOCK_PRIME, matched))
+      return matched;
+    size_t initial = position;
+
+    switch (column())
+    {
+    case COLUMN_ID:
+      return store(INDENTEDBLOCK_PRIME, initial, parsePYSTATEMENT());
+    case COLUMN_DEF:
+      return store(INDENTEDBLOCK_PRIME, initial, match(COLUMN_DEF) && parseIDS() && match(COLUMN_OPEN_PAREN) && parseIDS() && match(COLUMN_CLOSE_PAREN));
+    }
+    return store(INDENTEDBLOCK_PRIME, initial, fail());
+  }
+
+  // INDENTEDBLOCK'' -> INDENTEDBLOCK | ε
+  bool parseINDENTEDBLOCKDoublePrime()
+  {
+    bool matched;
+    if (recall(INDENTEDBLOCK_DOUBLE_PRIME, matched))
+      return matched;
+    size_t initial = position;
+
+    switch (column())
+    {
+    case COLUMN_INDENT:
+      return store(INDENTEDBLOCK_DOUBLE_PRIME, initial, parseINDENTEDBLOCK() ||
+                                                        backtrack(initial));
+    }
+    return store(INDENTEDBLOCK_DOUBLE_PRIME, initial, true);
+  }
+
+  // PYSTATEMENTS -> PYSTATEMENT PYSTATEMENTS' | noindent PYSTATEMENT PYSTATEMENTS'
+  bool parsePYSTATEMENTS()
+  {
+    bool matched;
+    if (recall(PYSTATEMENTS, matched))
+      return matched;
+    size_t initial = position;
+
+    switch (column())
+    {
+    case COLUMN_ID:
+      return store(PYSTATEMENTS, initial, parsePYSTATEMENT() && parsePYSTATEMENTSPrime());
+    case COLUMN_NOINDENT:
+      return store(PYSTATEMENTS, initial, match(COLUMN_NOINDENT) && parsePYSTATEMENT() && parsePYSTATEMENTSPrime());
+    }
+    return store(PYSTATEMENTS, initial, fail());
+  }
+
+  // PYSTATEMENTS' -> PYSTATEMENTS | INDENTEDBLOCK | ε
+  bool parsePYSTATEMENTSPrime()
+  {
+    bool matched;
+    if (recall(PYSTATEMENTS_PRIME, matched))
+      return matched;
+    size_t initial = position;
+
+    switch (column())
+    {
+    case COLUMN_ID:
+    case COLUMN_NOINDENT:
+      return store(PYSTATEMENTS_PRIME, initial, parsePYSTATEMENTS() ||
+                                                backtrack(initial));
+    case COLUMN_INDENT:
+      return store(PYSTATEMENTS_PRIME, initial, parseINDENTEDBLOCK() ||
+                                                backtrack(initial));
+    }
+    return store(PYSTATEMENTS_PRIME, initial, true);
+  }
+
+  // PYSTATEMENT -> id IDS PYSTATEMENT'
+  bool parsePYSTATEMENT()
+  {
+    bool matched;
+    if (recall(PYSTATEMENT, matched))
+      return matched;
+    size_t initial = position;
+
+    switch (column())
+    {
+    case COLUMN_ID:
+      return store(PYSTATEMENT, initial, match(COLUMN_ID) && parseIDS() && parsePYSTATEMENTPrime());
+    }
+    return store(PYSTATEMENT, initial, fail());
+  }
+
+  // PYSTATEMENT' -> ( PYSTATEMENT'' | { PYSTATEMENT''' | ε
+  bool parsePYSTATEMENTPrime()
+  {
+    bool matched;
+    if (recall(PYSTATEMENT_PRIME, matched))
+      return matched;
+    size_t initial = position;
+
+    switch (column())
+    {
+    case COLUMN_OPEN_PAREN:
+      return store(PYSTATEMENT_PRIME, initial, (match(COLUMN_OPEN_PAREN) && parsePYSTATEMENTDoublePrime()) ||
+                                               backtrack(initial));
+    case COLUMN_OPEN_BRACE:
+      return store(PYSTATEMENT_PRIME, initial, (match(COLUMN_OPEN_BRACE) && parsePYSTATEMENTTriplePrime()) ||
+                                               backtrack(initial));
+    }
+    return store(PYSTATEMENT_PRIME, initial, true);
+  }
+
+  // PYSTATEMENT'' -> IDS ) | INDENTEDBLOCK PYSTATEMENT''''
+  bool parsePYSTATEMENTDoublePrime()
+  {
+    bool matched;
+    if (recall(PYSTATEMENT_DOUBLE_PRIME, matched))
+      return matched;
+    size_t initial = position;
+
+    switch (column())
+    {
+    case COLUMN_ID:
+    case COLUMN_CLOSE_PAREN:
+      return store(PYSTATEMENT_DOUBLE_PRIME, initial, parseIDS() && match(COLUMN_CLOSE_PAREN));
+    case COLUMN_INDENT:
+      return store(PYSTATEMENT_DOUBLE_PRIME, initial, parseINDENTEDBLOCK() && parsePYSTATEMENTQuadruplePrime());
+    }
+    return store(PYSTATEMENT_DOUBLE_PRIME, initial, fail());
+  }
+
+  // PYSTATEMENT''' -> IDS } | INDENTEDBLOCK PYSTATEMENT'''''
+  bool parsePYSTATEMENTTriplePrime()
+  {
+    bool matched;
+    if (recall(PYSTATEMENT_TRIPLE_PRIME, matched))
+      return matched;
+    size_t initial = position;
+
+    switch (column())
+    {
+    case COLUMN_ID:
+    case COLUMN_CLOSE_BRACE:
+      return store(PYSTATEMENT_TRIPLE_PRIME, initial, parseIDS() && match(COLUMN_CLOSE_BRACE));
+    case COLUMN_INDENT:
+      return store(PYSTATEMENT_TRIPLE_PRIME, initial, parseINDENTEDBLOCK() && parsePYSTATEMENTQuintuplePrime());
+    }
+    return store(PYSTATEMENT_TRIPLE_PRIME, initial, fail());
+  }
+
+  // PYSTATEMENT'''' -> ) | indent )
+  bool parsePYSTATEMENTQuadruplePrime()
+  {
+    bool matched;
+    if (recall(PYSTATEMENT_QUADRUPLE_PRIME, matched))
+      return matched;
+    size_t initial = position;
+
+    switch (column())
+    {
+    case COLUMN_CLOSE_PAREN:
+      return store(PYSTATEMENT_QUADRUPLE_PRIME, initial, match(COLUMN_CLOSE_PAREN));
+    case COLUMN_INDENT:
+      return store(PYSTATEMENT_QUADRUPLE_PRIME, initial, match(COLUMN_INDENT) && match(COLUMN_CLOSE_PAREN));
+    }
+    return store(PYSTATEMENT_QUADRUPLE_PRIME, initial, fail());
+  }
+
+  // PYSTATEMENT''''' -> } | indent }
+  bool parsePYSTATEMENTQuintuplePrime()
+  {
+    bool matched;
+    if (recall(PYSTATEMENT_QUINTUPLE_PRIME, matched))
+      return matched;
+    size_t initial = position;
+
+    switch (column())
+    {
+    case COLUMN_CLOSE_BRACE:
+      return store(PYSTATEMENT_QUINTUPLE_PRIME, initial, match(COLUMN_CLOSE_BRACE));
+    case COLUMN_INDENT:
+      return store(PYSTATEMENT_QUINTUPLE_PRIME, initial, match(COLUMN_INDENT) && match(COLUMN_CLOSE_BRACE));
+    }
+    return store(PYSTATEMENT_QUINTUPLE_PRIME, initial, fail());
+  }
+
+  // STATEMENTS -> STATEMENT STATEMENTS'
+  bool parseSTATEMENTS()
+  {
+    bool matched;
+    if (recall(STATEMENTS, matched))
+      return matched;
+    size_t initial = position;
+
+    switch (column())
+    {
+    case COLUMN_INDENT:
+    case COLUMN_NOINDENT:
+      return store(STATEMENTS, initial, parseSTATEMENT() && parseSTATEMENTSPrime());
+    }
+    return store(STATEMENTS, initial, fail());
+  }
+
+  // STATEMENTS' -> STATEMENTS | ε
+  bool parseSTATEMENTSPrime()
+  {
+    bool matched;
+    if (recall(STATEMENTS_PRIME, matched))
+      return matched;
+    size_t initial = position;
+
+    switch (column())
+    {
+    case COLUMN_INDENT:
+    case COLUMN_NOINDENT:
+      return store(STATEMENTS_PRIME, initial, parseSTATEMENTS() ||
+                                              backtrack(initial));
+    }
+    return store(STATEMENTS_PRIME, initial, true);
+  }
+
+  // STATEMENT -> PREFIX IDS STATEMENT'
+  bool parseSTATEMENT()
+  {
+    bool matched;
+    if (recall(STATEMENT, matched))
+      return matched;
+    size_t initial = position;
+
+    switch (column())
+    {
+    case COLUMN_INDENT:
+    case COLUMN_NOINDENT:
+      return store(STATEMENT, initial, parsePREFIX() && parseIDS() && parseSTATEMENTPrime());
+    }
+    return store(STATEMENT, initial, fail());
+  }
+
+  // STATEMENT' -> ( STATEMENTS ) STATEMENT'' | { STATEMENTS } | ε
+  bool parseSTATEMENTPrime()
+  {
+    bool matched;
+    if (recall(STATEMENT_PRIME, matched))
+      return matched;
+    size_t initial = position;
+
+    switch (column())
+    {
+    case COLUMN_OPEN_PAREN:
+      return store(STATEMENT_PRIME, initial, (match(COLUMN_OPEN_PAREN) && parseSTATEMENTS() && match(COLUMN_CLOSE_PAREN) && parseSTATEMENTDoublePrime()) ||
+                                             backtrack(initial));
+    case COLUMN_OPEN_BRACE:
+      return store(STATEMENT_PRIME, initial, (match(COLUMN_OPEN_BRACE) && parseSTATEMENTS() && match(COLUMN_CLOSE_BRACE)) ||
+                                             backtrack(initial));
+    }
+    return store(STATEMENT_PRIME, initial, true);
+  }
+
+  // STATEMENT'' -> { STATEMENTS } | ε
+  bool parseSTATEMENTDoublePrime()
+  {
+    bool matched;
+    if (recall(STATEMENT_DOUBLE_PRIME, matched))
+      return matched;
+    size_t initial = position;
+
+    switch (column())
+    {
+    case COLUMN_OPEN_BRACE:
+      return store(STATEMENT_DOUBLE_PRIME, initial, (match(COLUMN_OPEN_BRACE) && parseSTATEMENTS() && match(COLUMN_CLOSE_BRACE)) ||
+                                                    backtrack(initial));
+    }
+    return store(STATEMENT_DOUBLE_PRIME, initial, true);
+  }
+
+  // PREFIX -> indent | noindent
+  bool parsePREFIX()
+  {
+    bool matched;
+    if (recall(PREFIX, matched))
+      return matched;
+    size_t initial = position;
+
+    switch (column())
+    {
+    case COLUMN_INDENT:
+      return store(PREFIX, initial, match(COLUMN_INDENT));
+    case COLUMN_NOINDENT:
+      return store(PREFIX, initial, match(COLUMN_NOINDENT));
+    }
+    return store(PREFIX, initial, fail());
+  }
+
+  // IDS -> id IDS | ε
+  bool parseIDS()
+  {
+    bool matched;
+    if (recall(IDS, matched))
+      return matched;
+    size_t initial = position;
+
+    switch (column())
+    {
+    case COLUMN_ID:
+      return store(IDS, initial, (match(COLUMN_ID) && parseIDS()) ||
+                                 backtrack(initial));
+    }
+    return store(IDS, initial, true);
+  }
+
+public:
+  // @tokens: stream to be parsed, the parser keeps a view
+  Grammar5MemoParser(tokenSpan tokens)
+      : tokens(tokens)
+  {
+    memo.assign(NONTERMINALS * (tokens.count + 1), MEMO_UNKNOWN);
+  }
+
+  /*
+    Parses the whole stream from the start symbol, once
+
+    Return: true if it derives, the error is at getErrorPosition() if not
+  */
+  bool parse()
+  {
+    if (!parseS())
+      return false;
+    if (position < tokens.count)
+      return fail();
+    return true;
+  }
+
+  size_t getErrorPosition()
+  {
+    return errorPos;
+  }
+};
+
+#endif
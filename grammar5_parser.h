@@ -0,0 +1,743 @@
+// generated by python/rdgen.py from grammar5.md, do not edit
+#ifndef GRAMMAR5_PARSER_H
+#define GRAMMAR5_PARSER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "tokenstream.h"
+
+class Grammar5Parser
+{
+private:
+  // terminal columns, COLUMN_END past the last token
+  enum column
+  {
+    COLUMN_ID,
+    COLUMN_CLASS,
+    COLUMN_DEF,
+    COLUMN_MAIN,
+    COLUMN_OPEN_PAREN,
+    COLUMN_CLOSE_PAREN,
+    COLUMN_OPEN_BRACE,
+    COLUMN_CLOSE_BRACE,
+    COLUMN_INDENT,
+    COLUMN_NOINDENT,
+    COLUMN_END,
+    COLUMN_NONE = 255
+  };
+
+  // token id -> column
+  static constexpr uint8_t columnOf[256] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
+
+  // non-owning, the scanner's stream or a mapped token file outlives the parser
+  tokenSpan tokens;
+  size_t position = 0;
+  // position of the last mismatch
+  size_t errorPos = 0;
+
+  int column()
+  {
+    return position < tokens.count ? (int)columnOf[tokens.ids[position]] : (int)COLUMN_END;
+  }
+
+  bool fail()
+  {
+    errorPos = position;
+    return false;
+  }
+
+  bool match(int expected)
+  {
+    if (column() != expected)
+      return fail();
+    position++;
+    return true;
+  }
+
+  // goes back to a checkpoint, always true so it chains with &&
+  bool backtrack(size_t checkpoint)
+  {
+    position = checkpoint;
+    return true;
+  }
+
+  // S -> PARADIGM S' | STATEMENTS PARADIGM S' | PYSTATEMENTS PARADIGM S'
+  bool parseS()
+  {
+    size_t initial = position;
+
+    switch (column())
+    {
+    case COLUMN_ID:
+      return (parsePARADIGM() && parseSPrime()) ||
+             (backtrack(initial) && parsePYSTATEMENTS() && parsePARADIGM() && parseSPrime());
+    case COLUMN_CLASS:
+    case COLUMN_DEF:
+      return parsePARADIGM() && parseSPrime();
+    case COLUMN_INDENT:
+      return (parsePARADIGM() && parseSPrime()) ||
+             (backtrack(initial) && parseSTATEMENTS() && parsePARADIGM() && parseSPrime());
+    case COLUMN_NOINDENT:
+      return (parsePARADIGM() && parseSPrime()) ||
+             (backtrack(initial) && parseSTATEMENTS() && parsePARADIGM() && parseSPrime()) ||
+             (backtrack(initial) && parsePYSTATEMENTS() && parsePARADIGM() && parseSPrime());
+    }
+    return fail();
+  }
+
+  // S' -> STATEMENTS | PYSTATEMENTS | ε
+  bool parseSPrime()
+  {
+    size_t initial = position;
+
+    switch (column())
+    {
+    case COLUMN_ID:
+      return parsePYSTATEMENTS() ||
+             backtrack(initial);
+    case COLUMN_INDENT:
+      return parseSTATEMENTS() ||
+             backtrack(initial);
+    case COLUMN_NOINDENT:
+      return parseSTATEMENTS() ||
+             (backtrack(initial) && parsePYSTATEMENTS()) ||
+             backtrack(initial);
+    }
+    return true;
+  }
+
+  // PARADIGM -> OOP | PP | MIXED
+  bool parsePARADIGM()
+  {
+    size_t initial = position;
+
+    switch (column())
+    {
+    case COLUMN_ID:
+    case COLUMN_INDENT:
+    case COLUMN_NOINDENT:
+      return parseOOP() ||
+             (backtrack(initial) && parsePP()) ||
+             (backtrack(initial) && parseMIXED());
+    case COLUMN_CLASS:
+      return parseOOP() ||
+             (backtrack(initial) && parseMIXED());
+    case COLUMN_DEF:
+      return parsePP() ||
+             (backtrack(initial) && parseMIXED());
+    }
+    return fail();
+  }
+
+  // OOP -> PYCLASS | CLASS
+  bool parseOOP()
+  {
+    size_t initial = position;
+
+    switch (column())
+    {
+    case COLUMN_ID:
+    case COLUMN_INDENT:
+      return parseCLASS();
+    case COLUMN_CLASS:
+    case COLUMN_NOINDENT:
+      return parsePYCLASS() ||
+             (backtrack(initial) && parseCLASS());
+    }
+    return fail();
+  }
+
+  // CLASS -> PREFIX CLASSCOMPLEMENT | CLASSCOMPLEMENT
+  bool parseCLASS()
+  {
+    switch (column())
+    {
+    case COLUMN_ID:
+    case COLUMN_CLASS:
+      return parseCLASSCOMPLEMENT();
+    case COLUMN_INDENT:
+    case COLUMN_NOINDENT:
+      return parsePREFIX() && parseCLASSCOMPLEMENT();
+    }
+    return fail();
+  }
+
+  // CLASSCOMPLEMENT -> IDS class IDS { STATEMENTS } CLASSCOMPLEMENT'
+  bool parseCLASSCOMPLEMENT()
+  {
+    switch (column())
+    {
+    case COLUMN_ID:
+    case COLUMN_CLASS:
+      return parseIDS() && match(COLUMN_CLASS) && parseIDS() && match(COLUMN_OPEN_BRACE) && parseSTATEMENTS() && match(COLUMN_CLOSE_BRACE) && parseCLASSCOMPLEMENTPrime();
+    }
+    return fail();
+  }
+
+  // CLASSCOMPLEMENT' -> MAIN | STATEMENTS CLASS | ε
+  bool parseCLASSCOMPLEMENTPrime()
+  {
+    size_t initial = position;
+
+    switch (column())
+    {
+    case COLUMN_ID:
+    case COLUMN_MAIN:
+      return parseMAIN() ||
+             backtrack(initial);
+    case COLUMN_INDENT:
+    case COLUMN_NOINDENT:
+      return parseMAIN() ||
+             (backtrack(initial) && parseSTATEMENTS() && parseCLASS()) ||
+             backtrack(initial);
+    }
+    return true;
+  }
+
+  // MAIN -> PREFIX IDS main ( IDS ) { STATEMENTS } | IDS main ( IDS ) { STATEMENTS }
+  bool parseMAIN()
+  {
+    switch (column())
+    {
+    case COLUMN_ID:
+    case COLUMN_MAIN:
+      return parseIDS() && match(COLUMN_MAIN) && match(COLUMN_OPEN_PAREN) && parseIDS() && match(COLUMN_CLOSE_PAREN) && match(COLUMN_OPEN_BRACE) && parseSTATEMENTS() && match(COLUMN_CLOSE_BRACE);
+    case COLUMN_INDENT:
+    case COLUMN_NOINDENT:
+      return parsePREFIX() && parseIDS() && match(COLUMN_MAIN) && match(COLUMN_OPEN_PAREN) && parseIDS() && match(COLUMN_CLOSE_PAREN) && match(COLUMN_OPEN_BRACE) && parseSTATEMENTS() && match(COLUMN_CLOSE_BRACE);
+    }
+    return fail();
+  }
+
+  // PYCLASS -> noindent class IDS PYCLASS' PYCLASS'' | class IDS PYCLASS' PYCLASS''
+  bool parsePYCLASS()
+  {
+    switch (column())
+    {
+    case COLUMN_CLASS:
+      return match(COLUMN_CLASS) && parseIDS() && parsePYCLASSPrime() && parsePYCLASSDoublePrime();
+    case COLUMN_NOINDENT:
+      return match(COLUMN_NOINDENT) && match(COLUMN_CLASS) && parseIDS() && parsePYCLASSPrime() && parsePYCLASSDoublePrime();
+    }
+    return fail();
+  }
+
+  // PYCLASS' -> INDENTEDBLOCK | ( IDS ) INDENTEDBLOCK
+  bool parsePYCLASSPrime()
+  {
+    switch (column())
+    {
+    case COLUMN_OPEN_PAREN:
+      return match(COLUMN_OPEN_PAREN) && parseIDS() && match(COLUMN_CLOSE_PAREN) && parseINDENTEDBLOCK();
+    case COLUMN_INDENT:
+      return parseINDENTEDBLOCK();
+    }
+    return fail();
+  }
+
+  // PYCLASS'' -> PYSTATEMENTS PYCLASS | ε
+  bool parsePYCLASSDoublePrime()
+  {
+    size_t initial = position;
+
+    switch (column())
+    {
+    case COLUMN_ID:
+    case COLUMN_NOINDENT:
+      return (parsePYSTATEMENTS() && parsePYCLASS()) ||
+             backtrack(initial);
+    }
+    return true;
+  }
+
+  // PP -> PYFUNC | FUNC
+  bool parsePP()
+  {
+    size_t initial = position;
+
+    switch (column())
+    {
+    case COLUMN_ID:
+    case COLUMN_INDENT:
+      return parseFUNC();
+    case COLUMN_DEF:
+      return parsePYFUNC();
+    case COLUMN_NOINDENT:
+      return parsePYFUNC() ||
+             (backtrack(initial) && parseFUNC());
+    }
+    return fail();
+  }
+
+  // PP' -> MAIN | ε
+  bool parsePPPrime()
+  {
+    size_t initial = position;
+
+    switch (column())
+    {
+    case COLUMN_ID:
+    case COLUMN_MAIN:
+    case COLUMN_INDENT:
+    case COLUMN_NOINDENT:
+      return parseMAIN() ||
+             backtrack(initial);
+    }
+    return true;
+  }
+
+  // PP'' -> FUNC | ε
+  bool parsePPDoublePrime()
+  {
+    size_t initial = position;
+
+    switch (column())
+    {
+    case COLUMN_ID:
+    case COLUMN_INDENT:
+    case COLUMN_NOINDENT:
+      return parseFUNC() ||
+             backtrack(initial);
+    }
+    return true;
+  }
+
+  // FUNC -> id IDS ( IDS ) { STATEMENTS } FUNC' | PREFIX id IDS ( IDS ) { STATEMENTS } FUNC'
+  bool parseFUNC()
+  {
+    switch (column())
+    {
+    case COLUMN_ID:
+      return match(COLUMN_ID) && parseIDS() && match(COLUMN_OPEN_PAREN) && parseIDS() && match(COLUMN_CLOSE_PAREN) && match(COLUMN_OPEN_BRACE) && parseSTATEMENTS() && match(COLUMN_CLOSE_BRACE) && parseFUNCPrime();
+    case COLUMN_INDENT:
+    case COLUMN_NOINDENT:
+      return parsePREFIX() && match(COLUMN_ID) && parseIDS() && match(COLUMN_OPEN_PAREN) && parseIDS() && match(COLUMN_CLOSE_PAREN) && match(COLUMN_OPEN_BRACE) && parseSTATEMENTS() && match(COLUMN_CLOSE_BRACE) && parseFUNCPrime();
+    }
+    return fail();
+  }
+
+  // FUNC' -> STATEMENTS FUNC | ε
+  bool parseFUNCPrime()
+  {
+    size_t initial = position;
+
+    switch (column())
+    {
+    case COLUMN_INDENT:
+    case COLUMN_NOINDENT:
+      return (parseSTATEMENTS() && parseFUNC()) ||
+             backtrack(initial);
+    }
+    return true;
+  }
+
+  // PYFUNC -> def IDS ( IDS ) INDENTEDBLOCK PYFUNC' | noindent def main ( IDS ) INDENTEDBLOCK PYFUNC'
+  bool parsePYFUNC()
+  {
+    switch (column())
+    {
+    case COLUMN_DEF:
+      return match(COLUMN_DEF) && parseIDS() && match(COLUMN_OPEN_PAREN) && parseIDS() && match(COLUMN_CLOSE_PAREN) && parseINDENTEDBLOCK() && parsePYFUNCPrime();
+    case COLUMN_NOINDENT:
+      return match(COLUMN_NOINDENT) && match(COLUMN_DEF) && match(COLUMN_MAIN) && match(COLUMN_OPEN_PAREN) && parseIDS() && match(COLUMN_CLOSE_PAREN) && parseINDENTEDBLOCK() && parsePYFUNCPrime();
+    }
+    return fail();
+  }
+
+  // PYFUNC' -> PYSTATEMENTS PYFUNC | ε
+  bool parsePYFUNCPrime()
+  {
+    size_t initial = position;
+
+    switch (column())
+    {
+    case COLUMN_ID:
+    case COLUMN_NOINDENT:
+      return (parsePYSTATEMENTS() && parsePYFUNC()) ||
+             backtrack(initial);
+    }
+    return true;
+  }
+
+  // MIXED -> PYMIXED | MIXEDN
+  bool parseMIXED()
+  {
+    size_t initial = position;
+
+    switch (column())
+    {
+    case COLUMN_ID:
+    case COLUMN_INDENT:
+      return parseMIXEDN();
+    case COLUMN_CLASS:
+    case COLUMN_NOINDENT:
+      return parsePYMIXED() ||
+             (backtrack(initial) && parseMIXEDN());
+    case COLUMN_DEF:
+      return parsePYMIXED();
+    }
+    return fail();
+  }
+
+  // MIXEDN -> CLASS FUNC MIXEDCOMPLEMENT | FUNC CLASS MIXEDCOMPLEMENT
+  bool parseMIXEDN()
+  {
+    size_t initial = position;
+
+    switch (column())
+    {
+    case COLUMN_ID:
+    case COLUMN_INDENT:
+    case COLUMN_NOINDENT:
+      return (parseCLASS() && parseFUNC() && parseMIXEDCOMPLEMENT()) ||
+             (backtrack(initial) && parseFUNC() && parseCLASS() && parseMIXEDCOMPLEMENT());
+    case COLUMN_CLASS:
+      return parseCLASS() && parseFUNC() && parseMIXEDCOMPLEMENT();
+    }
+    return fail();
+  }
+
+  // MIXEDCOMPLEMENT -> CLASS | FUNC | MIXEDN | MAIN | ε
+  bool parseMIXEDCOMPLEMENT()
+  {
+    size_t initial = position;
+
+    switch (column())
+    {
+    case COLUMN_ID:
+    case COLUMN_INDENT:
+    case COLUMN_NOINDENT:
+      return parseCLASS() ||
+             (backtrack(initial) && parseFUNC()) ||
+             (backtrack(initial) && parseMIXEDN()) ||
+             (backtrack(initial) && parseMAIN()) ||
+             backtrack(initial);
+    case COLUMN_CLASS:
+      return parseCLASS() ||
+             (backtrack(initial) && parseMIXEDN()) ||
+             backtrack(initial);
+    case COLUMN_MAIN:
+      return parseMAIN() ||
+             backtrack(initial);
+    }
+    return true;
+  }
+
+  // PYMIXED -> PYCLASS PYFUNC PYMIXEDCOMPLEMENT | PYFUNC PYCLASS PYMIXEDCOMPLEMENT
+  bool parsePYMIXED()
+  {
+    size_t initial = position;
+
+    switch (column())
+    {
+    case COLUMN_CLASS:
+      return parsePYCLASS() && parsePYFUNC() && parsePYMIXEDCOMPLEMENT();
+    case COLUMN_DEF:
+      return parsePYFUNC() && parsePYCLASS() && parsePYMIXEDCOMPLEMENT();
+    case COLUMN_NOINDENT:
+      return (parsePYCLASS() && parsePYFUNC() && parsePYMIXEDCOMPLEMENT()) ||
+             (backtrack(initial) && parsePYFUNC() && parsePYCLASS() && parsePYMIXEDCOMPLEMENT());
+    }
+    return fail();
+  }
+
+  // PYMIXEDCOMPLEMENT -> PYCLASS | PYFUNC | PYMIXED | ε
+  bool parsePYMIXEDCOMPLEMENT()
+  {
+    size_t initial = position;
+
+    switch (column())
+    {
+    case COLUMN_CLASS:
+      return parsePYCLASS() ||
+             (backtrack(initial) && parsePYMIXED()) ||
+             backtrack(initial);
+    case COLUMN_DEF:
+      return parsePYFUNC() ||
+             (backtrack(initial) && parsePYMIXED()) ||
+             backtrack(initial);
+    case COLUMN_NOINDENT:
+      return parsePYCLASS() ||
+             (backtrack(initial) && parsePYFUNC()) ||
+             (backtrack(initial) && parsePYMIXED()) ||
+             backtrack(initial);
+    }
+    return true;
+  }
+
+  // INDENTEDBLOCK -> indent INDENTEDBLOCK' INDENTEDBLOCK''
+  bool parseINDENTEDBLOCK()
+  {
+    switch (column())
+    {
+    case COLUMN_INDENT:
+      return match(COLUMN_INDENT) && parseINDENTEDBLOCKPrime() && parseINDENTEDBLOCKDoublePrime();
+    }
+    return fail();
+  }
+
+  // INDENTEDBLOCK' -> PYSTATEMENT | def IDS ( IDS )
+  bool parseINDENTEDBLOCKPrime()
+  {
+    switch (column())
+    {
+    case COLUMN_ID:
+      return parsePYSTATEMENT();
+    case COLUMN_DEF:
+      return match(COLUMN_DEF) && parseIDS() && match(COLUMN_OPEN_PAREN) && parseIDS() && match(COLUMN_CLOSE_PAREN);
+    }
+    return fail();
+  }
+
+  // INDENTEDBLOCK'' -> INDENTEDBLOCK | ε
+  bool parseINDENTEDBLOCKDoublePrime()
+  {
+    size_t initial = position;
+
+    switch (column())
+    {
+    case COLUMN_INDENT:
+      return parseINDENTEDBLOCK() ||
+             backtrack(initial);
+    }
+    return true;
+  }
+
+  // PYSTATEMENTS -> PYSTATEMENT PYSTATEMENTS' | noindent PYSTATEMENT PYSTATEMENTS'
+  bool parsePYSTATEMENTS()
+  {
+    switch (column())
+    {
+    case COLUMN_ID:
+      return parsePYSTATEMENT() && parsePYSTATEMENTSPrime();
+    case COLUMN_NOINDENT:
+      return match(COLUMN_NOINDENT) && parsePYSTATEMENT() && parsePYSTATEMENTSPrime();
+    }
+    return fail();
+  }
+
+  // PYSTATEMENTS' -> PYSTATEMENTS | INDENTEDBLOCK | ε
+  bool parsePYSTATEMENTSPrime()
+  {
+    size_t initial = position;
+
+    switch (column())
+    {
+    case COLUMN_ID:
+    case COLUMN_NOINDENT:
+      return parsePYSTATEMENTS() ||
+             backtrack(initial);
+    case COLUMN_INDENT:
+      return parseINDENTEDBLOCK() ||
+             backtrack(initial);
+    }
+    return true;
+  }
+
+  // PYSTATEMENT -> id IDS PYSTATEMENT'
+  bool parsePYSTATEMENT()
+  {
+    switch (column())
+    {
+    case COLUMN_ID:
+      return match(COLUMN_ID) && parseIDS() && parsePYSTATEMENTPrime();
+    }
+    return fail();
+  }
+
+  // PYSTATEMENT' -> ( PYSTATEMENT'' | { PYSTATEMENT''' | ε
+  bool parsePYSTATEMENTPrime()
+  {
+    size_t initial = position;
+
+    switch (column())
+    {
+    case COLUMN_OPEN_PAREN:
+      return (match(COLUMN_OPEN_PAREN) && parsePYSTATEMENTDoublePrime()) ||
+             backtrack(initial);
+    case COLUMN_OPEN_BRACE:
+      return (match(COLUMN_OPEN_BRACE) && parsePYSTATEMENTTriplePrime()) ||
+             backtrack(initial);
+    }
+    return true;
+  }
+
+  // PYSTATEMENT'' -> IDS ) | INDENTEDBLOCK PYSTATEMENT''''
+  bool parsePYSTATEMENTDoublePrime()
+  {
+    switch (column())
+    {
+    case COLUMN_ID:
+    case COLUMN_CLOSE_PAREN:
+      return parseIDS() && match(COLUMN_CLOSE_PAREN);
+    case COLUMN_INDENT:
+      return parseINDENTEDBLOCK() && parsePYSTATEMENTQuadruplePrime();
+    }
+    return fail();
+  }
+
+  // PYSTATEMENT''' -> IDS } | INDENTEDBLOCK PYSTATEMENT'''''
+  bool parsePYSTATEMENTTriplePrime()
+  {
+    switch (column())
+    {
+    case COLUMN_ID:
+    case COLUMN_CLOSE_BRACE:
+      return parseIDS() && match(COLUMN_CLOSE_BRACE);
+    case COLUMN_INDENT:
+      return parseINDENTEDBLOCK() && parsePYSTATEMENTQuintuplePrime();
+    }
+    return fail();
+  }
+
+  // PYSTATEMENT'''' -> ) | indent )
+  bool parsePYSTATEMENTQuadruplePrime()
+  {
+    switch (column())
+    {
+    case COLUMN_CLOSE_PAREN:
+      return match(COLUMN_CLOSE_PAREN);
+    case COLUMN_INDENT:
+      return match(COLUMN_INDENT) && match(COLUMN_CLOSE_PAREN);
+    }
+    return fail();
+  }
+
+  // PYSTATEMENT''''' -> } | indent }
+  bool parsePYSTATEMENTQuintuplePrime()
+  {
+    switch (column())
+    {
+    case COLUMN_CLOSE_BRACE:
+      return match(COLUMN_CLOSE_BRACE);
+    case COLUMN_INDENT:
+      return match(COLUMN_INDENT) && match(COLUMN_CLOSE_BRACE);
+    }
+    return fail();
+  }
+
+  // STATEMENTS -> STATEMENT STATEMENTS'
+  bool parseSTATEMENTS()
+  {
+    switch (column())
+    {
+    case COLUMN_INDENT:
+    case COLUMN_NOINDENT:
+      return parseSTATEMENT() && parseSTATEMENTSPrime();
+    }
+    return fail();
+  }
+
+  // STATEMENTS' -> STATEMENTS | ε
+  bool parseSTATEMENTSPrime()
+  {
+    size_t initial = position;
+
+    switch (column())
+    {
+    case COLUMN_INDENT:
+    case COLUMN_NOINDENT:
+      return parseSTATEMENTS() ||
+             backtrack(initial);
+    }
+    return true;
+  }
+
+  // STATEMENT -> PREFIX IDS STATEMENT'
+  bool parseSTATEMENT()
+  {
+    switch (column())
+    {
+    case COLUMN_INDENT:
+    case COLUMN_NOINDENT:
+      return parsePREFIX() && parseIDS() && parseSTATEMENTPrime();
+    }
+    return fail();
+  }
+
+  // STATEMENT' -> ( STATEMENTS ) STATEMENT'' | { STATEMENTS } | ε
+  bool parseSTATEMENTPrime()
+  {
+    size_t initial = position;
+
+    switch (column())
+    {
+    case COLUMN_OPEN_PAREN:
+      return (match(COLUMN_OPEN_PAREN) && parseSTATEMENTS() && match(COLUMN_CLOSE_PAREN) && parseSTATEMENTDoublePrime()) ||
+             backtrack(initial);
+    case COLUMN_OPEN_BRACE:
+      return (match(COLUMN_OPEN_BRACE) && parseSTATEMENTS() && match(COLUMN_CLOSE_BRACE)) ||
+             backtrack(initial);
+    }
+    return true;
+  }
+
+  // STATEMENT'' -> { STATEMENTS } | ε
+  bool parseSTATEMENTDoublePrime()
+  {
+    size_t initial = position;
+
+    switch (column())
+    {
+    case COLUMN_OPEN_BRACE:
+      return (match(COLUMN_OPEN_BRACE) && parseSTATEMENTS() && match(COLUMN_CLOSE_BRACE)) ||
+             backtrack(initial);
+    }
+    return true;
+  }
+
+  // PREFIX -> indent | noindent
+  bool parsePREFIX()
+  {
+    switch (column())
+    {
+    case COLUMN_INDENT:
+      return match(COLUMN_INDENT);
+    case COLUMN_NOINDENT:
+      return match(COLUMN_NOINDENT);
+    }
+    return fail();
+  }
+
+  // IDS -> id IDS | ε
+  bool parseIDS()
+  {
+    size_t initial = position;
+
+    switch (column())
+    {
+    case COLUMN_ID:
+      return (match(COLUMN_ID) && parseIDS()) ||
+             backtrack(initial);
+    }
+    return true;
+  }
+
+public:
+  // @tokens: stream to be parsed, the parser keeps a view
+  Grammar5Parser(tokenSpan tokens)
+      : tokens(tokens)
+  {
+  }
+
+  /*
+    Parses the whole stream from the start symbol, once
+
+    Return: true if it derives, the error is at getErrorPosition() if not
+  */
+  bool parse()
+  {
+    if (!parseS())
+      return false;
+    if (position < tokens.count)
+      return fail();
+    return true;
+  }
+
+  size_t getErrorPosition()
+  {
+    return errorPos;
+  }
+};
+
+#endif
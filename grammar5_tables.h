@@ -0,0 +1,141 @@
+// generated by python/llgen.py from grammar5.md, do not edit
+#ifndef GRAMMAR5_TABLES_H
+#define GRAMMAR5_TABLES_H
+
+#include <stdint.h>
+
+#ifndef LEXGEN_TABLE
+#ifdef __cplusplus
+#define LEXGEN_TABLE constexpr
+#else
+#define LEXGEN_TABLE static const
+#endif
+#endif
+
+#define GRAMMAR5_NONTERMINALS 41
+#define GRAMMAR5_PRODUCTIONS 89
+// terminal columns, the last one (GRAMMAR5_END) is the end of the input
+#define GRAMMAR5_COLUMNS 11
+#define GRAMMAR5_END 10
+#define GRAMMAR5_NONE 255
+#define GRAMMAR5_NONTERMINAL_BASE 128
+#define GRAMMAR5_CONFLICTS 39
+
+// nonterminals, the first one is the start symbol
+#define GRAMMAR5_S 0
+#define GRAMMAR5_S_PRIME 1
+#define GRAMMAR5_PARADIGM 2
+#define GRAMMAR5_OOP 3
+#define GRAMMAR5_CLASS 4
+#define GRAMMAR5_CLASSCOMPLEMENT 5
+#define GRAMMAR5_CLASSCOMPLEMENT_PRIME 6
+#define GRAMMAR5_MAIN 7
+#define GRAMMAR5_PYCLASS 8
+#define GRAMMAR5_PYCLASS_PRIME 9
+#define GRAMMAR5_PYCLASS_DOUBLE_PRIME 10
+#define GRAMMAR5_PP 11
+#define GRAMMAR5_PP_PRIME 12
+#define GRAMMAR5_PP_DOUBLE_PRIME 13
+#define GRAMMAR5_FUNC 14
+#define GRAMMAR5_FUNC_PRIME 15
+#define GRAMMAR5_PYFUNC 16
+#define GRAMMAR5_PYFUNC_PRIME 17
+#define GRAMMAR5_MIXED 18
+#define GRAMMAR5_MIXEDN 19
+#define GRAMMAR5_MIXEDCOMPLEMENT 20
+#define GRAMMAR5_PYMIXED 21
+#define GRAMMAR5_PYMIXEDCOMPLEMENT 22
+#define GRAMMAR5_INDENTEDBLOCK 23
+#define GRAMMAR5_INDENTEDBLOCK_PRIME 24
+#define GRAMMAR5_INDENTEDBLOCK_DOUBLE_PRIME 25
+#define GRAMMAR5_PYSTATEMENTS 26
+#define GRAMMAR5_PYSTATEMENTS_PRIME 27
+#define GRAMMAR5_PYSTATEMENT 28
+#define GRAMMAR5_PYSTATEMENT_PRIME 29
+#define GRAMMAR5_PYSTATEMENT_DOUBLE_PRIME 30
+#define GRAMMAR5_PYSTATEMENT_TRIPLE_PRIME 31
+#define GRAMMAR5_PYSTATEMENT_QUADRUPLE_PRIME 32
+#define GRAMMAR5_PYSTATEMENT_QUINTUPLE_PRIME 33
+#define GRAMMAR5_STATEMENTS 34
+#define GRAMMAR5_STATEMENTS_PRIME 35
+#define GRAMMAR5_STATEMENT 36
+#define GRAMMAR5_STATEMENT_PRIME 37
+#define GRAMMAR5_STATEMENT_DOUBLE_PRIME 38
+#define GRAMMAR5_PREFIX 39
+#define GRAMMAR5_IDS 40
+
+// columns: 0 id (<0>), 1 class (<1>), 2 def (<2>), 3 main (<3>), 4 ( (<4>), 5 ) (<5>), 6 { (<6>), 7 } (<7>), 8 indent (<8>), 9 noindent (<9>), 10 $
+// token id -> column, GRAMMAR5_NONE for the ids the grammar doesn't use
+LEXGEN_TABLE uint8_t grammar5ColumnOf[256] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
+
+// nonterminal x column -> production, GRAMMAR5_NONE if no alternative starts with the token
+LEXGEN_TABLE uint8_t grammar5Predict[41][11] = {
+    {0, 0, 0, 255, 255, 255, 255, 255, 0, 0, 255},
+    {4, 255, 255, 255, 255, 255, 255, 255, 3, 3, 5},
+    {6, 6, 7, 255, 255, 255, 255, 255, 6, 6, 255},
+    {10, 9, 255, 255, 255, 255, 255, 255, 10, 9, 255},
+    {12, 12, 255, 255, 255, 255, 255, 255, 11, 11, 255},
+    {13, 13, 255, 255, 255, 255, 255, 255, 255, 255, 255},
+    {14, 16, 255, 14, 255, 255, 255, 255, 14, 14, 16},
+    {18, 255, 255, 18, 255, 255, 255, 255, 17, 17, 255},
+    {255, 20, 255, 255, 255, 255, 255, 255, 255, 19, 255},
+    {255, 255, 255, 255, 22, 255, 255, 255, 21, 255, 255},
+    {23, 24, 24, 255, 255, 255, 255, 255, 24, 23, 24},
+    {26, 255, 25, 255, 255, 255, 255, 255, 26, 25, 255},
+    {27, 255, 255, 27, 255, 255, 255, 255, 27, 27, 255},
+    {29, 255, 255, 255, 255, 255, 255, 255, 29, 29, 255},
+    {31, 255, 255, 255, 255, 255, 255, 255, 32, 32, 255},
+    {34, 34, 255, 34, 255, 255, 255, 255, 33, 33, 34},
+    {255, 255, 35, 255, 255, 255, 255, 255, 255, 36, 255},
+    {37, 38, 38, 255, 255, 255, 255, 255, 38, 37, 38},
+    {40, 39, 39, 255, 255, 255, 255, 255, 40, 39, 255},
+    {41, 41, 255, 255, 255, 255, 255, 255, 41, 41, 255},
+    {43, 43, 255, 46, 255, 255, 255, 255, 43, 43, 47},
+    {255, 48, 49, 255, 255, 255, 255, 255, 255, 48, 255},
+    {53, 50, 51, 255, 255, 255, 255, 255, 53, 50, 53},
+    {255, 255, 255, 255, 255, 255, 255, 255, 54, 255, 255},
+    {55, 255, 56, 255, 255, 255, 255, 255, 255, 255, 255},
+    {58, 58, 58, 255, 255, 58, 255, 58, 57, 58, 58},
+    {59, 255, 255, 255, 255, 255, 255, 255, 255, 60, 255},
+    {61, 63, 63, 255, 255, 255, 255, 255, 62, 61, 63},
+    {64, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255},
+    {67, 67, 67, 255, 65, 67, 66, 67, 67, 67, 67},
+    {68, 255, 255, 255, 255, 68, 255, 255, 69, 255, 255},
+    {70, 255, 255, 255, 255, 255, 255, 70, 71, 255, 255},
+    {255, 255, 255, 255, 255, 72, 255, 255, 73, 255, 255},
+    {255, 255, 255, 255, 255, 255, 255, 74, 75, 255, 255},
+    {255, 255, 255, 255, 255, 255, 255, 255, 76, 76, 255},
+    {78, 78, 78, 255, 255, 78, 255, 78, 77, 77, 78},
+    {255, 255, 255, 255, 255, 255, 255, 255, 79, 79, 255},
+    {82, 82, 82, 255, 80, 82, 81, 82, 82, 82, 82},
+    {84, 84, 84, 255, 255, 84, 83, 84, 84, 84, 84},
+    {255, 255, 255, 255, 255, 255, 255, 255, 85, 86, 255},
+    {87, 88, 88, 88, 88, 88, 88, 88, 88, 88, 88}
+};
+
+// production -> nonterminal on its left
+LEXGEN_TABLE uint8_t grammar5Lhs[89] = {0, 0, 0, 1, 1, 1, 2, 2, 2, 3, 3, 4, 4, 5, 6, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13, 14, 14, 15, 15, 16, 16, 17, 17, 18, 18, 19, 19, 20, 20, 20, 20, 20, 21, 21, 22, 22, 22, 22, 23, 24, 24, 25, 25, 26, 26, 27, 27, 27, 28, 29, 29, 29, 30, 30, 31, 31, 32, 32, 33, 33, 34, 35, 35, 36, 37, 37, 37, 38, 38, 39, 39, 40, 40};
+
+// nonterminal -> its first production, grammar5FirstProduction[n + 1] - 1 is its last
+LEXGEN_TABLE uint8_t grammar5FirstProduction[42] = {0, 3, 6, 9, 11, 13, 14, 17, 19, 21, 23, 25, 27, 29, 31, 33, 35, 37, 39, 41, 43, 48, 50, 54, 55, 57, 59, 61, 64, 65, 68, 70, 72, 74, 76, 77, 79, 80, 83, 85, 87, 89};
+
+// production -> first symbol in grammar5Rhs, one past the last production at the end
+LEXGEN_TABLE uint16_t grammar5RhsStart[90] = {0, 2, 5, 8, 9, 10, 10, 11, 12, 13, 14, 15, 17, 18, 25, 26, 28, 28, 37, 45, 50, 54, 55, 59, 61, 61, 62, 63, 64, 64, 65, 65, 74, 84, 86, 86, 93, 101, 103, 103, 104, 105, 108, 111, 112, 113, 114, 115, 115, 118, 121, 122, 123, 124, 124, 127, 128, 133, 134, 134, 136, 139, 140, 141, 141, 144, 146, 148, 148, 150, 152, 154, 156, 157, 159, 160, 162, 164, 165, 165, 168, 172, 175, 175, 178, 178, 179, 180, 182, 182};
+
+// right hand sides, columns below GRAMMAR5_NONTERMINAL_BASE and nonterminals from it
+LEXGEN_TABLE uint8_t grammar5Rhs[182] = {130, 129, 162, 130, 129, 154, 130, 129, 162, 154, 131, 139, 146, 136, 132, 167, 133, 133, 168, 1, 168, 6, 162, 7, 134, 135, 162, 132, 167, 168, 3, 4, 168, 5, 6, 162, 7, 168, 3, 4, 168, 5, 6, 162, 7, 9, 1, 168, 137, 138, 1, 168, 137, 138, 151, 4, 168, 5, 151, 154, 136, 144, 142, 135, 142, 0, 168, 4, 168, 5, 6, 162, 7, 143, 167, 0, 168, 4, 168, 5, 6, 162, 7, 143, 162, 142, 2, 168, 4, 168, 5, 151, 145, 9, 2, 3, 4, 168, 5, 151, 145, 154, 144, 149, 147, 132, 142, 148, 142, 132, 148, 132, 142, 147, 135, 136, 144, 150, 144, 136, 150, 136, 144, 149, 8, 152, 153, 156, 2, 168, 4, 168, 5, 151, 156, 155, 9, 156, 155, 154, 151, 0, 168, 157, 4, 158, 6, 159, 168, 5, 151, 160, 168, 7, 151, 161, 5, 8, 5, 7, 8, 7, 164, 163, 162, 167, 168, 165, 4, 162, 5, 166, 6, 162, 7, 6, 162, 7, 8, 9, 0, 168};
+
+// production -> FIRST+ set, one bit per column
+LEXGEN_TABLE uint32_t grammar5FirstPlus[89] = {0x307, 0x300, 0x201, 0x300, 0x201, 0x400, 0x303, 0x305, 0x307, 0x202, 0x303, 0x300, 0x3, 0x3, 0x309, 0x300, 0x70b, 0x300, 0x9, 0x200, 0x2, 0x100, 0x10, 0x201, 0x707, 0x204, 0x301, 0x309, 0x0, 0x301, 0x0, 0x1, 0x300, 0x300, 0x70b, 0x4, 0x200, 0x201, 0x707, 0x206, 0x303, 0x303, 0x301, 0x303, 0x301, 0x303, 0x309, 0x701, 0x202, 0x204, 0x202, 0x204, 0x206, 0x701, 0x100, 0x1, 0x4, 0x100, 0x7a7, 0x1, 0x200, 0x201, 0x100, 0x707, 0x1, 0x10, 0x40, 0x7a7, 0x21, 0x100, 0x81, 0x100, 0x20, 0x100, 0x80, 0x100, 0x300, 0x300, 0x7a7, 0x300, 0x10, 0x40, 0x7a7, 0x40, 0x7a7, 0x100, 0x200, 0x1, 0x7ff};
+
+// production -> 1 if it derives ε, its FIRST+ set then holds the FOLLOW of its left hand side
+LEXGEN_TABLE uint8_t grammar5Nullable[89] = {0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 1, 0, 1, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 1, 0, 1, 0, 0, 0, 1};
+
+// nonterminal -> 1 if two of its alternatives share a token (not LL(1), the first one is predicted)
+LEXGEN_TABLE uint8_t grammar5Conflicted[41] = {1, 1, 1, 1, 0, 0, 1, 0, 0, 0, 1, 1, 0, 0, 0, 1, 0, 1, 1, 1, 1, 1, 1, 0, 0, 1, 0, 1, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1};
+
+// names as the grammar file writes them, for messages
+LEXGEN_TABLE char grammar5NonterminalNames[41][18] = {"S", "S'", "PARADIGM", "OOP", "CLASS", "CLASSCOMPLEMENT", "CLASSCOMPLEMENT'", "MAIN", "PYCLASS", "PYCLASS'", "PYCLASS''", "PP", "PP'", "PP''", "FUNC", "FUNC'", "PYFUNC", "PYFUNC'", "MIXED", "MIXEDN", "MIXEDCOMPLEMENT", "PYMIXED", "PYMIXEDCOMPLEMENT", "INDENTEDBLOCK", "INDENTEDBLOCK'", "INDENTEDBLOCK''", "PYSTATEMENTS", "PYSTATEMENTS'", "PYSTATEMENT", "PYSTATEMENT'", "PYSTATEMENT''", "PYSTATEMENT'''", "PYSTATEMENT''''", "PYSTATEMENT'''''", "STATEMENTS", "STATEMENTS'", "STATEMENT", "STATEMENT'", "STATEMENT''", "PREFIX", "IDS"};
+LEXGEN_TABLE char grammar5TerminalNames[11][9] = {"id", "class", "def", "main", "(", ")", "{", "}", "indent", "noindent", "$"};
+
+#endif
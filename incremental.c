@@ -0,0 +1,590 @@
+/*
+  Incremental scan for editors: after an edit only the tokens around it are
+  lexed again and spliced into the previous token stream
+
+  a rescan starts at the last restart token before the edit and stops as soon
+  as a restart token after the edit lines up with one of the old stream, from
+  there on the old tokens are kept, moved by the size of the edit
+  restart tokens are the ones whose lexeme starts where the DFA left state 0,
+  so the DFA is known to be in state 0 at their offset: every token but indent
+  and noindent, which start at the line break before them, and the ones that
+  start in the middle of a UTF-8 sequence, whose first byte is read as part of it
+
+  the result is the same token stream (ids, offsets, lines) and errors a full
+  scan of the new text gives, symbol ids are kept stable instead of being
+  renumbered in order of first occurrence
+*/
+
+#define LIVE_CHUNK_SIZE 1024
+// bytes after a position that the UTF-8 decoding of its symbol can read
+#define LIVE_LOOKAHEAD 4
+
+/*
+  Tables of a text that is being edited
+
+  @data, @length: current text, owned by the caller, the errors are views into it
+  @inserted: tokens of the last rescan before they are spliced
+  @insertedErrors: errors of the last rescan before they are spliced
+  @evidence: number of class, def and main tokens, the paradigm evidence
+*/
+struct liveScan
+{
+  dfaLanguage language;
+  scanTables *tables;
+  const char *data;
+  size_t length;
+  tokenStream inserted;
+  size_t (*insertedErrors)[2];
+  size_t insertedErrorCount;
+  size_t insertedErrorSize;
+  size_t evidence[4];
+};
+
+/*
+  Position of a token while the stream is read in order
+
+  @checkpoint: next checkpoint of the stream
+*/
+struct tokenReader
+{
+  size_t index;
+  size_t checkpoint;
+  uint64_t offset;
+  size_t line;
+};
+typedef struct tokenReader tokenReader;
+
+/*
+  Determines if the DFA is in state 0 at the offset of a token
+
+  @tokenId: token id
+  @lexeme, @length: lexeme of the token
+
+  Return: 1 if a scan can restart at the token, 0 if not
+*/
+int isRestartToken(int tokenId, const char *lexeme, size_t length)
+{
+  return tokenId != 8 && tokenId != 9 && length && ((unsigned char)lexeme[0] & 0xC0) != 0x80;
+}
+
+/*
+  Places a reader on a token
+
+  @tokens: stream to be read
+  @index: index of the token, count for the end of the stream
+  @reader: reader to be placed
+
+  Return: none
+*/
+void seekToken(tokenStream *tokens, size_t index, tokenReader *reader)
+{
+  tokenSpan span = tokenStreamSpan(tokens);
+  reader->index = index;
+  reader->offset = tokenSpanOffset(&span, index);
+  reader->line = tokenSpanLine(&span, index);
+
+  // first checkpoint after the token
+  size_t low = 0;
+  size_t high = tokens->checkpointCount;
+  while (low < high)
+  {
+    size_t middle = low + (high - low) / 2;
+    if (tokens->checkpoints[middle].token <= index)
+      low = middle + 1;
+    else
+      high = middle;
+  }
+  reader->checkpoint = low;
+}
+
+/*
+  Moves a reader to the next token
+
+  @tokens: stream to be read
+  @reader: reader to be moved
+
+  Return: none
+*/
+void nextToken(tokenStream *tokens, tokenReader *reader)
+{
+  size_t index = ++reader->index;
+  if (index >= tokens->count)
+    return;
+
+  if (reader->checkpoint < tokens->checkpointCount && tokens->checkpoints[reader->checkpoint].token == index)
+  {
+    reader->offset = tokens->checkpoints[reader->checkpoint].offset;
+    reader->line = tokens->checkpoints[reader->checkpoint].line;
+    reader->checkpoint++;
+  }
+  else
+  {
+    reader->offset += tokens->offsetDeltas[index];
+    reader->line += tokens->lineDeltas[index];
+  }
+}
+
+/*
+  Finds the first token at or after an offset
+
+  @tokens: stream to be searched
+  @offset: byte offset
+
+  Return: index of the token, count if there is none
+*/
+size_t findToken(tokenStream *tokens, size_t offset)
+{
+  if (!tokens->count)
+    return 0;
+
+  // last checkpoint before the offset, then the deltas after it
+  size_t low = 0;
+  size_t high = tokens->checkpointCount;
+  while (high - low > 1)
+  {
+    size_t middle = low + (high - low) / 2;
+    if (tokens->checkpoints[middle].offset < offset)
+      low = middle;
+    else
+      high = middle;
+  }
+
+  tokenReader reader;
+  seekToken(tokens, tokens->checkpoints[low].token, &reader);
+  while (reader.index < tokens->count && reader.offset < offset)
+    nextToken(tokens, &reader);
+  return reader.index;
+}
+
+/*
+  Finds the first error at or after an offset
+
+  @errors: error table, views sorted by offset
+
+  Return: index of the error, position if there is none
+*/
+size_t findError(charTable *errors, size_t offset)
+{
+  size_t low = 0;
+  size_t high = errors->position;
+  while (low < high)
+  {
+    size_t middle = low + (high - low) / 2;
+    if (errors->views[middle][0] < offset)
+      low = middle + 1;
+    else
+      high = middle;
+  }
+  return low;
+}
+
+/*
+  State of a rescan, shared with its callback
+
+  @oldEnd, @newEnd: end of the edited range in the old text and in the new one
+  @old: reader over the old stream, only moves forward
+  @synced: 1 once a new token lined up with an old one
+  @syncToken, @syncLine: old token where the rescan lined up, and the line it has in the new text
+*/
+struct rescan
+{
+  liveScan *scan;
+  size_t oldEnd;
+  size_t newEnd;
+  tokenReader old;
+  int synced;
+  size_t syncToken;
+  size_t syncLine;
+};
+typedef struct rescan rescan;
+
+/*
+  Callback of the rescan, keeps the lexemes apart until they are spliced and
+  stops taking them once the new tokens line up with the old ones
+
+  @context: rescan in progress
+
+  Return: none
+*/
+void recordRescanned(void *context, int tokenId, const char *lexeme, size_t length, size_t offset, size_t line)
+{
+  rescan *state = context;
+  liveScan *scan = state->scan;
+  if (state->synced)
+    return;
+
+  if (tokenId == DFA_ERROR)
+  {
+    if (scan->insertedErrorCount >= scan->insertedErrorSize)
+    {
+      scan->insertedErrorSize = scan->insertedErrorSize ? scan->insertedErrorSize * 2 : DEFAULT_SIZE;
+      scan->insertedErrors = realloc(scan->insertedErrors, scan->insertedErrorSize * sizeof(size_t[2]));
+    }
+    scan->insertedErrors[scan->insertedErrorCount][0] = offset;
+    scan->insertedErrors[scan->insertedErrorCount][1] = length;
+    scan->insertedErrorCount++;
+    return;
+  }
+
+  if (offset >= state->newEnd && isRestartToken(tokenId, lexeme, length))
+  {
+    // the same text follows both offsets and the DFA is in state 0 at both
+    tokenStream *tokens = scan->tables->tokens;
+    size_t oldOffset = offset - state->newEnd + state->oldEnd;
+    while (state->old.index < tokens->count && state->old.offset < oldOffset)
+      nextToken(tokens, &state->old);
+
+    tokenReader candidate = state->old;
+    while (candidate.index < tokens->count && candidate.offset == oldOffset)
+    {
+      if (tokens->ids[candidate.index] == tokenId)
+      {
+        state->synced = 1;
+        state->syncToken = candidate.index;
+        state->syncLine = line;
+        return;
+      }
+      nextToken(tokens, &candidate);
+    }
+  }
+
+  recordToken(&scan->inserted, tokenId, tokenId == 0 ? internLexeme(scan->tables->identifiers, lexeme, length) : -1,
+              offset, line);
+}
+
+/*
+  Makes room for a number of tokens in a stream
+
+  @tokens: stream to be grown
+  @count: number of tokens it has to hold
+
+  Return: none
+*/
+void reserveTokens(tokenStream *tokens, size_t count)
+{
+  while (tokens->size < count)
+    growTokenStream(tokens);
+}
+
+/*
+  Appends a checkpoint as it is
+
+  @tokens: stream to be used
+  @checkpoint: checkpoint to be appended
+
+  Return: none
+*/
+void appendCheckpoint(tokenStream *tokens, tokenCheckpoint checkpoint)
+{
+  if (tokens->checkpointCount >= tokens->checkpointSize)
+  {
+    tokens->checkpoints = tokens->grow(tokens->allocator, tokens->checkpoints,
+                                       tokens->checkpointSize * sizeof(tokenCheckpoint),
+                                       tokens->checkpointSize * 2 * sizeof(tokenCheckpoint));
+    tokens->checkpointSize *= 2;
+  }
+  tokens->checkpoints[tokens->checkpointCount++] = checkpoint;
+}
+
+/*
+  Adds the paradigm evidence of some tokens
+
+  @scan: scan to be updated
+  @ids: token ids
+  @count: number of tokens
+  @sign: 1 to add them, -1 to take them away
+
+  Return: none
+*/
+void countEvidence(liveScan *scan, const uint8_t *ids, size_t count, int sign)
+{
+  for (size_t i = 0; i < count; i++)
+    if (ids[i] >= 1 && ids[i] <= 3)
+      scan->evidence[ids[i]] += sign;
+}
+
+/*
+  Replaces the old tokens [first, last) with the rescanned ones, the tokens from
+  last on are moved by the size of the edit
+
+  @scan: scan to be updated
+  @first: first old token that was rescanned
+  @last: old token where the rescan lined up, count if it didn't
+  @offsetDelta: bytes added by the edit, negative if it removed them
+  @lineDelta: lines added by the edit
+
+  the token columns after the edit are moved with memmove, a few bytes per
+  token, only their checkpoints are rewritten
+
+  Return: none
+*/
+void spliceTokens(liveScan *scan, size_t first, size_t last, long long offsetDelta, long long lineDelta)
+{
+  tokenStream *tokens = scan->tables->tokens;
+  tokenStream *inserted = &scan->inserted;
+  size_t tail = tokens->count - last;
+  size_t count = first + inserted->count + tail;
+
+  // symbols and evidence of the tokens that go away
+  for (size_t i = first; i < last; i++)
+    if (tokens->symbols[i] >= 0)
+      scan->tables->identifiers->entries[tokens->symbols[i]].count--;
+  countEvidence(scan, tokens->ids + first, last - first, -1);
+  countEvidence(scan, inserted->ids, inserted->count, 1);
+
+  tokenReader tailStart;
+  seekToken(tokens, last, &tailStart);
+  size_t tailCheckpoint = tailStart.checkpoint;
+  uint64_t lastOffset = tokens->lastOffset;
+  uint32_t lastLine = tokens->lastLine;
+
+  // the old checkpoints of the tail, they are overwritten by the inserted tokens
+  size_t tailCheckpoints = tokens->checkpointCount - tailCheckpoint;
+  tokenCheckpoint *moved = malloc((tailCheckpoints + 1) * sizeof(tokenCheckpoint));
+  memcpy(moved, tokens->checkpoints + tailCheckpoint, tailCheckpoints * sizeof(tokenCheckpoint));
+
+  reserveTokens(tokens, count);
+  size_t to = first + inserted->count;
+  memmove(tokens->ids + to, tokens->ids + last, tail);
+  memmove(tokens->symbols + to, tokens->symbols + last, tail * sizeof(int32_t));
+  memmove(tokens->offsetDeltas + to, tokens->offsetDeltas + last, tail);
+  memmove(tokens->lineDeltas + to, tokens->lineDeltas + last, tail);
+
+  // back to the tokens before the edit
+  tokenReader previous;
+  seekToken(tokens, first ? first - 1 : 0, &previous);
+  tokens->count = first;
+  tokens->checkpointCount = previous.checkpoint;
+  if (!first)
+    tokens->checkpointCount = 0;
+  tokens->lastOffset = first ? previous.offset : 0;
+  tokens->lastLine = first ? previous.line : 0;
+
+  tokenReader reader;
+  seekToken(inserted, 0, &reader);
+  for (; reader.index < inserted->count; nextToken(inserted, &reader))
+    recordToken(tokens, inserted->ids[reader.index], inserted->symbols[reader.index], reader.offset, reader.line);
+
+  if (tail)
+  {
+    // a checkpoint on the first moved token, the ones after it stay as far apart as they were
+    tokenCheckpoint checkpoint = {tailStart.offset + offsetDelta, (uint32_t)to, (uint32_t)(tailStart.line + lineDelta)};
+    appendCheckpoint(tokens, checkpoint);
+    tokens->offsetDeltas[to] = tokens->lineDeltas[to] = 0;
+    for (size_t i = 0; i < tailCheckpoints; i++)
+    {
+      moved[i].token += to - last;
+      moved[i].offset += offsetDelta;
+      moved[i].line += lineDelta;
+      appendCheckpoint(tokens, moved[i]);
+    }
+    tokens->count = count;
+    tokens->lastOffset = lastOffset + offsetDelta;
+    tokens->lastLine = lastLine + lineDelta;
+  }
+  free(moved);
+}
+
+/*
+  Replaces the old errors in [from, to) with the rescanned ones, the ones after
+  are moved by the size of the edit
+
+  @scan: scan to be updated
+  @from, @to: old range that was rescanned
+  @offsetDelta: bytes added by the edit
+
+  Return: none
+*/
+void spliceErrors(liveScan *scan, size_t from, size_t to, long long offsetDelta)
+{
+  charTable *errors = scan->tables->errors;
+  size_t first = findError(errors, from);
+  size_t last = findError(errors, to);
+  size_t tail = errors->position - last;
+  size_t count = first + scan->insertedErrorCount + tail;
+
+  size_t size = errors->size;
+  while (size < count)
+    size *= 2;
+  if (size != errors->size)
+  {
+    errors->views = arenaGrow(errors->arena, errors->views, errors->size * sizeof(size_t[2]), size * sizeof(size_t[2]));
+    errors->size = size;
+  }
+
+  size_t moveTo = first + scan->insertedErrorCount;
+  memmove(errors->views + moveTo, errors->views + last, tail * sizeof(size_t[2]));
+  for (size_t i = moveTo; i < count; i++)
+    errors->views[i][0] += offsetDelta;
+  if (scan->insertedErrorCount)
+    memcpy(errors->views + first, scan->insertedErrors, scan->insertedErrorCount * sizeof(size_t[2]));
+  errors->position = count;
+}
+
+/*
+  Scans the first version of a text
+
+  @data: text, owned by the caller and kept alive while the scan is used
+  @length: length of the text
+
+  Return: scan of the text
+*/
+liveScan *initLiveScan(const char *data, size_t length)
+{
+  liveScan *scan = malloc(sizeof(liveScan));
+  initScannerLanguage(&scan->language);
+  scan->tables = initScanTables(length);
+  initTokenStream(&scan->inserted, 0, tokenStreamRealloc, NULL);
+  scan->insertedErrors = NULL;
+  scan->insertedErrorCount = scan->insertedErrorSize = 0;
+
+  scanBuffer(data, length, scan->tables);
+  scan->data = data;
+  scan->length = length;
+  memset(scan->evidence, 0, sizeof(scan->evidence));
+  countEvidence(scan, scan->tables->tokens->ids, scan->tables->tokens->count, 1);
+  return scan;
+}
+
+/*
+  Updates a scan after an edit
+
+  @scan: scan of the previous text
+  @data: whole new text, owned by the caller like the first one
+  @length: length of the new text
+  @editStart: first byte that changed
+  @oldEnd: end of the replaced range in the previous text
+  @newEnd: end of the replacement in the new text
+  @edit: optional, filled with what was rescanned
+
+  the bytes before editStart and from oldEnd on must be the same in both
+  texts (the ones from oldEnd on being at newEnd in the new text)
+
+  Return: none
+*/
+void editLiveScan(liveScan *scan, const char *data, size_t length, size_t editStart, size_t oldEnd, size_t newEnd,
+                  scanEdit *edit)
+{
+  tokenStream *tokens = scan->tables->tokens;
+  long long offsetDelta = (long long)newEnd - (long long)oldEnd;
+
+  // last restart token whose symbol doesn't read the edit, or the start of the text
+  size_t first = findToken(tokens, editStart >= LIVE_LOOKAHEAD ? editStart - LIVE_LOOKAHEAD + 1 : 0);
+  size_t restart = 0;
+  size_t restartLine = 0;
+  while (first > 0)
+  {
+    tokenReader reader;
+    seekToken(tokens, first - 1, &reader);
+    const char *lexeme = scan->data + reader.offset;
+    if (isRestartToken(tokens->ids[first - 1], lexeme, scan->length - reader.offset))
+    {
+      restart = reader.offset;
+      restartLine = reader.line - 1;
+      first--;
+      break;
+    }
+    first--;
+  }
+
+  rescan state;
+  state.scan = scan;
+  state.oldEnd = oldEnd;
+  state.newEnd = newEnd;
+  state.synced = 0;
+  state.syncToken = tokens->count;
+  state.syncLine = 0;
+  seekToken(tokens, findToken(tokens, oldEnd), &state.old);
+
+  clearTokenStream(&scan->inserted);
+  scan->insertedErrorCount = 0;
+  scan->tables->errors->source = data;
+
+  // the text is scanned in growing chunks up to a line break until the tokens line up
+  dfaCursor cursor = {restart, 0, restart, restart, restart, restartLine};
+  size_t chunk = LIVE_CHUNK_SIZE;
+  while (!state.synced && cursor.position < length)
+  {
+    size_t limit = length;
+    if (length - cursor.position > chunk)
+    {
+      const char *lineBreak = memchr(data + cursor.position + chunk, '\n', length - cursor.position - chunk);
+      if (lineBreak)
+        limit = lineBreak - data;
+    }
+    dfaScanRange(&scan->language, data, length, 1, &cursor, limit, recordRescanned, &state);
+    chunk *= 2;
+  }
+
+  size_t oldSyncOffset = scan->length;
+  long long lineDelta = 0;
+  if (state.synced)
+  {
+    tokenReader sync;
+    seekToken(tokens, state.syncToken, &sync);
+    oldSyncOffset = sync.offset;
+    lineDelta = (long long)state.syncLine - (long long)sync.line;
+  }
+
+  if (edit)
+  {
+    edit->firstToken = first;
+    edit->removedTokens = state.syncToken - first;
+    edit->insertedTokens = scan->inserted.count;
+    edit->rescannedBytes = (state.synced ? oldSyncOffset + offsetDelta : length) - restart;
+  }
+
+  spliceTokens(scan, first, state.syncToken, offsetDelta, lineDelta);
+  spliceErrors(scan, restart, oldSyncOffset, offsetDelta);
+  scan->data = data;
+  scan->length = length;
+}
+
+/*
+  Gets the paradigm of the current text from its class, def and main tokens,
+  kept up to date by every edit
+
+  @scan: scan to be used
+
+  Return: name of the paradigm, empty if there is no evidence
+*/
+const char *liveParadigm(liveScan *scan)
+{
+  int oop = scan->evidence[1] > 0;
+  int pp = scan->evidence[2] > 0 || scan->evidence[3] > 0;
+  if (oop && pp)
+    return "Procedural and Object-Oriented Programming";
+  if (oop)
+    return "Object-Oriented Programming";
+  if (pp)
+    return "Procedural Programming";
+  return "";
+}
+
+/*
+  Gets the counts and the token stream of the current text
+
+  @scan: scan to be used
+  @summary: counts to be filled
+
+  Return: none
+*/
+void summarizeLiveScan(liveScan *scan, scanSummary *summary)
+{
+  summarizeScan(scan->tables, summary);
+}
+
+/*
+  Releases a scan
+
+  @scan: scan to be released
+
+  Return: none
+*/
+void freeLiveScan(liveScan *scan)
+{
+  freeScanTables(scan->tables);
+  releaseTokenStream(&scan->inserted);
+  free(scan->insertedErrors);
+  free(scan);
+}
@@ -0,0 +1,35 @@
+; keywords recognized by getWordId in scanner.c, the word list of python/tokens.py
+; regenerate with: python3 python/kwgen.py keywords.spec keywords_tables.h
+;
+; class, def and main keep the ids the parsers were written against (1-3),
+; the rest start at KEYWORD_TOKEN_BASE (tokfile.h)
+
+class       1
+def         2
+main        3
+__init__    10
+abstract    11
+break       12
+case        13
+continue    14
+do          15
+extends     16
+else        17
+elif        18
+for         19
+final       20
+interface   21
+implements  22
+if          23
+new         24
+private     25
+public      26
+return      27
+struct      28
+self        29
+switch      30
+static      31
+this        32
+virtual     33
+void        34
+while       35
@@ -0,0 +1,121 @@
+// generated by python/kwgen.py from keywords.spec, do not edit
+#ifndef KEYWORDS_TABLES_H
+#define KEYWORDS_TABLES_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#ifndef LEXGEN_TABLE
+#ifdef __cplusplus
+#define LEXGEN_TABLE constexpr
+#else
+#define LEXGEN_TABLE static const
+#endif
+#endif
+
+#define KEYWORDS_COUNT 29
+#define KEYWORDS_SLOTS 64
+#define KEYWORDS_SHORTEST 2
+#define KEYWORDS_LONGEST 10
+#define KEYWORDS_SLOT(length, first, last) \
+  (((length) + (first) * 48u + (last) * 13u) & 63u)
+
+// slot -> keyword length, 0 for empty slots
+LEXGEN_TABLE uint8_t keywordsLength[64] = {0, 0, 4, 0, 0, 0, 0, 0, 0, 0, 4, 0, 0, 6, 7, 0, 0, 10, 0, 0, 5, 4, 0, 0, 0, 0, 9, 4, 8, 6, 6, 0, 2, 5, 4, 7, 0, 2, 0, 0, 7, 0, 0, 8, 5, 3, 3, 0, 0, 3, 0, 0, 0, 4, 5, 0, 4, 8, 6, 0, 6, 0, 0, 0};
+
+// slot -> first and last byte of the keyword
+LEXGEN_TABLE uint8_t keywordsFirst[64] = {0, 0, 115, 0, 0, 0, 0, 0, 0, 0, 109, 0, 0, 112, 101, 0, 0, 105, 0, 0, 98, 101, 0, 0, 0, 0, 105, 116, 97, 115, 115, 0, 105, 102, 101, 118, 0, 100, 0, 0, 112, 0, 0, 95, 99, 102, 110, 0, 0, 100, 0, 0, 0, 99, 119, 0, 118, 99, 115, 0, 114, 0, 0, 0};
+LEXGEN_TABLE uint8_t keywordsLast[64] = {0, 0, 102, 0, 0, 0, 0, 0, 0, 0, 110, 0, 0, 99, 115, 0, 0, 115, 0, 0, 107, 101, 0, 0, 0, 0, 101, 115, 116, 99, 104, 0, 102, 108, 102, 108, 0, 111, 0, 0, 101, 0, 0, 95, 115, 114, 119, 0, 0, 102, 0, 0, 0, 101, 101, 0, 100, 101, 116, 0, 110, 0, 0, 0};
+
+// slot -> keyword and token id
+LEXGEN_TABLE char keywordsText[64][11] = {
+    "",
+    "",
+    "self",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "main",
+    "",
+    "",
+    "public",
+    "extends",
+    "",
+    "",
+    "implements",
+    "",
+    "",
+    "break",
+    "else",
+    "",
+    "",
+    "",
+    "",
+    "interface",
+    "this",
+    "abstract",
+    "static",
+    "switch",
+    "",
+    "if",
+    "final",
+    "elif",
+    "virtual",
+    "",
+    "do",
+    "",
+    "",
+    "private",
+    "",
+    "",
+    "__init__",
+    "class",
+    "for",
+    "new",
+    "",
+    "",
+    "def",
+    "",
+    "",
+    "",
+    "case",
+    "while",
+    "",
+    "void",
+    "continue",
+    "struct",
+    "",
+    "return",
+    "",
+    "",
+    ""
+};
+LEXGEN_TABLE int keywordsId[64] = {0, 0, 29, 0, 0, 0, 0, 0, 0, 0, 3, 0, 0, 26, 16, 0, 0, 22, 0, 0, 12, 17, 0, 0, 0, 0, 21, 32, 11, 31, 30, 0, 23, 20, 18, 33, 0, 15, 0, 0, 25, 0, 0, 10, 1, 19, 24, 0, 0, 2, 0, 0, 0, 13, 35, 0, 34, 14, 28, 0, 27, 0, 0, 0};
+
+/*
+  Gets the id of a keyword
+
+  @lexeme: start of the lexeme
+  @length: length of the lexeme
+
+  Return: token id, 0 if the lexeme isn't a keyword
+*/
+static inline int keywordsLookup(const char *lexeme, size_t length)
+{
+  if (length < KEYWORDS_SHORTEST || length > KEYWORDS_LONGEST)
+    return 0;
+
+  uint8_t first = (uint8_t)lexeme[0];
+  uint8_t last = (uint8_t)lexeme[length - 1];
+  unsigned slot = KEYWORDS_SLOT((unsigned)length, first, last);
+  if (keywordsLength[slot] != length || keywordsFirst[slot] != first || keywordsLast[slot] != last)
+    return 0;
+  return memcmp(lexeme, keywordsText[slot], length) ? 0 : keywordsId[slot];
+}
+
+#endif
@@ -0,0 +1,175 @@
+#ifndef LL1_H
+#define LL1_H
+
+/*
+  Table-driven LL(1) parser over the tables python/llgen.py generates from a
+  grammar file (grammar5_tables.h, py/finalcomp/grammar_tables.h)
+
+  the grammar is described by an ll1Grammar that points into the generated
+  arrays, the driver keeps its symbols on an explicit stack, so nesting depth
+  costs stack slots and not C frames, and picks every production with a single
+  predict table lookup, there is no backtracking
+  the result is exact for the grammars llgen reports without conflicts, for
+  the others every conflicting cell predicts the first alternative
+*/
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "tokenstream.h"
+
+// values shared with the generated tables (<PREFIX>_NONE, <PREFIX>_NONTERMINAL_BASE)
+#define LL1_NONE 255
+#define LL1_NONTERMINAL_BASE 128
+
+// symbols the stack holds before it moves to the heap
+#define LL1_STACK_SIZE 256
+
+// symbols the stack can hold before ll1Parse gives up, 1 MiB
+#define LL1_DEFAULT_MAX_DEPTH (1 << 20)
+
+// outcomes of ll1Parse
+#define LL1_REJECTED 0
+#define LL1_ACCEPTED 1
+// the stack would have gone past maxDepth symbols
+#define LL1_TOO_DEEP 2
+// the stack couldn't grow
+#define LL1_NO_MEMORY 3
+
+/*
+  Generated tables of a grammar
+
+  @columnOf: token id -> terminal column, all 256 ids
+  @predict: nonterminal x column -> production, rows of columns entries
+  @rhsStart: production -> first symbol in rhs, productions + 1 entries
+  @rhs: right hand sides, columns below LL1_NONTERMINAL_BASE, nonterminals
+  from it
+  @columns: terminal columns, the last one is the end of the input
+*/
+struct ll1Grammar
+{
+  const uint8_t *columnOf;
+  const uint8_t *predict;
+  const uint16_t *rhsStart;
+  const uint8_t *rhs;
+  int columns;
+};
+typedef struct ll1Grammar ll1Grammar;
+
+/*
+  Receives every production the driver expands, in leftmost derivation order
+
+  @context: pointer given to the driver
+  @production: index of the production in the generated tables
+  @position: index of the token it was predicted on
+*/
+typedef void (*ll1ProductionCallback)(void *context, int production, size_t position);
+
+/*
+  Gets the column of a token
+
+  @grammar: tables to be used
+  @tokens: tokens being parsed
+  @position: index of the token
+
+  Return: terminal column, the end column past the last token, LL1_NONE for
+  ids the grammar doesn't use
+*/
+static inline int ll1Column(const ll1Grammar *grammar, const tokenSpan *tokens, size_t position)
+{
+  return position < tokens->count ? grammar->columnOf[tokens->ids[position]] : grammar->columns - 1;
+}
+
+/*
+  Parses a token span
+
+  @grammar: tables to be used
+  @start: nonterminal the input has to derive
+  @tokens: tokens to be parsed, all of them
+  @maxDepth: symbols the stack can hold, LL1_DEFAULT_MAX_DEPTH if unsure
+  @onProduction: called on every expansion, NULL if not needed
+  @context: pointer given to onProduction
+  @errorPosition: index of the token that can't be derived, or the one the
+  parse stopped at, filled only on failure (tokens.count for a premature end)
+
+  Return: LL1_ACCEPTED if the tokens derive from start, LL1_REJECTED if not,
+  LL1_TOO_DEEP or LL1_NO_MEMORY if the parse stopped before it could tell
+*/
+static inline int ll1Parse(const ll1Grammar *grammar, int start, tokenSpan tokens, size_t maxDepth,
+                           ll1ProductionCallback onProduction, void *context, size_t *errorPosition)
+{
+  uint8_t local[LL1_STACK_SIZE];
+  uint8_t *stack = local;
+  size_t size = LL1_STACK_SIZE;
+  size_t depth = 0;
+  size_t position = 0;
+  int outcome = LL1_ACCEPTED;
+
+  stack[depth++] = (uint8_t)(LL1_NONTERMINAL_BASE + start);
+  while (depth)
+  {
+    int symbol = stack[--depth];
+    int column = ll1Column(grammar, &tokens, position);
+    if (column == LL1_NONE)
+    {
+      outcome = LL1_REJECTED;
+      break;
+    }
+
+    if (symbol < LL1_NONTERMINAL_BASE)
+    {
+      if (symbol != column)
+      {
+        outcome = LL1_REJECTED;
+        break;
+      }
+      position++;
+      continue;
+    }
+
+    int production = grammar->predict[(symbol - LL1_NONTERMINAL_BASE) * grammar->columns + column];
+    if (production == LL1_NONE)
+    {
+      outcome = LL1_REJECTED;
+      break;
+    }
+    if (onProduction)
+      onProduction(context, production, position);
+
+    size_t first = grammar->rhsStart[production];
+    size_t last = grammar->rhsStart[production + 1];
+    if (depth + (last - first) > maxDepth)
+    {
+      outcome = LL1_TOO_DEEP;
+      break;
+    }
+    if (depth + (last - first) > size)
+    {
+      size_t grown = size * 2 > depth + (last - first) ? size * 2 : depth + (last - first);
+      uint8_t *moved = (uint8_t *)(stack == local ? malloc(grown) : realloc(stack, grown));
+      if (!moved)
+      {
+        outcome = LL1_NO_MEMORY;
+        break;
+      }
+      if (stack == local)
+        memcpy(moved, local, depth);
+      stack = moved;
+      size = grown;
+    }
+    // pushed backwards so the leftmost symbol is on top
+    for (size_t i = last; i > first; i--)
+      stack[depth++] = grammar->rhs[i - 1];
+  }
+
+  if (outcome == LL1_ACCEPTED && position < tokens.count)
+    outcome = LL1_REJECTED;
+  if (outcome != LL1_ACCEPTED)
+    *errorPosition = position;
+  if (stack != local)
+    free(stack);
+  return outcome;
+}
+
+#endif
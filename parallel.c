@@ -0,0 +1,180 @@
+#include <pthread.h>
+
+/*
+  Part of the input scanned by its own thread, from one line break to the next
+  chunk's line break
+
+  @cursor: where the scan stopped
+  @synced: 1 if the next chunk can be scanned from its start in state 0
+  @lines: line breaks between begin and limit
+  @baseLine: line breaks before the offset the chunk's lines were counted from
+*/
+struct scanChunk
+{
+  const dfaLanguage *language;
+  const sourceBuffer *source;
+  int skip;
+  size_t begin;
+  size_t limit;
+  dfaCursor cursor;
+  int synced;
+  size_t lines;
+  size_t baseLine;
+  scanTables *tables;
+  pthread_t thread;
+};
+typedef struct scanChunk scanChunk;
+
+/*
+  Scans a chunk speculatively, assuming the DFA is in state 0 at its start
+
+  @argument: chunk to be scanned
+
+  Return: NULL
+*/
+void *scanChunkThread(void *argument)
+{
+  scanChunk *chunk = argument;
+  dfaCursor cursor = {chunk->begin, 0, chunk->begin, chunk->begin, chunk->begin, 0};
+  chunk->synced = dfaScanRange(chunk->language, chunk->source->data, chunk->source->length, chunk->skip,
+                               &cursor, chunk->limit, recordScanned, chunk->tables);
+  chunk->cursor = cursor;
+  chunk->lines = countLines(chunk->source->data + chunk->begin, chunk->source->data + chunk->limit);
+  return NULL;
+}
+
+/*
+  Rescans a chunk whose speculative start was wrong, going on from where the
+  previous chunk actually stopped
+
+  @chunk: chunk to be rescanned
+  @from: cursor left by the previous chunk
+
+  Return: none
+*/
+void rescanChunk(scanChunk *chunk, dfaCursor from)
+{
+  resetScanTables(chunk->tables, chunk->limit - chunk->begin);
+  attachSource(chunk->tables->errors, chunk->source->data);
+  chunk->synced = dfaScanRange(chunk->language, chunk->source->data, chunk->source->length, chunk->skip,
+                               &from, chunk->limit, recordScanned, chunk->tables);
+  chunk->cursor = from;
+}
+
+/*
+  Appends the tables of a chunk to the result
+
+  @result: tables of the whole input
+  @chunk: chunk already scanned
+
+  the chunk's symbols are interned in the result in their local order, which
+  is the order of first occurrence, so the ids match a sequential scan
+  token lines are moved by the chunk's baseLine
+
+  Return: none
+*/
+void appendChunk(scanTables *result, scanChunk *chunk)
+{
+  symbolTable *local = chunk->tables->identifiers;
+  int *remap = arenaAlloc(chunk->tables->arena, (local->position + 1) * sizeof(int));
+  for (size_t i = 0; i < local->position; i++)
+  {
+    remap[i] = internLexeme(result->identifiers, symbolName(local, i), local->entries[i].length);
+    result->identifiers->entries[remap[i]].count += local->entries[i].count - 1;
+  }
+
+  // positions are decoded in order, from each checkpoint through the deltas after it
+  tokenStream *tokens = chunk->tables->tokens;
+  size_t checkpoint = 0;
+  uint64_t offset = 0;
+  size_t line = 0;
+  for (size_t i = 0; i < tokens->count; i++)
+  {
+    if (checkpoint < tokens->checkpointCount && tokens->checkpoints[checkpoint].token == i)
+    {
+      offset = tokens->checkpoints[checkpoint].offset;
+      line = tokens->checkpoints[checkpoint].line;
+      checkpoint++;
+    }
+    else
+    {
+      offset += tokens->offsetDeltas[i];
+      line += tokens->lineDeltas[i];
+    }
+
+    int symbol = tokens->symbols[i];
+    recordToken(result->tokens, tokens->ids[i], symbol < 0 ? symbol : remap[symbol], offset, line + chunk->baseLine);
+  }
+
+  charTable *errors = chunk->tables->errors;
+  for (size_t i = 0; i < errors->position; i++)
+    recordView(result->errors, errors->views[i][0], errors->views[i][1]);
+}
+
+/*
+  Scans an input buffer with several threads
+
+  @language: descriptor of the scanner language
+  @source: input buffer
+  @skip: 1 to jump over strings and comments with findByte
+  @threads: number of chunks scanned at the same time
+  @result: tables to be filled, errors must have the source attached
+
+  the input is split at line breaks and every chunk is scanned as if the DFA
+  were in state 0 there, which holds unless the line break is inside a string or
+  a block comment
+  the chunks are then stitched in order: when the previous chunk didn't stop at
+  a resynchronization point, the chunk is rescanned from where it did stop
+  the result is identical to scanSource
+
+  Return: none
+*/
+void scanParallel(const dfaLanguage *language, const sourceBuffer *source, int skip, int threads, scanTables *result)
+{
+  scanChunk *chunks = malloc(threads * sizeof(scanChunk));
+  size_t begin = 0;
+  int count = 0;
+
+  for (int i = 0; i < threads && begin < source->length; i++)
+  {
+    size_t limit = source->length;
+    if (i < threads - 1)
+    {
+      size_t split = source->length / threads * (i + 1);
+      const char *lineBreak = split > begin ? memchr(source->data + split, '\n', source->length - split) : NULL;
+      if (lineBreak)
+        limit = lineBreak - source->data;
+    }
+
+    scanChunk *chunk = &chunks[count++];
+    chunk->language = language;
+    chunk->source = source;
+    chunk->skip = skip;
+    chunk->begin = begin;
+    chunk->limit = limit;
+    chunk->tables = initScanTables(limit - begin);
+    attachSource(chunk->tables->errors, source->data);
+    pthread_create(&chunk->thread, NULL, scanChunkThread, chunk);
+
+    begin = limit;
+  }
+
+  // line breaks before the current chunk
+  size_t lines = 0;
+  for (int i = 0; i < count; i++)
+  {
+    pthread_join(chunks[i].thread, NULL);
+    chunks[i].baseLine = lines;
+    if (i > 0 && !chunks[i - 1].synced)
+    {
+      // the rescan goes on counting lines from the previous chunk's cursor
+      rescanChunk(&chunks[i], chunks[i - 1].cursor);
+      chunks[i].baseLine = chunks[i - 1].baseLine;
+    }
+    lines += chunks[i].lines;
+    appendChunk(result, &chunks[i]);
+    freeScanTables(chunks[i].tables);
+  }
+
+  free(chunks);
+}
@@ -1,15 +1,239 @@
 #include <iostream>
 #include <vector>
 #include <string>
-#include <set>
 #include <stdexcept>
+#include <string.h>
+#include "tokfile.h"
+#include "earley.h"
+// regenerate with: python3 python/llgen.py grammar5.md grammar5_tables.h id=0,10-255 class=1 def=2 main=3 '(=4' ')=5' '{=6' '}=7' indent=8 noindent=9
+#include "grammar5_tables.h"
+
+// input the grammar doesn't derive, thrown by parse() at the position of the last mismatch
+class ParseError : public std::runtime_error
+{
+public:
+  size_t position;
+
+  ParseError(size_t position)
+      : std::runtime_error("\nerror at position " + std::to_string(position) + "\n"), position(position) {}
+
+protected:
+  ParseError(size_t position, const std::string &message) : std::runtime_error(message), position(position) {}
+};
+
+// input nested deeper than the parser was allowed to go, thrown by parse() at the position it stopped
+class NestingError : public ParseError
+{
+public:
+  size_t depth;
+
+  NestingError(size_t position, size_t depth)
+      : ParseError(position, "\nnesting deeper than " + std::to_string(depth) + " at position " +
+                                 std::to_string(position) + "\n"),
+        depth(depth)
+  {
+  }
+};
+
+// productions being parsed at once RecursiveDescentParser gives up at, 32 MiB of frames
+#define DEFAULT_MAX_DEPTH (1 << 20)
+
+// productions parsed on the C stack before the frames stack takes over, tens of KiB of it
+#ifndef NATIVE_DEPTH
+#define NATIVE_DEPTH 512
+#endif
+
+// terminals of grammar5.md and their token ids, for the grammar files read at run time
+static const std::vector<earleyTerminal> grammar5Terminals = {
+    {"id", 0}, {"class", 1}, {"def", 2}, {"main", 3}, {"(", 4}, {")", 5}, {"{", 6}, {"}", 7}, {"indent", 8}, {"noindent", 9}};
+
+// nonterminals of grammar5.md, rows of the packrat memo, numbered as in grammar5_tables.h for the frames stack
+enum nonterminal
+{
+  S = GRAMMAR5_S,
+  S_PRIME = GRAMMAR5_S_PRIME,
+  PARADIGM = GRAMMAR5_PARADIGM,
+  OOP = GRAMMAR5_OOP,
+  CLASS = GRAMMAR5_CLASS,
+  CLASSCOMPLEMENT = GRAMMAR5_CLASSCOMPLEMENT,
+  CLASSCOMPLEMENT_PRIME = GRAMMAR5_CLASSCOMPLEMENT_PRIME,
+  MAIN = GRAMMAR5_MAIN,
+  PYCLASS = GRAMMAR5_PYCLASS,
+  PYCLASS_PRIME = GRAMMAR5_PYCLASS_PRIME,
+  PYCLASS_DOUBLE_PRIME = GRAMMAR5_PYCLASS_DOUBLE_PRIME,
+  PP = GRAMMAR5_PP,
+  FUNC = GRAMMAR5_FUNC,
+  FUNC_PRIME = GRAMMAR5_FUNC_PRIME,
+  PYFUNC = GRAMMAR5_PYFUNC,
+  PYFUNC_PRIME = GRAMMAR5_PYFUNC_PRIME,
+  MIXED = GRAMMAR5_MIXED,
+  MIXEDN = GRAMMAR5_MIXEDN,
+  MIXEDCOMPLEMENT = GRAMMAR5_MIXEDCOMPLEMENT,
+  PYMIXED = GRAMMAR5_PYMIXED,
+  PYMIXEDCOMPLEMENT = GRAMMAR5_PYMIXEDCOMPLEMENT,
+  INDENTEDBLOCK = GRAMMAR5_INDENTEDBLOCK,
+  INDENTEDBLOCK_PRIME = GRAMMAR5_INDENTEDBLOCK_PRIME,
+  INDENTEDBLOCK_DOUBLE_PRIME = GRAMMAR5_INDENTEDBLOCK_DOUBLE_PRIME,
+  PYSTATEMENTS = GRAMMAR5_PYSTATEMENTS,
+  PYSTATEMENTS_PRIME = GRAMMAR5_PYSTATEMENTS_PRIME,
+  PYSTATEMENT = GRAMMAR5_PYSTATEMENT,
+  PYSTATEMENT_PRIME = GRAMMAR5_PYSTATEMENT_PRIME,
+  PYSTATEMENT_DOUBLE_PRIME = GRAMMAR5_PYSTATEMENT_DOUBLE_PRIME,
+  PYSTATEMENT_TRIPLE_PRIME = GRAMMAR5_PYSTATEMENT_TRIPLE_PRIME,
+  PYSTATEMENT_QUADRUPLE_PRIME = GRAMMAR5_PYSTATEMENT_QUADRUPLE_PRIME,
+  PYSTATEMENT_QUINTUPLE_PRIME = GRAMMAR5_PYSTATEMENT_QUINTUPLE_PRIME,
+  STATEMENTS = GRAMMAR5_STATEMENTS,
+  STATEMENTS_PRIME = GRAMMAR5_STATEMENTS_PRIME,
+  STATEMENT = GRAMMAR5_STATEMENT,
+  STATEMENT_PRIME = GRAMMAR5_STATEMENT_PRIME,
+  STATEMENT_DOUBLE_PRIME = GRAMMAR5_STATEMENT_DOUBLE_PRIME,
+  PREFIX = GRAMMAR5_PREFIX,
+  IDS = GRAMMAR5_IDS,
+  NONTERMINALS = GRAMMAR5_NONTERMINALS
+};
+
+// how the parseX() function of a nonterminal picks its alternatives, the frames stack picks them the same way
+enum choiceKind : uint8_t
+{
+  // every alternative in order, the first that matches
+  ORDERED,
+  // the one predict() gives, failing when there is none
+  PREDICTED,
+  // the one predict() gives, ε when there is none or it fails
+  PREDICTED_OR_EMPTY,
+  // a list: the items of its first production over and over, then the other alternatives in order
+  LOOPED
+};
+
+// choiceKind of every nonterminal, in step with the parseX() functions, ORDERED unless listed
+struct choiceTable
+{
+  uint8_t kind[GRAMMAR5_NONTERMINALS];
+};
+
+constexpr choiceTable parseChoices()
+{
+  choiceTable table{};
+  for (int symbol : {CLASS, MAIN, PYCLASS, PYCLASS_PRIME, FUNC, PYFUNC, INDENTEDBLOCK_PRIME, PYSTATEMENTS,
+                     PYSTATEMENT_DOUBLE_PRIME, PYSTATEMENT_TRIPLE_PRIME, PYSTATEMENT_QUADRUPLE_PRIME,
+                     PYSTATEMENT_QUINTUPLE_PRIME, PREFIX})
+    table.kind[symbol] = PREDICTED;
+  for (int symbol : {PYSTATEMENT_PRIME, STATEMENT_PRIME, STATEMENT_DOUBLE_PRIME})
+    table.kind[symbol] = PREDICTED_OR_EMPTY;
+  for (int symbol : {INDENTEDBLOCK_DOUBLE_PRIME, PYSTATEMENTS_PRIME, STATEMENTS_PRIME, IDS})
+    table.kind[symbol] = LOOPED;
+  return table;
+}
+
+// alternatives of the nonterminal that has the most
+constexpr int mostAlternatives()
+{
+  int most = 0;
+  for (int symbol = 0; symbol < GRAMMAR5_NONTERMINALS; symbol++)
+    if (grammar5FirstProduction[symbol + 1] - grammar5FirstProduction[symbol] > most)
+      most = grammar5FirstProduction[symbol + 1] - grammar5FirstProduction[symbol];
+  return most;
+}
+
+static_assert(mostAlternatives() <= 8, "the alternatives of a nonterminal are a byte of bits in RecursiveDescentParser");
+
+// index of no node, for the links of parseNode
+#define NO_PARSE_NODE UINT32_MAX
+
+/*
+  Node of a parse tree, one per nonterminal that matched, the tree is an
+  array of them in preorder: the children of a node follow it, each one right
+  after the subtree of the one before, so the subtree of a node is a range of
+  the array and the nodes of an alternative that failed are always its tail
+  the lists parseX() loops over (IDS, STATEMENTS', ...) are one node with the
+  items as children, on the frames stack too
+
+  @kind: GRAMMAR5_ index of the nonterminal, as in enum nonterminal
+  @begin: first token it matched
+  @end: one past the last token it matched, begin if it derived ε
+  @firstChild: index of its first child, NO_PARSE_NODE if it has none
+  @nextSibling: index of the next child of its parent, NO_PARSE_NODE if it is the last
+*/
+struct parseNode
+{
+  uint32_t kind;
+  uint32_t begin;
+  uint32_t end;
+  uint32_t firstChild;
+  uint32_t nextSibling;
+};
+
+// counters of a parse, lookups and hits only move in packrat mode
+struct memoStats
+{
+  size_t calls = 0;
+  size_t lookups = 0;
+  size_t hits = 0;
+  // calls cut by the left recursion guard
+  size_t recursions = 0;
+};
 
 class RecursiveDescentParser
 {
 private:
-  std::vector<int> tokens;
+  // non-owning, the scanner's stream or a mapped token file outlives the parser
+  tokenSpan tokens;
   size_t currentPos;
-  size_t initial;
+
+  /*
+    packrat memo, one entry per (nonterminal, position): MEMO_UNKNOWN,
+    MEMO_ACTIVE while the nonterminal is being parsed there, MEMO_END plus the
+    position where it ended, or MEMO_FAILED plus the position of the error
+  */
+  static constexpr uint32_t MEMO_UNKNOWN = 0;
+  static constexpr uint32_t MEMO_ACTIVE = 1;
+  static constexpr uint32_t MEMO_END = 2;
+  static constexpr uint32_t MEMO_FAILED = 0x80000000u;
+  bool packrat;
+  std::vector<uint32_t> memo;
+  memoStats stats;
+  // position of the last mismatch, what a failed entry replays
+  size_t errorPos = 0;
+  // productions being parsed on the C stack
+  size_t depth = 0;
+  // nodes of the parse tree built so far, nullptr unless parse() was given one
+  std::vector<parseNode> *tree = nullptr;
+
+  /*
+    Nonterminal being parsed, what a call to parseX() kept on its C frame
+
+    @initial: position it started at, its memo entry
+    @checkpoint: where the next alternative starts over, initial but for a
+    list, where it goes back to after its last item
+    @node: its node in the tree, the children of an alternative follow it
+    @next: symbol of the alternative or item to be matched, index in grammar5Rhs
+    @end: one past the last symbol of the alternative or item
+    @symbol: GRAMMAR5_ index of the nonterminal
+    @untried: alternatives left to try, bit i is the production
+    grammar5FirstProduction[symbol] + i
+    @stage: ALTERNATIVE, or ITEMS and AFTER_ITEMS for a LOOPED nonterminal
+  */
+  struct parseFrame
+  {
+    size_t initial;
+    size_t checkpoint;
+    uint32_t node;
+    uint16_t next;
+    uint16_t end;
+    uint16_t symbol;
+    uint16_t untried;
+    uint8_t stage;
+  };
+  static constexpr uint8_t ALTERNATIVE = 0;
+  static constexpr uint8_t ITEMS = 1;
+  static constexpr uint8_t AFTER_ITEMS = 2;
+  // heap stack of the nonterminals being parsed, the innermost last
+  std::vector<parseFrame> frames;
+  size_t maxDepth;
+  // NATIVE_DEPTH, or maxDepth when it is lower
+  size_t nativeDepth;
+
+  static constexpr choiceTable choices = parseChoices();
 
   // get current token
   int getCurrentToken()
@@ -18,913 +242,1233 @@ private:
     {
       return -1; // End of input
     }
-    return tokens[currentPos];
+    return grammarTokenId(tokens[currentPos]);
   }
 
-  // consume a token
-  void consume(int expectedTokenId)
+  // consume a token, a mismatch is recorded as the error
+  bool consume(int expectedTokenId)
   {
     int current = getCurrentToken();
     if (current != expectedTokenId)
     {
-      throw;
+      errorPos = currentPos;
+      return false;
     }
     currentPos++;
+    return true;
   }
 
-  // check if current token is in a set
-  bool isInFirstPlus(const std::set<int> &firstPlusSet)
-  {
-    int current = getCurrentToken();
-    return firstPlusSet.count(current) > 0 ||
-           (current == -1 && firstPlusSet.count(-2) > 0); // -2 represents $
-  }
+  /*
+    Picks the alternative of a nonterminal without LL(1) conflicts from the
+    current token (grammar5_tables.h), no other alternative can start there
+
+    @symbol: GRAMMAR5_ index of the nonterminal
 
-  // check for epsilon
-  bool hasEpsilon(const std::set<int> &firstPlusSet)
+    Return: index of the alternative in the production, -1 if none starts with
+    the token, which is then the error
+  */
+  int predict(int symbol)
   {
-    return firstPlusSet.count(-3) > 0; // -3 represents ε
+    int column = currentPos < tokens.size() ? grammar5ColumnOf[tokens[currentPos]] : GRAMMAR5_END;
+    int production = column == GRAMMAR5_NONE ? GRAMMAR5_NONE : grammar5Predict[symbol][column];
+    if (production == GRAMMAR5_NONE)
+    {
+      errorPos = currentPos;
+      return -1;
+    }
+    return production - grammar5FirstProduction[symbol];
   }
 
   // dealing with a grammar that breaks
   bool error(std::string paradigm)
   {
     std::cout << "At " << std::to_string(currentPos) << " tokens, the best guess is " << paradigm;
+    return false;
   }
 
-public:
-  RecursiveDescentParser(const std::vector<int> &tokens) : tokens(tokens), currentPos(0) {}
+  /*
+    Memo entry of a nonterminal that ends parsing at the current position, a
+    match is forgotten while the tree is built, replaying it wouldn't add its
+    nodes
 
-  // S -> PARADIGM S' | STATEMENTS PARADIGM S' | PYSTATEMENTS PARADIGM S'
-  void parseS()
+    @matched: whether the nonterminal matched
+
+    Return: the entry, MEMO_UNKNOWN for a forgotten match
+  */
+  uint32_t outcomeOf(bool matched)
   {
-    initial = currentPos;
+    if (!matched)
+      return (uint32_t)(MEMO_FAILED + errorPos);
+    return tree ? MEMO_UNKNOWN : (uint32_t)(currentPos + MEMO_END);
+  }
 
-    try
+  /*
+    Appends the node of a nonterminal that starts at the current position,
+    its end and links are set once it matches, out of line like endNode(),
+    the parses without a tree only pay for the test
+  */
+  __attribute__((noinline)) uint32_t openNode(int symbol)
+  {
+    tree->push_back({(uint32_t)symbol, (uint32_t)currentPos, (uint32_t)currentPos, NO_PARSE_NODE, NO_PARSE_NODE});
+    return tree->size() - 1;
+  }
+
+  /*
+    Ends the node of a nonterminal that matched, its children are the nodes
+    left after it: every child that matched linked itself to the size of the
+    tree at that point, where the next one starts, the link of the last one
+    is the size of the tree now
+
+    @node: node of the nonterminal, given by openNode()
+
+    Return: none
+  */
+  void closeNode(uint32_t node)
+  {
+    parseNode *nodes = tree->data();
+    uint32_t size = tree->size();
+    nodes[node].end = currentPos;
+    if (node + 1 < size)
+    {
+      uint32_t child = node + 1;
+      while (nodes[child].nextSibling != size)
+        child = nodes[child].nextSibling;
+      nodes[child].nextSibling = NO_PARSE_NODE;
+      nodes[node].firstChild = node + 1;
+    }
+    nodes[node].nextSibling = size;
+  }
+
+  // ends the node of a nonterminal, dropping it with its children if it failed
+  __attribute__((noinline)) void endNode(uint32_t node, bool matched)
+  {
+    if (matched)
+      closeNode(node);
+    else
+      tree->resize(node);
+  }
+
+  /*
+    Looks a nonterminal up in the packrat memo at the current position, a call
+    to one that is still being parsed there (left recursion) fails
+
+    @symbol: nonterminal about to be parsed
+    @matched: outcome to be filled when the nonterminal was parsed there before
+
+    Return: true if it was parsed there before, currentPos is then where it
+    ended or errorPos where it failed, false if it has to be parsed (always in
+    the default mode)
+  */
+  bool lookup(int symbol, bool &matched)
+  {
+    stats.calls++;
+    if (!packrat)
+      return false;
+
+    uint32_t outcome = memo[symbol * (tokens.size() + 1) + currentPos];
+    stats.lookups++;
+    if (outcome == MEMO_ACTIVE)
+    {
+      stats.recursions++;
+      errorPos = currentPos;
+      matched = false;
+      return true;
+    }
+    if (outcome == MEMO_UNKNOWN)
+      return false;
+
+    stats.hits++;
+    matched = outcome < MEMO_FAILED;
+    if (matched)
+      currentPos = outcome - MEMO_END;
+    else
+      errorPos = outcome - MEMO_FAILED;
+    return true;
+  }
+
+  /*
+    Starts a production, which is parsed on the frames stack instead once the
+    C stack is NATIVE_DEPTH productions deep, what it returns is the same
+
+    @symbol: nonterminal about to be parsed
+    @matched: outcome to be filled when the nonterminal doesn't have to be
+    parsed here
+
+    Return: true if it was parsed already, by lookup() or on the frames stack,
+    false if the production goes on with its alternatives
+  */
+  bool recall(nonterminal symbol, bool &matched)
+  {
+    if (depth >= nativeDepth)
     {
-      parsePARADIGM();
-      parseSPrime();
+      matched = run(symbol);
+      return true;
     }
-    catch (...)
+    return lookup(symbol, matched);
+  }
+
+  /*
+    Memo entry of a production being parsed, marked active until the
+    production stores its outcome, and a level of the C stack until then,
+    every parseX() returns what store() returns
+    it keeps where the production started and its node, NO_PARSE_NODE without a
+    tree, for the alternatives to start over
+  */
+  struct memoEntry
+  {
+    RecursiveDescentParser *parser;
+    uint32_t *outcome;
+    size_t initial;
+    uint32_t node;
+
+    memoEntry(RecursiveDescentParser *parser, nonterminal symbol)
+        : parser(parser), outcome(nullptr), initial(parser->currentPos), node(NO_PARSE_NODE)
     {
-      currentPos = initial;
-      try
-      {
-        parseSTATEMENTS();
-        parsePARADIGM();
-        parseSPrime();
-      }
-      catch (...)
-      {
-        currentPos = initial;
-        try
-        {
-          parsePYSTATEMENTS();
-          parsePARADIGM();
-          parseSPrime();
-        }
-        catch (...)
-        {
-          throw;
-        }
-      }
+      parser->depth++;
+      if (parser->tree)
+        node = parser->openNode(symbol);
+      if (!parser->packrat)
+        return;
+      outcome = &parser->memo[symbol * (parser->tokens.size() + 1) + parser->currentPos];
+      *outcome = MEMO_ACTIVE;
+    }
+
+    // goes back to where the production started before its next alternative, dropping the nodes since, always true
+    bool backtrack()
+    {
+      parser->currentPos = initial;
+      if (node != NO_PARSE_NODE)
+        parser->tree->resize(node + 1);
+      return true;
+    }
+
+    // records the outcome of the production and passes it on, a production that failed leaves no nodes
+    bool store(bool matched)
+    {
+      parser->depth--;
+      if (node != NO_PARSE_NODE)
+        parser->endNode(node, matched);
+      if (outcome)
+        *outcome = parser->outcomeOf(matched);
+      return matched;
     }
+  };
+
+  // goes back to the checkpoint of a list after its last item, which failed and left no nodes, always true
+  bool backtrack(size_t checkpoint)
+  {
+    currentPos = checkpoint;
+    return true;
   }
 
-  // S' -> STATEMENTS | PYSTATEMENTS | ε
-  void parseSPrime()
+  // column of the current token in grammar5_tables.h, GRAMMAR5_END past the last one
+  int currentColumn()
   {
-    initial = currentPos;
+    return currentPos < tokens.size() ? grammar5ColumnOf[tokens[currentPos]] : GRAMMAR5_END;
+  }
 
-    try
+  // consume a token of a column, what consume() does on the frames stack
+  bool consumeColumn(int column)
+  {
+    if (currentColumn() != column)
     {
-      parseSTATEMENTS();
+      errorPos = currentPos;
+      return false;
     }
-    catch (...)
-    {
-      currentPos = initial;
-      try
+    currentPos++;
+    return true;
+  }
+
+  // records the outcome of a nonterminal that started at initial and passes it on
+  bool store(int symbol, size_t initial, bool matched)
+  {
+    if (packrat)
+      memo[symbol * (tokens.size() + 1) + initial] = outcomeOf(matched);
+    return matched;
+  }
+
+  /*
+    Starts the next item of a list where the last one ended: the symbols of
+    its first production but the list at the end (IDS -> <0> IDS), or when
+    that production is the head of the list alone (STATEMENTS' -> STATEMENTS)
+    the ones of the production of the head the parseX() of the list matches
+
+    @frame: frame of the list
+
+    Return: false if the head has no alternative for the current token
+  */
+  bool startItem(parseFrame &frame)
+  {
+    frame.checkpoint = currentPos;
+    int production = grammar5FirstProduction[frame.symbol];
+    uint16_t last = grammar5RhsStart[production + 1] - 1;
+    if (grammar5Rhs[last] != GRAMMAR5_NONTERMINAL_BASE + frame.symbol)
+    {
+      int head = grammar5Rhs[grammar5RhsStart[production]] - GRAMMAR5_NONTERMINAL_BASE;
+      production = grammar5FirstProduction[head];
+      if (choices.kind[head] == PREDICTED)
       {
-        parsePYSTATEMENTS();
+        int alternative = predict(head);
+        if (alternative < 0)
+          return false;
+        production += alternative;
       }
-      catch (...)
+      last = grammar5RhsStart[production + 1] - 1;
+    }
+    frame.next = grammar5RhsStart[production];
+    frame.end = last;
+    return true;
+  }
+
+  /*
+    Starts parsing a nonterminal at the current position, what calling its
+    parseX() did: its frame is pushed unless the outcome is known already,
+    the alternative is picked as the parseX() picks it (choiceTable), with
+    predict() where it calls it, so errorPos moves at the same points
+
+    @symbol: GRAMMAR5_ index of the nonterminal
+    @matched: outcome to be filled when it is known already
+
+    Return: true if the outcome is known, from the memo or from predict(),
+    false if the frame was pushed
+  */
+  bool enter(int symbol, bool &matched)
+  {
+    if (lookup(symbol, matched))
+      return true;
+
+    int production = grammar5FirstProduction[symbol];
+    int count = grammar5FirstProduction[symbol + 1] - production;
+    // the alternatives after the first, in order
+    unsigned untried = ((1u << count) - 1) & ~1u;
+    int kind = choices.kind[symbol];
+    if (kind == PREDICTED || kind == PREDICTED_OR_EMPTY)
+    {
+      int alternative = predict(symbol);
+      int picked = production + alternative;
+      if (alternative < 0 || grammar5RhsStart[picked] == grammar5RhsStart[picked + 1])
       {
-        currentPos = initial;
-        // ε production - do nothing
+        // no alternative, or ε
+        matched = kind == PREDICTED_OR_EMPTY;
+        if (matched && tree)
+          closeNode(openNode(symbol));
+        matched = store(symbol, currentPos, matched);
+        return true;
       }
+      production = picked;
+      // ε, the last alternative, when the predicted one fails
+      untried = kind == PREDICTED_OR_EMPTY ? 1u << (count - 1) : 0;
+    }
+
+    if (depth + frames.size() >= maxDepth)
+      throw NestingError(currentPos, maxDepth);
+    if (packrat)
+      memo[symbol * (tokens.size() + 1) + currentPos] = MEMO_ACTIVE;
+    frames.push_back({currentPos, currentPos, tree ? openNode(symbol) : 0, grammar5RhsStart[production],
+                      grammar5RhsStart[production + 1], (uint16_t)symbol, (uint16_t)untried,
+                      kind == LOOPED ? ITEMS : ALTERNATIVE});
+    if (kind == LOOPED && !startItem(frames.back()) && !retry())
+    {
+      matched = leave(false);
+      return true;
     }
+    return false;
   }
 
-  // PARADIGM -> OOP | PP | MIXED
-  void parsePARADIGM()
+  /*
+    Goes back to where the innermost nonterminal started and on to its next
+    alternative, an ε alternative is one that matches right away, for a list
+    the item that failed ends the items and the list goes on from the last
+    one, which keeps their nodes
+
+    Return: true if there was one left, false if the nonterminal failed
+  */
+  bool retry()
   {
-    initial = currentPos;
+    parseFrame &frame = frames.back();
+    currentPos = frame.checkpoint;
+    if (frame.stage == ITEMS)
+      frame.stage = AFTER_ITEMS;
+    else if (tree && frame.stage == ALTERNATIVE)
+      tree->resize(frame.node + 1);
+    if (!frame.untried)
+      return false;
+    int production = grammar5FirstProduction[frame.symbol] + __builtin_ctz(frame.untried);
+    frame.untried &= frame.untried - 1;
+    frame.next = grammar5RhsStart[production];
+    frame.end = grammar5RhsStart[production + 1];
+    return true;
+  }
 
-    try
+  // pops the innermost nonterminal once it matched or ran out of alternatives
+  bool leave(bool matched)
+  {
+    parseFrame frame = frames.back();
+    frames.pop_back();
+    if (tree)
     {
-      parseOOP();
+      if (matched)
+        closeNode(frame.node);
+      else
+        tree->resize(frame.node);
     }
-    catch (...)
+    return store(frame.symbol, frame.initial, matched);
+  }
+
+  /*
+    Parses a nonterminal with the productions of grammar5_tables.h on the
+    frames stack: the alternatives are tried as the parseX() functions try
+    them, each one that fails goes back to the position the frame keeps, and
+    the lists are looped over as they loop, so the outcome, errorPos, the memo
+    and the tree are the ones the parseX() functions give, with the C stack
+    at the same depth whatever the input is
+
+    @start: GRAMMAR5_ index of the nonterminal
+
+    Return: whether it matched, currentPos is where it ended
+  */
+  bool run(int start)
+  {
+    bool matched;
+    bool known = enter(start, matched);
+    while (true)
     {
-      currentPos = initial;
-      try
-      {
-        parsePP();
-      }
-      catch (...)
+      if (known)
       {
-        currentPos = initial;
-        try
+        // outcome of the nonterminal the innermost frame called
+        if (frames.empty())
+          return matched;
+        if (matched)
+          frames.back().next++;
+        else if (!retry())
         {
-          parseMIXED();
+          matched = leave(false);
+          continue;
         }
-        catch (...)
+        known = false;
+      }
+
+      parseFrame &frame = frames.back();
+      bool failed;
+      if (frame.next == frame.end)
+      {
+        if (frame.stage != ITEMS)
         {
-          throw;
+          matched = leave(true);
+          known = true;
+          continue;
         }
+        // an item of the list matched, on to the next one
+        failed = !startItem(frame);
+      }
+      else if (grammar5Rhs[frame.next] >= GRAMMAR5_NONTERMINAL_BASE)
+      {
+        known = enter(grammar5Rhs[frame.next] - GRAMMAR5_NONTERMINAL_BASE, matched);
+        continue;
+      }
+      else
+      {
+        failed = !consumeColumn(grammar5Rhs[frame.next]);
+        if (!failed)
+          frame.next++;
+      }
+      if (failed && !retry())
+      {
+        matched = leave(false);
+        known = true;
       }
     }
   }
 
+public:
+  /*
+    @tokens: stream to be parsed
+    @packrat: memoize every nonterminal per position, linear time for
+    NONTERMINALS * (tokens + 1) entries of 4 bytes, up to 2^31 - 3 tokens
+    @maxDepth: productions being parsed at once the parser gives up at, with a
+    NestingError, past NATIVE_DEPTH they take 32 bytes of frames each
+  */
+  RecursiveDescentParser(tokenSpan tokens, bool packrat = false, size_t maxDepth = DEFAULT_MAX_DEPTH)
+      : tokens(tokens), currentPos(0), packrat(packrat), maxDepth(maxDepth),
+        nativeDepth(maxDepth < NATIVE_DEPTH ? maxDepth : NATIVE_DEPTH)
+  {
+    if (packrat)
+      memo.assign(NONTERMINALS * (tokens.size() + 1), MEMO_UNKNOWN);
+  }
+
+  /*
+    Every production returns whether it matched, the alternatives are tried in
+    order and each one that fails goes back to where the production started,
+    which its memoEntry keeps on its own frame, an ε alternative is a
+    backtrack that matches
+  */
+
+  // S -> PARADIGM S' | STATEMENTS PARADIGM S' | PYSTATEMENTS PARADIGM S'
+  bool parseS()
+  {
+    bool matched;
+    if (recall(S, matched))
+      return matched;
+    memoEntry entry(this, S);
+
+    return entry.store((parsePARADIGM() && parseSPrime()) ||
+                       (entry.backtrack() && parseSTATEMENTS() && parsePARADIGM() && parseSPrime()) ||
+                       (entry.backtrack() && parsePYSTATEMENTS() && parsePARADIGM() && parseSPrime()));
+  }
+
+  // S' -> STATEMENTS | PYSTATEMENTS | ε
+  bool parseSPrime()
+  {
+    bool matched;
+    if (recall(S_PRIME, matched))
+      return matched;
+    memoEntry entry(this, S_PRIME);
+
+    return entry.store(parseSTATEMENTS() ||
+                       (entry.backtrack() && parsePYSTATEMENTS()) ||
+                       entry.backtrack());
+  }
+
+  // PARADIGM -> OOP | PP | MIXED
+  bool parsePARADIGM()
+  {
+    bool matched;
+    if (recall(PARADIGM, matched))
+      return matched;
+    memoEntry entry(this, PARADIGM);
+
+    return entry.store(parseOOP() ||
+                       (entry.backtrack() && parsePP()) ||
+                       (entry.backtrack() && parseMIXED()));
+  }
+
   // OOP -> PYCLASS | CLASS
-  void parseOOP()
+  bool parseOOP()
   {
-    initial = currentPos;
+    bool matched;
+    if (recall(OOP, matched))
+      return matched;
+    memoEntry entry(this, OOP);
 
-    try
-    {
-      parsePYCLASS();
-    }
-    catch (...)
-    {
-      currentPos = initial;
-      try
-      {
-        parseCLASS();
-      }
-      catch (...)
-      {
-        throw;
-      }
-    }
+    return entry.store(parsePYCLASS() ||
+                       (entry.backtrack() && parseCLASS()));
   }
 
   // CLASS -> PREFIX CLASSCOMPLEMENT | CLASSCOMPLEMENT
-  void parseCLASS()
+  bool parseCLASS()
   {
-    initial = currentPos;
+    bool matched;
+    if (recall(CLASS, matched))
+      return matched;
+    memoEntry entry(this, CLASS);
 
-    try
-    {
-      parsePREFIX();
-      parseCLASSCOMPLEMENT();
-    }
-    catch (...)
+    switch (predict(GRAMMAR5_CLASS))
     {
-      currentPos = initial;
-      try
-      {
-        parseCLASSCOMPLEMENT();
-      }
-      catch (...)
-      {
-        throw;
-      }
+    case 0:
+      return entry.store(parsePREFIX() && parseCLASSCOMPLEMENT());
+    case 1:
+      return entry.store(parseCLASSCOMPLEMENT());
     }
+    return entry.store(false);
   }
 
   // CLASSCOMPLEMENT -> IDS <1> IDS <6> STATEMENTS <7> CLASSCOMPLEMENT'
-  void parseCLASSCOMPLEMENT()
+  bool parseCLASSCOMPLEMENT()
   {
-    parseIDS();
-    consume(1);
-    parseIDS();
-    consume(6);
-    parseSTATEMENTS();
-    consume(7);
-    parseCLASSCOMPLEMENTPrime();
+    bool matched;
+    if (recall(CLASSCOMPLEMENT, matched))
+      return matched;
+    memoEntry entry(this, CLASSCOMPLEMENT);
+
+    return entry.store(parseIDS() && consume(1) && parseIDS() && consume(6) && parseSTATEMENTS() && consume(7) &&
+                       parseCLASSCOMPLEMENTPrime());
   }
 
   // CLASSCOMPLEMENT' -> MAIN | STATEMENTS CLASS | ε
-  void parseCLASSCOMPLEMENTPrime()
+  bool parseCLASSCOMPLEMENTPrime()
   {
-    initial = currentPos;
-
-    try
-    {
-      parseMAIN();
-    }
-    catch (...)
-    {
-      currentPos = initial;
-      try
-      {
-        parseSTATEMENTS();
-        parseCLASS();
-      }
-      catch (...)
-      {
-        // ε production - do nothing
-        currentPos = initial;
-      }
-    }
+    bool matched;
+    if (recall(CLASSCOMPLEMENT_PRIME, matched))
+      return matched;
+    memoEntry entry(this, CLASSCOMPLEMENT_PRIME);
+
+    return entry.store(parseMAIN() ||
+                       (entry.backtrack() && parseSTATEMENTS() && parseCLASS()) ||
+                       entry.backtrack());
   }
 
   // MAIN -> PREFIX IDS <3> <4> IDS <5> <6> STATEMENTS <7> | IDS <3> <4> IDS <5> <6> STATEMENTS <7>
-  void parseMAIN()
+  bool parseMAIN()
   {
-    initial = currentPos;
+    bool matched;
+    if (recall(MAIN, matched))
+      return matched;
+    memoEntry entry(this, MAIN);
 
-    try
+    switch (predict(GRAMMAR5_MAIN))
     {
-      parsePREFIX();
-      parseIDS();
-      consume(3);
-      consume(4);
-      parseIDS();
-      consume(5);
-      consume(6);
-      parseSTATEMENTS();
-      consume(7);
-    }
-    catch (...)
-    {
-      currentPos = initial;
-      try
-      {
-        parseIDS();
-        consume(3);
-        consume(4);
-        parseIDS();
-        consume(5);
-        consume(6);
-        parseSTATEMENTS();
-        consume(7);
-      }
-      catch (...)
-      {
-        throw;
-      }
+    case 0:
+      return entry.store(parsePREFIX() && parseIDS() && consume(3) && consume(4) && parseIDS() && consume(5) &&
+                         consume(6) && parseSTATEMENTS() && consume(7));
+    case 1:
+      return entry.store(parseIDS() && consume(3) && consume(4) && parseIDS() && consume(5) && consume(6) &&
+                         parseSTATEMENTS() && consume(7));
     }
+    return entry.store(false);
   }
 
   // PYCLASS -> <9> <1> IDS PYCLASS' PYCLASS'' | <1> IDS PYCLASS' PYCLASS''
-  void parsePYCLASS()
+  bool parsePYCLASS()
   {
-    initial = currentPos;
-    try
-    {
-      consume(9);
-      consume(1);
-      parseIDS();
-      parsePYCLASSPrime();
-      parsePYCLASSDoublePrime();
-    }
-    catch (...)
+    bool matched;
+    if (recall(PYCLASS, matched))
+      return matched;
+    memoEntry entry(this, PYCLASS);
+
+    switch (predict(GRAMMAR5_PYCLASS))
     {
-      currentPos = initial;
-      try
-      {
-        consume(1);
-        parseIDS();
-        parsePYCLASSPrime();
-        parsePYCLASSDoublePrime();
-      }
-      catch (...)
-      {
-        throw;
-      }
+    case 0:
+      return entry.store(consume(9) && consume(1) && parseIDS() && parsePYCLASSPrime() &&
+                         parsePYCLASSDoublePrime());
+    case 1:
+      return entry.store(consume(1) && parseIDS() && parsePYCLASSPrime() && parsePYCLASSDoublePrime());
     }
+    return entry.store(false);
   }
 
   // PYCLASS' -> INDENTEDBLOCK | <4> IDS <5> INDENTEDBLOCK
-  void parsePYCLASSPrime()
+  bool parsePYCLASSPrime()
   {
-    initial = currentPos;
+    bool matched;
+    if (recall(PYCLASS_PRIME, matched))
+      return matched;
+    memoEntry entry(this, PYCLASS_PRIME);
 
-    try
+    switch (predict(GRAMMAR5_PYCLASS_PRIME))
     {
-      parseINDENTEDBLOCK();
-    }
-    catch (...)
-    {
-      currentPos = initial;
-      try
-      {
-        consume(4);
-        parseIDS();
-        consume(5);
-        parseINDENTEDBLOCK();
-      }
-      catch (...)
-      {
-        throw;
-      }
+    case 0:
+      return entry.store(parseINDENTEDBLOCK());
+    case 1:
+      return entry.store(consume(4) && parseIDS() && consume(5) && parseINDENTEDBLOCK());
     }
+    return entry.store(false);
   }
 
   // PYCLASS'' -> PYSTATEMENTS PYCLASS | ε
-  void parsePYCLASSDoublePrime()
+  bool parsePYCLASSDoublePrime()
   {
-    initial = currentPos;
+    bool matched;
+    if (recall(PYCLASS_DOUBLE_PRIME, matched))
+      return matched;
+    memoEntry entry(this, PYCLASS_DOUBLE_PRIME);
 
-    try
-    {
-      parsePYSTATEMENTS();
-      parsePYCLASS();
-    }
-    catch (...)
-    {
-      // ε production - do nothing
-      currentPos = initial;
-    }
+    return entry.store((parsePYSTATEMENTS() && parsePYCLASS()) ||
+                       entry.backtrack());
   }
 
   // PP -> PYFUNC | FUNC
-  void parsePP()
+  bool parsePP()
   {
-    initial = currentPos;
+    bool matched;
+    if (recall(PP, matched))
+      return matched;
+    memoEntry entry(this, PP);
 
-    try
-    {
-      parsePYFUNC();
-    }
-    catch (...)
-    {
-      currentPos = initial;
-      try
-      {
-        parseFUNC();
-      }
-      catch (...)
-      {
-        throw;
-      }
-    }
+    return entry.store(parsePYFUNC() ||
+                       (entry.backtrack() && parseFUNC()));
   }
 
   // FUNC -> <0> IDS <4> IDS <5> <6> STATEMENTS <7> FUNC' | PREFIX <0> IDS <4> IDS <5> <6> STATEMENTS <7> FUNC'
-  void parseFUNC()
+  bool parseFUNC()
   {
-    initial = currentPos;
+    bool matched;
+    if (recall(FUNC, matched))
+      return matched;
+    memoEntry entry(this, FUNC);
 
-    try
+    switch (predict(GRAMMAR5_FUNC))
     {
-      parseFUNCPrime();
-    }
-    catch (...)
-    {
-      currentPos = initial;
-      try
-      {
-        parseFUNCPrime();
-      }
-      catch (...)
-      {
-        throw;
-      }
+    case 0:
+      return entry.store(consume(0) && parseIDS() && consume(4) && parseIDS() && consume(5) && consume(6) &&
+                         parseSTATEMENTS() && consume(7) && parseFUNCPrime());
+    case 1:
+      return entry.store(parsePREFIX() && consume(0) && parseIDS() && consume(4) && parseIDS() && consume(5) &&
+                         consume(6) && parseSTATEMENTS() && consume(7) && parseFUNCPrime());
     }
+    return entry.store(false);
   }
 
   // FUNC' -> STATEMENTS FUNC | ε
-  void parseFUNCPrime()
+  bool parseFUNCPrime()
   {
-    initial = currentPos;
+    bool matched;
+    if (recall(FUNC_PRIME, matched))
+      return matched;
+    memoEntry entry(this, FUNC_PRIME);
 
-    try
-    {
-      parseFUNC();
-    }
-    catch (...)
-    {
-      currentPos = initial;
-    }
+    return entry.store((parseSTATEMENTS() && parseFUNC()) ||
+                       entry.backtrack());
   }
 
   // PYFUNC -> <2> IDS <4> IDS <5> INDENTEDBLOCK PYFUNC' | <9> <2> <3> <4> IDS <5> INDENTEDBLOCK PYFUNC'
-  void parsePYFUNC()
+  bool parsePYFUNC()
   {
-    initial = currentPos;
+    bool matched;
+    if (recall(PYFUNC, matched))
+      return matched;
+    memoEntry entry(this, PYFUNC);
 
-    try
+    switch (predict(GRAMMAR5_PYFUNC))
     {
-      parsePYFUNCPrime();
-    }
-    catch (...)
-    {
-      currentPos = initial;
-      try
-      {
-        parsePYFUNCPrime();
-      }
-      catch (...)
-      {
-        throw;
-      }
+    case 0:
+      return entry.store(consume(2) && parseIDS() && consume(4) && parseIDS() && consume(5) &&
+                         parseINDENTEDBLOCK() && parsePYFUNCPrime());
+    case 1:
+      return entry.store(consume(9) && consume(2) && consume(3) && consume(4) && parseIDS() && consume(5) &&
+                         parseINDENTEDBLOCK() && parsePYFUNCPrime());
     }
+    return entry.store(false);
   }
 
   // PYFUNC' -> PYSTATEMENTS PYFUNC | ε
-  void parsePYFUNCPrime()
+  bool parsePYFUNCPrime()
   {
-    initial = currentPos;
+    bool matched;
+    if (recall(PYFUNC_PRIME, matched))
+      return matched;
+    memoEntry entry(this, PYFUNC_PRIME);
 
-    try
-    {
-      parsePYFUNC();
-    }
-    catch (...)
-    {
-      currentPos = initial;
-    }
+    return entry.store((parsePYSTATEMENTS() && parsePYFUNC()) ||
+                       entry.backtrack());
   }
 
   // MIXED -> PYMIXED | MIXEDN
-  void parseMIXED()
+  bool parseMIXED()
   {
-    initial = currentPos;
+    bool matched;
+    if (recall(MIXED, matched))
+      return matched;
+    memoEntry entry(this, MIXED);
 
-    try
-    {
-      parsePYMIXED();
-    }
-    catch (...)
-    {
-      currentPos = initial;
-      try
-      {
-        parseMIXEDN();
-      }
-      catch (...)
-      {
-        throw;
-      }
-    }
+    return entry.store(parsePYMIXED() ||
+                       (entry.backtrack() && parseMIXEDN()));
   }
 
   // MIXEDN -> CLASS FUNC MIXEDCOMPLEMENT | FUNC CLASS MIXEDCOMPLEMENT
-  void parseMIXEDN()
+  bool parseMIXEDN()
   {
-    initial = currentPos;
+    bool matched;
+    if (recall(MIXEDN, matched))
+      return matched;
+    memoEntry entry(this, MIXEDN);
 
-    try
-    {
-      parseMIXEDCOMPLEMENT();
-    }
-    catch (...)
-    {
-      currentPos = initial;
-      try
-      {
-        parseMIXEDCOMPLEMENT();
-      }
-      catch (...)
-      {
-        throw;
-      }
-    }
+    return entry.store((parseCLASS() && parseFUNC() && parseMIXEDCOMPLEMENT()) ||
+                       (entry.backtrack() && parseFUNC() && parseCLASS() && parseMIXEDCOMPLEMENT()));
   }
 
   // MIXEDCOMPLEMENT -> CLASS | FUNC | MIXEDN | MAIN | ε
-  void parseMIXEDCOMPLEMENT()
+  bool parseMIXEDCOMPLEMENT()
   {
-    initial = currentPos;
-
-    try
-    {
-      parseCLASS();
-    }
-    catch (...)
-    {
-      currentPos = initial;
-      try
-      {
-        parseFUNC();
-      }
-      catch (...)
-      {
-        currentPos = initial;
-        try
-        {
-          parseMIXEDN();
-        }
-        catch (...)
-        {
-          currentPos = initial;
-          try
-          {
-            parseMAIN();
-          }
-          catch (...)
-          {
-            currentPos = initial;
-          }
-        }
-      }
-    }
+    bool matched;
+    if (recall(MIXEDCOMPLEMENT, matched))
+      return matched;
+    memoEntry entry(this, MIXEDCOMPLEMENT);
+
+    return entry.store(parseCLASS() ||
+                       (entry.backtrack() && parseFUNC()) ||
+                       (entry.backtrack() && parseMIXEDN()) ||
+                       (entry.backtrack() && parseMAIN()) ||
+                       entry.backtrack());
   }
 
   // PYMIXED -> PYCLASS PYFUNC PYMIXEDCOMPLEMENT | PYFUNC PYCLASS PYMIXEDCOMPLEMENT
-  void parsePYMIXED()
+  bool parsePYMIXED()
   {
-    initial = currentPos;
+    bool matched;
+    if (recall(PYMIXED, matched))
+      return matched;
+    memoEntry entry(this, PYMIXED);
 
-    try
-    {
-      parsePYMIXEDCOMPLEMENT();
-    }
-    catch (...)
-    {
-      currentPos = initial;
-      try
-      {
-        parsePYMIXEDCOMPLEMENT();
-      }
-      catch (...)
-      {
-        throw;
-      }
-    }
+    return entry.store((parsePYCLASS() && parsePYFUNC() && parsePYMIXEDCOMPLEMENT()) ||
+                       (entry.backtrack() && parsePYFUNC() && parsePYCLASS() && parsePYMIXEDCOMPLEMENT()));
   }
 
   // PYMIXEDCOMPLEMENT -> PYCLASS | PYFUNC | PYMIXED | ε
-  void parsePYMIXEDCOMPLEMENT()
+  bool parsePYMIXEDCOMPLEMENT()
   {
-    initial = currentPos;
-
-    try
-    {
-      parsePYCLASS();
-    }
-    catch (...)
-    {
-      currentPos = initial;
-      try
-      {
-        parsePYFUNC();
-      }
-      catch (...)
-      {
-        currentPos = initial;
-        try
-        {
-          parsePYMIXED();
-        }
-        catch (...)
-        {
-          currentPos = initial;
-        }
-      }
-    }
+    bool matched;
+    if (recall(PYMIXEDCOMPLEMENT, matched))
+      return matched;
+    memoEntry entry(this, PYMIXEDCOMPLEMENT);
+
+    return entry.store(parsePYCLASS() ||
+                       (entry.backtrack() && parsePYFUNC()) ||
+                       (entry.backtrack() && parsePYMIXED()) ||
+                       entry.backtrack());
   }
 
   // INDENTEDBLOCK -> <8> INDENTEDBLOCK' INDENTEDBLOCK''
-  void parseINDENTEDBLOCK()
+  bool parseINDENTEDBLOCK()
   {
-    consume(8);
-    parseINDENTEDBLOCKPrime();
-    parseINDENTEDBLOCKDoublePrime();
+    bool matched;
+    if (recall(INDENTEDBLOCK, matched))
+      return matched;
+    memoEntry entry(this, INDENTEDBLOCK);
+
+    return entry.store(consume(8) && parseINDENTEDBLOCKPrime() && parseINDENTEDBLOCKDoublePrime());
   }
 
   // INDENTEDBLOCK' -> PYSTATEMENT | <2> IDS <4> IDS <5>
-  void parseINDENTEDBLOCKPrime()
+  bool parseINDENTEDBLOCKPrime()
   {
-    initial = currentPos;
+    bool matched;
+    if (recall(INDENTEDBLOCK_PRIME, matched))
+      return matched;
+    memoEntry entry(this, INDENTEDBLOCK_PRIME);
 
-    try
+    switch (predict(GRAMMAR5_INDENTEDBLOCK_PRIME))
     {
-      parsePYSTATEMENT();
-    }
-    catch (...)
-    {
-      currentPos = initial;
-      try
-      {
-        consume(5);
-      }
-      catch (...)
-      {
-        throw;
-      }
+    case 0:
+      return entry.store(parsePYSTATEMENT());
+    case 1:
+      return entry.store(consume(2) && parseIDS() && consume(4) && parseIDS() && consume(5));
     }
+    return entry.store(false);
   }
 
   // INDENTEDBLOCK'' -> INDENTEDBLOCK | ε
-  void parseINDENTEDBLOCKDoublePrime()
+  bool parseINDENTEDBLOCKDoublePrime()
   {
-    initial = currentPos;
-
-    try
-    {
-      parseINDENTEDBLOCK();
-    }
-    catch (...)
-    {
-      currentPos = initial;
-    }
+    bool matched;
+    if (recall(INDENTEDBLOCK_DOUBLE_PRIME, matched))
+      return matched;
+    memoEntry entry(this, INDENTEDBLOCK_DOUBLE_PRIME);
+    size_t initial = currentPos;
+
+    // INDENTEDBLOCK'' matches whatever follows the INDENTEDBLOCK' of INDENTEDBLOCK, a loop instead of a frame per line
+    while (consume(8) && parseINDENTEDBLOCKPrime())
+      initial = currentPos;
+    return entry.store(backtrack(initial));
   }
 
   // PYSTATEMENTS -> PYSTATEMENT PYSTATEMENTS' | <9> PYSTATEMENT PYSTATEMENTS'
-  void parsePYSTATEMENTS()
+  bool parsePYSTATEMENTS()
   {
-    initial = currentPos;
+    bool matched;
+    if (recall(PYSTATEMENTS, matched))
+      return matched;
+    memoEntry entry(this, PYSTATEMENTS);
 
-    try
-    {
-      parsePYSTATEMENTSPrime();
-    }
-    catch (...)
+    return entry.store(parsePYSTATEMENTSHead() && parsePYSTATEMENTSPrime());
+  }
+
+  // what both alternatives of PYSTATEMENTS match before PYSTATEMENTS'
+  bool parsePYSTATEMENTSHead()
+  {
+    switch (predict(GRAMMAR5_PYSTATEMENTS))
     {
-      currentPos = initial;
-      try
-      {
-        parsePYSTATEMENTSPrime();
-      }
-      catch (...)
-      {
-        throw;
-      }
+    case 0:
+      return parsePYSTATEMENT();
+    case 1:
+      return consume(9) && parsePYSTATEMENT();
     }
+    return false;
   }
 
   // PYSTATEMENTS' -> PYSTATEMENTS | INDENTEDBLOCK | ε
-  void parsePYSTATEMENTSPrime()
+  bool parsePYSTATEMENTSPrime()
   {
-    initial = currentPos;
-
-    try
-    {
-      parsePYSTATEMENTS();
-    }
-    catch (...)
-    {
-      currentPos = initial;
-      try
-      {
-        parseINDENTEDBLOCK();
-      }
-      catch (...)
-      {
-        currentPos = initial;
-      }
-    }
+    bool matched;
+    if (recall(PYSTATEMENTS_PRIME, matched))
+      return matched;
+    memoEntry entry(this, PYSTATEMENTS_PRIME);
+    size_t initial = currentPos;
+
+    // PYSTATEMENTS' matches whatever follows the head of PYSTATEMENTS, a loop instead of a frame per statement
+    while (parsePYSTATEMENTSHead())
+      initial = currentPos;
+    return entry.store((backtrack(initial) && parseINDENTEDBLOCK()) ||
+                       backtrack(initial));
   }
 
   // PYSTATEMENT -> <0> IDS PYSTATEMENT'
-  void parsePYSTATEMENT()
+  bool parsePYSTATEMENT()
   {
-    consume(0);
-    parseIDS();
-    parsePYSTATEMENTPrime();
+    bool matched;
+    if (recall(PYSTATEMENT, matched))
+      return matched;
+    memoEntry entry(this, PYSTATEMENT);
+
+    return entry.store(consume(0) && parseIDS() && parsePYSTATEMENTPrime());
   }
 
   // PYSTATEMENT' -> <4> PYSTATEMENT'' | <6> PYSTATEMENT''' | ε
-  void parsePYSTATEMENTPrime()
+  bool parsePYSTATEMENTPrime()
   {
-    initial = currentPos;
+    bool matched;
+    if (recall(PYSTATEMENT_PRIME, matched))
+      return matched;
+    memoEntry entry(this, PYSTATEMENT_PRIME);
 
-    try
+    switch (predict(GRAMMAR5_PYSTATEMENT_PRIME))
     {
-      parsePYSTATEMENTDoublePrime();
-    }
-    catch (...)
-    {
-      currentPos = initial;
-      try
-      {
-        parsePYSTATEMENTTriplePrime();
-      }
-      catch (...)
-      {
-        currentPos = initial;
-      }
+    case 0:
+      return entry.store((consume(4) && parsePYSTATEMENTDoublePrime()) || entry.backtrack());
+    case 1:
+      return entry.store((consume(6) && parsePYSTATEMENTTriplePrime()) || entry.backtrack());
     }
+    // ε, and the tokens no alternative starts with
+    return entry.store(entry.backtrack());
   }
 
   // PYSTATEMENT'' -> IDS <5> | INDENTEDBLOCK PYSTATEMENT''''
-  void parsePYSTATEMENTDoublePrime()
+  bool parsePYSTATEMENTDoublePrime()
   {
-    initial = currentPos;
+    bool matched;
+    if (recall(PYSTATEMENT_DOUBLE_PRIME, matched))
+      return matched;
+    memoEntry entry(this, PYSTATEMENT_DOUBLE_PRIME);
 
-    try
+    switch (predict(GRAMMAR5_PYSTATEMENT_DOUBLE_PRIME))
     {
-      consume(5);
-    }
-    catch (...)
-    {
-      currentPos = initial;
-      try
-      {
-        parsePYSTATEMENTQuadruplePrime();
-      }
-      catch (...)
-      {
-        throw;
-      }
+    case 0:
+      return entry.store(parseIDS() && consume(5));
+    case 1:
+      return entry.store(parseINDENTEDBLOCK() && parsePYSTATEMENTQuadruplePrime());
     }
+    return entry.store(false);
   }
 
   // PYSTATEMENT''' -> IDS <7> | INDENTEDBLOCK PYSTATEMENT'''''
-  void parsePYSTATEMENTTriplePrime()
+  bool parsePYSTATEMENTTriplePrime()
   {
-    initial = currentPos;
+    bool matched;
+    if (recall(PYSTATEMENT_TRIPLE_PRIME, matched))
+      return matched;
+    memoEntry entry(this, PYSTATEMENT_TRIPLE_PRIME);
 
-    try
+    switch (predict(GRAMMAR5_PYSTATEMENT_TRIPLE_PRIME))
     {
-      consume(7);
-    }
-    catch (...)
-    {
-      currentPos = initial;
-      try
-      {
-        parsePYSTATEMENTQuintuplePrime();
-      }
-      catch (...)
-      {
-        currentPos = initial;
-      }
+    case 0:
+      return entry.store(parseIDS() && consume(7));
+    case 1:
+      return entry.store(parseINDENTEDBLOCK() && parsePYSTATEMENTQuintuplePrime());
     }
+    return entry.store(false);
   }
 
   // PYSTATEMENT'''' -> <5> | <8> <5>
-  void parsePYSTATEMENTQuadruplePrime()
+  bool parsePYSTATEMENTQuadruplePrime()
   {
-    initial = currentPos;
+    bool matched;
+    if (recall(PYSTATEMENT_QUADRUPLE_PRIME, matched))
+      return matched;
+    memoEntry entry(this, PYSTATEMENT_QUADRUPLE_PRIME);
 
-    try
+    switch (predict(GRAMMAR5_PYSTATEMENT_QUADRUPLE_PRIME))
     {
-      consume(5);
-    }
-    catch (...)
-    {
-      currentPos = initial;
-      try
-      {
-        consume(5);
-      }
-      catch (...)
-      {
-        currentPos = initial;
-        throw;
-      }
+    case 0:
+      return entry.store(consume(5));
+    case 1:
+      return entry.store(consume(8) && consume(5));
     }
+    return entry.store(false);
   }
 
   // PYSTATEMENT''''' -> <7> | <8> <7>
-  void parsePYSTATEMENTQuintuplePrime()
+  bool parsePYSTATEMENTQuintuplePrime()
   {
-    initial = currentPos;
+    bool matched;
+    if (recall(PYSTATEMENT_QUINTUPLE_PRIME, matched))
+      return matched;
+    memoEntry entry(this, PYSTATEMENT_QUINTUPLE_PRIME);
 
-    try
-    {
-      consume(7);
-    }
-    catch (...)
+    switch (predict(GRAMMAR5_PYSTATEMENT_QUINTUPLE_PRIME))
     {
-      currentPos = initial;
-      try
-      {
-        consume(7);
-      }
-      catch (...)
-      {
-        currentPos = initial;
-        throw;
-      }
+    case 0:
+      return entry.store(consume(7));
+    case 1:
+      return entry.store(consume(8) && consume(7));
     }
+    return entry.store(false);
   }
 
   // STATEMENTS -> STATEMENT STATEMENTS'
-  void parseSTATEMENTS()
+  bool parseSTATEMENTS()
   {
-    parseSTATEMENT();
-    parseSTATEMENTSPrime();
+    bool matched;
+    if (recall(STATEMENTS, matched))
+      return matched;
+    memoEntry entry(this, STATEMENTS);
+
+    return entry.store(parseSTATEMENT() && parseSTATEMENTSPrime());
   }
 
   // STATEMENTS' -> STATEMENTS | ε
-  void parseSTATEMENTSPrime()
+  bool parseSTATEMENTSPrime()
   {
-    initial = currentPos;
-
-    try
-    {
-      parseSTATEMENTS();
-    }
-    catch (...)
-    {
-      currentPos = initial;
-    }
+    bool matched;
+    if (recall(STATEMENTS_PRIME, matched))
+      return matched;
+    memoEntry entry(this, STATEMENTS_PRIME);
+    size_t initial = currentPos;
+
+    // STATEMENTS' matches whatever follows the STATEMENT of STATEMENTS, a loop instead of a frame per statement
+    while (parseSTATEMENT())
+      initial = currentPos;
+    return entry.store(backtrack(initial));
   }
 
   // STATEMENT -> PREFIX IDS STATEMENT'
-  void parseSTATEMENT()
+  bool parseSTATEMENT()
   {
-    parsePREFIX();
-    parseIDS();
-    parseSTATEMENTPrime();
+    bool matched;
+    if (recall(STATEMENT, matched))
+      return matched;
+    memoEntry entry(this, STATEMENT);
+
+    return entry.store(parsePREFIX() && parseIDS() && parseSTATEMENTPrime());
   }
 
   // STATEMENT' -> <4> STATEMENTS <5> STATEMENT'' | <6> STATEMENTS <7> | ε
-  void parseSTATEMENTPrime()
+  bool parseSTATEMENTPrime()
   {
-    initial = currentPos;
+    bool matched;
+    if (recall(STATEMENT_PRIME, matched))
+      return matched;
+    memoEntry entry(this, STATEMENT_PRIME);
 
-    try
+    switch (predict(GRAMMAR5_STATEMENT_PRIME))
     {
-      parseSTATEMENTDoublePrime();
-    }
-    catch (...)
-    {
-      currentPos = initial;
-      try
-      {
-        consume(7);
-      }
-      catch (...)
-      {
-        currentPos = initial;
-      }
+    case 0:
+      return entry.store((consume(4) && parseSTATEMENTS() && consume(5) &&
+                          parseSTATEMENTDoublePrime()) || entry.backtrack());
+    case 1:
+      return entry.store((consume(6) && parseSTATEMENTS() && consume(7)) || entry.backtrack());
     }
+    // ε, and the tokens no alternative starts with
+    return entry.store(entry.backtrack());
   }
 
   // STATEMENT'' -> <6> STATEMENTS <7> | ε
-  void parseSTATEMENTDoublePrime()
+  bool parseSTATEMENTDoublePrime()
   {
-    initial = currentPos;
+    bool matched;
+    if (recall(STATEMENT_DOUBLE_PRIME, matched))
+      return matched;
+    memoEntry entry(this, STATEMENT_DOUBLE_PRIME);
 
-    try
-    {
-      consume(7);
-    }
-    catch (...)
+    switch (predict(GRAMMAR5_STATEMENT_DOUBLE_PRIME))
     {
-      throw;
+    case 0:
+      return entry.store((consume(6) && parseSTATEMENTS() && consume(7)) || entry.backtrack());
     }
+    // ε, and the tokens no alternative starts with
+    return entry.store(entry.backtrack());
   }
 
   // PREFIX -> <8> | <9>
-  void parsePREFIX()
+  bool parsePREFIX()
   {
-    initial = currentPos;
+    bool matched;
+    if (recall(PREFIX, matched))
+      return matched;
+    memoEntry entry(this, PREFIX);
 
-    try
+    switch (predict(GRAMMAR5_PREFIX))
     {
-      consume(8);
-    }
-    catch (...)
-    {
-      currentPos = initial;
-      try
-      {
-        consume(9);
-      }
-      catch (...)
-      {
-        throw;
-      }
+    case 0:
+      return entry.store(consume(8));
+    case 1:
+      return entry.store(consume(9));
     }
+    return entry.store(false);
   }
 
   // IDS -> <0> IDS | ε
-  void parseIDS()
+  bool parseIDS()
   {
-    initial = currentPos;
+    bool matched;
+    if (recall(IDS, matched))
+      return matched;
+    memoEntry entry(this, IDS);
+
+    // the IDS after <0> matches whatever follows, a loop instead of a frame per id
+    while (consume(0))
+      ;
+    return entry.store(true);
+  }
 
+  /*
+    Main parse function, throws the error of the last alternative that failed
+
+    @tree: optional array for the parse tree, cleared first and filled with
+    the derivation, the root S first, left empty if the parse throws, it
+    keeps its capacity, so a caller that reuses it doesn't allocate once it
+    is big enough, up to 2^32 - 2 tokens and nodes
+    in packrat mode only the failures are memoized then, the time is no
+    longer linear
+  */
+  void parse(std::vector<parseNode> *tree = nullptr)
+  {
+    this->tree = tree;
+    if (tree)
+      tree->clear();
+    bool matched;
     try
     {
-      parseIDS();
+      matched = parseS();
     }
-    catch (...)
+    catch (const NestingError &)
     {
-      currentPos = initial;
+      // the nonterminals it unwound through left their nodes open
+      if (tree)
+        tree->clear();
+      throw;
+    }
+    if (!matched)
+    {
+      throw ParseError(errorPos);
     }
-  }
-
-  // Main parse function
-  void parse()
-  {
-    parseS();
     if (currentPos < tokens.size())
     {
-      throw;
+      if (tree)
+        tree->clear();
+      throw ParseError(currentPos);
     }
+    if (tree)
+      (*tree)[0].nextSibling = NO_PARSE_NODE;
+  }
+
+  // calls and memo hits of the parses so far
+  const memoStats &getMemoStats()
+  {
+    return stats;
   }
 };
 
+#ifndef PARSER100_NO_MAIN
+/*
+  Prints a parse tree, a nonterminal and the tokens it matched per line,
+  indented by depth, the stack of nodes left to print is on the heap
+
+  @tree: nodes filled by RecursiveDescentParser::parse()
+
+  Return: none
+*/
+void printParseTree(const std::vector<parseNode> &tree)
+{
+  std::vector<std::pair<uint32_t, size_t>> pending = {{0, 0}};
+  while (!tree.empty() && !pending.empty())
+  {
+    uint32_t node = pending.back().first;
+    size_t depth = pending.back().second;
+    pending.pop_back();
+    std::cout << std::string(2 * depth, ' ') << grammar5NonterminalNames[tree[node].kind] << " ["
+              << tree[node].begin << ", " << tree[node].end << ")\n";
+    if (tree[node].nextSibling != NO_PARSE_NODE)
+      pending.push_back({tree[node].nextSibling, depth});
+    if (tree[node].firstChild != NO_PARSE_NODE)
+      pending.push_back({tree[node].firstChild, depth + 1});
+  }
+}
+
 // Example usage
-int main()
+// -p: packrat mode, prints the memo hit rate
+// -t: prints the parse tree
+// -d depth: productions being parsed at once the parser gives up at, DEFAULT_MAX_DEPTH if not given
+// -e grammar: Earley recognizer (earley.h) over the grammar file instead, any revision of grammar5.md
+// argv[1]: optional token file written by the scanner (tokfile.h), replaces the example tokens
+int main(int argc, char **argv)
 {
+  bool packrat = argc > 1 && !strcmp(argv[1], "-p");
+  if (packrat)
+  {
+    argc--;
+    argv++;
+  }
+  bool printTree = argc > 1 && !strcmp(argv[1], "-t");
+  if (printTree)
+  {
+    argc--;
+    argv++;
+  }
+  size_t maxDepth = DEFAULT_MAX_DEPTH;
+  if (argc > 2 && !strcmp(argv[1], "-d"))
+  {
+    maxDepth = strtoul(argv[2], NULL, 10);
+    argc -= 2;
+    argv += 2;
+  }
+  const char *grammarFile = NULL;
+  if (argc > 2 && !strcmp(argv[1], "-e"))
+  {
+    grammarFile = argv[2];
+    argc -= 2;
+    argv += 2;
+  }
+
   try
   {
     // Example token sequence - replace with actual tokens
-    std::vector<int> tokens = {1, 0, 8, 2, 0, 4, 0, 0, 0, 5, 8, 0, 0, 0, 9, 0, 0, 8, 0, 0, 4, 5, 8, 0, 0, 8, 0, 4, 0, 5};
+    std::vector<uint8_t> example = {1, 0, 8, 2, 0, 4, 0, 0, 0, 5, 8, 0, 0, 0, 9, 0, 0, 8, 0, 0, 4, 5, 8, 0, 0, 8, 0, 4, 0, 5};
+    tokenSpan tokens = tokenSpanOf(example.data(), example.size());
+
+    // mapped until the process exits, the parser reads the file in place
+    tokfile file;
+    if (argc > 1)
+    {
+      if (!tokfileMap(argv[1], &file))
+      {
+        std::cout << argv[1] << " is not a token file\n";
+        return 1;
+      }
+      tokens = file.tokens;
+    }
+
+    if (grammarFile)
+    {
+      try
+      {
+        EarleyGrammar grammar(grammarFile, grammar5Terminals);
+        EarleyParser parser(grammar, tokens);
+        if (!parser.parse())
+          std::cout << ParseError(parser.getErrorPosition()).what();
+        const earleyStats &stats = parser.getStats();
+        std::cout << "earley: " << stats.items << " items, " << stats.completions << " completions ("
+                  << stats.transitive << " transitive)\n";
+      }
+      catch (const std::runtime_error &e)
+      {
+        // errors of the grammar file, on their own line like the ones of ParseError
+        std::cout << "\n" << e.what() << "\n";
+        return 1;
+      }
+      return 0;
+    }
 
-    RecursiveDescentParser parser(tokens);
-    parser.parse();
+    RecursiveDescentParser parser(tokens, packrat, maxDepth);
+    std::vector<parseNode> tree;
+    try
+    {
+      parser.parse(printTree ? &tree : nullptr);
+    }
+    catch (const ParseError &e)
+    {
+      std::cout << e.what();
+    }
+    printParseTree(tree);
+    if (packrat)
+    {
+      const memoStats &stats = parser.getMemoStats();
+      std::cout << "memo: " << stats.hits << " hits / " << stats.lookups << " lookups ("
+                << (stats.lookups ? 100.0 * stats.hits / stats.lookups : 0.0) << "%), "
+                << stats.recursions << " left recursions cut\n";
+    }
   }
   catch (std::runtime_error e)
   {
     std::cout << e.what();
   }
-};
\ No newline at end of file
+};
+#endif
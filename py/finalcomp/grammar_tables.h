@@ -0,0 +1,67 @@
+// generated by python/llgen.py from grammar.txt, do not edit
+#ifndef GRAMMAR_TABLES_H
+#define GRAMMAR_TABLES_H
+
+#include <stdint.h>
+
+#ifndef LEXGEN_TABLE
+#ifdef __cplusplus
+#define LEXGEN_TABLE constexpr
+#else
+#define LEXGEN_TABLE static const
+#endif
+#endif
+
+#define GRAMMAR_NONTERMINALS 4
+#define GRAMMAR_PRODUCTIONS 8
+// terminal columns, the last one (GRAMMAR_END) is the end of the input
+#define GRAMMAR_COLUMNS 4
+#define GRAMMAR_END 3
+#define GRAMMAR_NONE 255
+#define GRAMMAR_NONTERMINAL_BASE 128
+#define GRAMMAR_CONFLICTS 0
+
+// nonterminals, the first one is the start symbol
+#define GRAMMAR_S 0
+#define GRAMMAR_OOP 1
+#define GRAMMAR_COMP 2
+#define GRAMMAR_PP 3
+
+// columns: 0 def (<1>), 1 class (<2>), 2 self (<3>), 3 $
+// token id -> column, GRAMMAR_NONE for the ids the grammar doesn't use
+LEXGEN_TABLE uint8_t grammarColumnOf[256] = {255, 0, 1, 2, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255};
+
+// nonterminal x column -> production, GRAMMAR_NONE if no alternative starts with the token
+LEXGEN_TABLE uint8_t grammarPredict[4][4] = {
+    {1, 0, 0, 255},
+    {255, 2, 3, 255},
+    {5, 4, 4, 6},
+    {7, 255, 255, 255}
+};
+
+// production -> nonterminal on its left
+LEXGEN_TABLE uint8_t grammarLhs[8] = {0, 0, 1, 1, 2, 2, 2, 3};
+
+// nonterminal -> its first production, grammarFirstProduction[n + 1] - 1 is its last
+LEXGEN_TABLE uint8_t grammarFirstProduction[5] = {0, 2, 4, 7, 8};
+
+// production -> first symbol in grammarRhs, one past the last production at the end
+LEXGEN_TABLE uint16_t grammarRhsStart[9] = {0, 1, 2, 4, 6, 7, 8, 8, 10};
+
+// right hand sides, columns below GRAMMAR_NONTERMINAL_BASE and nonterminals from it
+LEXGEN_TABLE uint8_t grammarRhs[10] = {129, 131, 1, 130, 2, 130, 129, 131, 0, 130};
+
+// production -> FIRST+ set, one bit per column
+LEXGEN_TABLE uint32_t grammarFirstPlus[8] = {0x6, 0x1, 0x2, 0x4, 0x6, 0x1, 0x8, 0x1};
+
+// production -> 1 if it derives ε, its FIRST+ set then holds the FOLLOW of its left hand side
+LEXGEN_TABLE uint8_t grammarNullable[8] = {0, 0, 0, 0, 0, 0, 1, 0};
+
+// nonterminal -> 1 if two of its alternatives share a token (not LL(1), the first one is predicted)
+LEXGEN_TABLE uint8_t grammarConflicted[4] = {0, 0, 0, 0};
+
+// names as the grammar file writes them, for messages
+LEXGEN_TABLE char grammarNonterminalNames[4][5] = {"S", "OOP", "COMP", "PP"};
+LEXGEN_TABLE char grammarTerminalNames[4][6] = {"def", "class", "self", "$"};
+
+#endif
@@ -1,100 +1,147 @@
+#include <array>
 #include <vector>
 #include <string>
+#include <string_view>
 #include <iostream>
 #include <stdio.h>
-
-#define START_FINAL_STATES 16
-#define FAIL_STATE 19
-#define STATE_TOKENID_DIFFERENCE 15
+#include "pythoncomp_tables.h"
+#include "../../tokenstream.h"
+#include "../../dfa.h"
+#include "../../ll1.h"
+#include "grammar_tables.h"
 
 /*
-  maps the ASCII values of the DFA alphabet to their respective index
-
-  @charToIndex: pointer to the array where the values will be mapped
-
-  Return: none
-*/
-void mapSymbols(int charToIndex[128])
+ * Gets the DFA of pythoncomp_tables.h as the engine of dfa.h runs it, built
+ * on the first call and shared by every later one.
+ *
+ * @return: The language, read only.
+ */
+const dfaLanguage &pythoncompLanguage()
 {
-  // any characters out of the alphabet
-  for (int i = 0; i < 128; i++)
-    charToIndex[i] = 9;
-
-  // A-Z
-  for (int i = 'A'; i < 'Z'; i++)
-    charToIndex[i] = 8;
-
-  // a-z
-  for (int i = 'a'; i < 'z'; i++)
-    charToIndex[i] = 8;
-
-  charToIndex['_'] = 8;
-
-  // 0-9
-  for (int i = '0'; i < '9'; i++)
-    charToIndex[i] = 8;
-
-  charToIndex['\n'] = 0;
-  charToIndex['d'] = 1;
-  charToIndex['e'] = 2;
-  charToIndex['f'] = 3;
-  charToIndex['c'] = 4;
-  charToIndex['l'] = 5;
-  charToIndex['a'] = 6;
-  charToIndex['s'] = 7;
-
-  charToIndex[EOF] = 10;
-  charToIndex['#'] = 11;
+  static const dfaLanguage language = []
+  {
+    dfaLanguage built;
+    dfaFromLongestMatch(&built, pythoncompClassOf, &pythoncompNext[0][0], pythoncompAccept,
+                        PYTHONCOMP_STATES, PYTHONCOMP_CLASSES, PYTHONCOMP_DEAD, PYTHONCOMP_NONE);
+    return built;
+  }();
+  return language;
 }
 
 /*
-  Determines if the DFA should consume the next character
-
-  @state: current state
-  @ch: current character
-
-  e.g.
-  if we have reached a delimiter for a lexeme, it will be consumed if it is a space,
-  but it will be kept if it is a semicolon
-
-  Return: 1 if it should advance, 0 if not
-*/
-int advance(int state, char ch)
+ * Scans a code snippet in memory into a token stream.
+ * The stream is cleared first and keeps its capacity, so a caller that reuses
+ * it across snippets doesn't allocate once it is big enough.
+ *
+ * @param code: The code snippet, doesn't need to be null terminated.
+ * @param tokens: An initialized stream where the tokens are stored.
+ * @return: The same stream.
+ */
+tokenStream &scanCode(std::string_view code, tokenStream &tokens)
 {
-  // return ch != EOF && (state != 17) && (state != 18) &&
-  //        (state != START_FINAL_STATES ||
-  //         (state == START_FINAL_STATES && ch == ' ')) &&
-  //        !(state == 19 && ch == '\n');
-  // return (state != 10)
-  return state < START_FINAL_STATES && ch != '\0';
+  clearTokenStream(&tokens);
+
+  /*
+    Maximal munch over the generated DFA (pythoncomp_tables.h), run by the
+    shared engine of dfa.h, the longest accepted prefix wins and the scan
+    restarts right after it
+  */
+  dfaCursor cursor = {0, 0, 0, 0, 0, 0};
+  dfaScanRange(&pythoncompLanguage(), code.data(), code.size(), 1, &cursor, code.size(),
+               [](void *context, int tokenId, const char *, size_t, size_t offset, size_t line)
+               {
+                 if (tokenId != DFA_ERROR && tokenId != PYTHONCOMP_SKIP)
+                   recordToken((tokenStream *)context, tokenId, -1, offset, line);
+               },
+               &tokens);
+  return tokens;
 }
 
 /*
-  Determines if a state is accepted
-
-  @state: current state
+ * Scans a file into a new token stream, released by the caller.
+ *
+ * @param filename: The file to scan, an empty stream if it can't be opened.
+ * @return: The token stream.
+ */
+tokenStream scanner(const char *filename)
+{
+  tokenStream tokens;
+  initTokenStream(&tokens, 0, tokenStreamRealloc, NULL);
+
+  FILE *fileptr = fopen(filename, "rb");
+  if (!fileptr)
+    return tokens;
+  std::string code;
+  char block[1 << 16];
+  size_t got;
+  while ((got = fread(block, 1, sizeof(block), fileptr)) > 0)
+    code.append(block, got);
+  fclose(fileptr);
+
+  scanCode(code, tokens);
+  return tokens;
+}
 
-  states 12-17 are accepted
+// regenerate with: python3 ../../python/llgen.py grammar.txt grammar_tables.h def=1 class=2 self=3
+static const ll1Grammar paradigmGrammar = {grammarColumnOf, &grammarPredict[0][0], grammarRhsStart, grammarRhs,
+                                           GRAMMAR_COLUMNS};
 
-  Return: 1 if it is accepted, 0 if not
-*/
-int accept(int state)
+class Parser
 {
-  return state >= START_FINAL_STATES && state < FAIL_STATE;
-}
+  // non-owning, TOKEN_END (-1) past the last token
+  tokenSpan tokens;
+  // symbols the driver's stack can hold, ll1.h gives up past them
+  size_t maxDepth;
+  bool isOOP = false;
+  bool isPP = false;
+  std::string errorMessage;
 
-/*
-  Gets the token id based on the state
+  // S -> OOP | PP, OOP -> class COMP | self COMP, PP -> def COMP, COMP -> OOP | PP | e
+  // grammar.txt is LL(1), the driver picks every production from the token it starts at
+  static void expand(void *context, int production, size_t)
+  {
+    Parser *parser = static_cast<Parser *>(context);
+    if (grammarLhs[production] == GRAMMAR_OOP)
+      parser->isOOP = true;
+    else if (grammarLhs[production] == GRAMMAR_PP)
+      parser->isPP = true;
+  }
 
-  @state: final state
-  @buffer: buffer that stores the lexeme
+public:
+  Parser(tokenSpan tokens, size_t maxDepth = LL1_DEFAULT_MAX_DEPTH)
+  {
+    this->tokens = tokens;
+    this->maxDepth = maxDepth;
+  }
 
-  Return: token id
-*/
-int getTokenId(int state)
-{
-  return state - STATE_TOKENID_DIFFERENCE;
-}
+  std::string parse()
+  {
+    // kept for the caller, batch mode can't write to stdout
+    size_t position;
+    int outcome = ll1Parse(&paradigmGrammar, GRAMMAR_S, tokens, maxDepth, expand, this, &position);
+    if (outcome == LL1_REJECTED)
+      errorMessage = "\nerror at position " + std::to_string(position) + "\n";
+    else if (outcome == LL1_TOO_DEEP)
+      errorMessage = "\nnesting deeper than " + std::to_string(maxDepth) + " at position " +
+                     std::to_string(position) + "\n";
+    else if (outcome == LL1_NO_MEMORY)
+      errorMessage = "\nout of memory at position " + std::to_string(position) + "\n";
+    if (isOOP && isPP)
+      return "Procedural and Object-Oriented Programming";
+    else if (isOOP)
+      return "Object-Oriented Programming";
+    else if (isPP)
+      return "Procedural Programming";
+    else
+      return "";
+  }
+
+  // where the last parse failed, empty if it didn't
+  const std::string &getError()
+  {
+    return errorMessage;
+  }
+};
 
 /*
  * Is a compiled shared library to be called from Python.
@@ -107,187 +154,173 @@ int getTokenId(int state)
  * - "Simple Text"
  *
  * @param code_snippet: A string containing the actual code snippet to analyze.
+ * @param tokens: Optional stream reused for the tokens, left filled for the caller.
+ * @param error: Optional string where the parse error is stored, empty if there was none.
  * @return: A string indicating the programming paradigm.
  */
-std::vector<int> scanner(const char *filename)
+std::string classifyCode(std::string_view code_snippet, tokenStream *tokens = nullptr, std::string *error = nullptr)
 {
-  const int transitionTable[16][12] = {
-      {0, 4, 1, 1, 7, 1, 1, 12, 1, 1, 19, 3},
-      {0, 1, 1, 1, 1, 1, 1, 1, 1, 2, 19, 3},
-      {0, 1, 1, 1, 1, 1, 1, 12, 1, 2, 19, 3},
-      {0, 3, 3, 3, 3, 3, 3, 3, 3, 3, 19, 3},
-      {0, 1, 5, 1, 1, 1, 1, 1, 1, 1, 19, 3},
-      {0, 1, 1, 6, 1, 1, 1, 1, 1, 1, 19, 3},
-      {0, 1, 1, 1, 1, 1, 1, 1, 1, 16, 16, 3},
-      {0, 1, 1, 1, 1, 8, 1, 1, 1, 1, 19, 3},
-      {0, 1, 1, 1, 1, 1, 9, 1, 1, 1, 19, 3},
-      {0, 1, 1, 1, 1, 1, 1, 10, 1, 1, 19, 3},
-      {0, 1, 1, 1, 1, 1, 1, 11, 1, 1, 19, 3},
-      {0, 1, 1, 1, 1, 1, 1, 1, 1, 17, 17, 3},
-      {0, 1, 13, 1, 1, 1, 1, 1, 1, 1, 19, 3},
-      {0, 1, 1, 1, 1, 14, 1, 1, 1, 1, 19, 3},
-      {0, 1, 1, 15, 1, 1, 1, 1, 1, 1, 19, 3},
-      {0, 1, 1, 1, 1, 1, 1, 1, 1, 18, 18, 18},
-  };
-
-  int charToIndex[128];
-  mapSymbols(charToIndex);
-
-  std::vector<int> tokens;
-
-  int state;
-  FILE *fileptr = fopen(filename, "r");
-  char ch = fgetc(fileptr);
-  int charVal = charToIndex[ch];
-  int tokenid;
-
-  int pp = 0;
-  int oop = 0;
-
-  // Main DFA simulation loop
-  while (ch != EOF)
+  tokenStream local;
+  if (!tokens)
   {
-    state = 0;
-    // states >= START_FINAL_STATES are final
-    while (state < START_FINAL_STATES)
-    {
-      state = transitionTable[state][charVal];
-      if (advance(state, ch))
-      {
-        ch = fgetc(fileptr);
-        if (ch == -1)
-          charVal = 10;
-        else
-          charVal = charToIndex[ch];
-      }
-    }
-
-    if (accept(state))
-    {
-      tokenid = getTokenId(state);
-      tokens.push_back(tokenid);
-    }
+    initTokenStream(&local, 0, tokenStreamRealloc, NULL);
+    tokens = &local;
   }
 
-  // Return the paradigm classification
-  return tokens;
+  Parser parser(tokenStreamSpan(&scanCode(code_snippet, *tokens)));
+  std::string paradigm = parser.parse();
+  if (error)
+    *error = parser.getError();
+
+  if (tokens == &local)
+    releaseTokenStream(&local);
+  return paradigm;
 }
 
-class Parser
+/*
+ * Counters of the count-only mode, filled block by block without a token stream.
+ *
+ * @counts: Lexemes by token id, 1: def, 2: class, 3: self, 0: dropped lexemes.
+ * @state: DFA state carried from one block to the next.
+ */
+struct paradigmTally
 {
-  std::vector<int> tokens;
-  int position = 0;
-  bool isOOP = false;
-  bool isPP = false;
+  size_t counts[4] = {0, 0, 0, 0};
+  int state = PYTHONCOMP_START;
+};
 
-  void match(int token)
-  {
-    if (token == tokens[position])
-      position++;
-    else
-      error();
-  }
+/*
+ * Maps every DFA state to the counter its lexeme goes to when it ends there.
+ */
+constexpr std::array<uint8_t, PYTHONCOMP_STATES> tallySlots()
+{
+  std::array<uint8_t, PYTHONCOMP_STATES> slots{};
+  for (int state = 0; state < PYTHONCOMP_STATES; state++)
+    slots[state] = pythoncompAccept[state] < 4 ? pythoncompAccept[state] : 0;
+  return slots;
+}
 
-  void error()
-  {
-    throw std::runtime_error("\nerror at position " + std::to_string(position) + "\n");
-  }
+/*
+ * Determines if the longest match never has to back up: every state but the
+ * start and the dead one accepts, and the start state never dies.
+ */
+constexpr bool matchesWithoutBacktracking()
+{
+  for (int state = 0; state < PYTHONCOMP_STATES; state++)
+    if (state != PYTHONCOMP_START && state != PYTHONCOMP_DEAD && pythoncompAccept[state] == PYTHONCOMP_NONE)
+      return false;
+  for (int symbol = 0; symbol < PYTHONCOMP_CLASSES; symbol++)
+    if (pythoncompNext[PYTHONCOMP_START][symbol] == PYTHONCOMP_DEAD)
+      return false;
+  return true;
+}
 
-  // S -> OOP | PP
-  void S()
-  {
-    if (tokens[position] == 1)
-      PP();
-    else if (tokens[position] == 2 || tokens[position] == 3)
-      OOP();
-    else
-      error();
-  };
+static_assert(matchesWithoutBacktracking(),
+              "the count-only scan reads pythoncomp_tables.h one byte at a time, use scanCode for this spec");
 
-  // OOP -> class COMP | self COMP
-  void OOP()
-  {
-    this->isOOP = true;
+/*
+ * Count-only scan of a block of code, the DFA of scanCode fused with the
+ * counters: the state that dies on a byte ends a lexeme and bumps the counter
+ * of its token id, nothing else is stored.
+ * Blocks can split lexemes anywhere, the state goes on in the next call.
+ *
+ * @param code: The next block of the snippet.
+ * @param tally: Counters of the snippet so far.
+ */
+void tallyCode(std::string_view code, paradigmTally &tally)
+{
+  static constexpr std::array<uint8_t, PYTHONCOMP_STATES> slots = tallySlots();
+  const dfaLanguage &language = pythoncompLanguage();
 
-    if (tokens[position] == 2)
-    {
-      match(2);
-      COMP();
-    }
-    else if (tokens[position] == 3)
-    {
-      match(3);
-      COMP();
-    }
-    else
+  const char *position = code.data();
+  const char *end = position + code.size();
+  int state = tally.state;
+  for (; position < end; position++)
+  {
+    int symbol = pythoncompClassOf[(unsigned char)*position];
+    int next = pythoncompNext[state][symbol];
+    if (next == PYTHONCOMP_DEAD)
     {
-      error();
+      tally.counts[slots[state]]++;
+      next = pythoncompNext[PYTHONCOMP_START][symbol];
     }
-  }
-
-  // PP -> def COMP
-  void PP()
-  {
-    this->isPP = true;
-
-    match(1);
-    COMP();
-  };
-
-  // COMP -> OOP | PP | e
-  void COMP()
-  {
-    if (tokens[position] == 1)
-      PP();
-    else if (tokens[position] == 2 || tokens[position] == 3)
-      OOP();
+    state = next;
 
-    // epsilon production
-    else if (tokens[position] == -1)
-      return;
-    else
-      error();
-  };
-
-public:
-  Parser(std::vector<int> tokens)
-  {
-    this->tokens = tokens;
+    // comments only wait for their line break
+    if (language.skipTo[state] != NO_SKIP)
+      position = findByte(position + 1, end, (char)language.skipTo[state]) - 1;
   }
+  tally.state = state;
+}
 
-  std::string parse()
-  {
-    try
-    {
-      S();
-    }
-    catch (std::runtime_error e)
-    {
-      // prints where the error happened
-      std::cout << e.what();
-    }
-    if (isOOP && isPP)
-      return "Procedural and Object-Oriented Programming";
-    else if (isOOP)
-      return "Object-Oriented Programming";
-    else if (isPP)
-      return "Procedural Programming";
-    else
-      return "";
-  }
-};
+/*
+ * Ends a count-only scan and gets its verdict.
+ * Every token the DFA emits is in FIRST(COMP), so after the first token the
+ * parser of classifyCode can't fail and its flags only depend on which ids
+ * appeared: the verdict is read from the counters.
+ *
+ * @param tally: Counters of the whole snippet, the last lexeme is counted here.
+ * @param error: Optional string where the parse error is stored, empty if there was none.
+ * @return: The same paradigm classifyCode returns.
+ */
+const char *finishTally(paradigmTally &tally, std::string *error = nullptr)
+{
+  if (tally.state != PYTHONCOMP_START)
+    tally.counts[tallySlots()[tally.state]]++;
+  tally.state = PYTHONCOMP_START;
+
+  bool isPP = tally.counts[1] > 0;
+  bool isOOP = tally.counts[2] > 0 || tally.counts[3] > 0;
+  if (error)
+    *error = isPP || isOOP ? "" : "\nerror at position 0\n";
+
+  if (isOOP && isPP)
+    return "Procedural and Object-Oriented Programming";
+  else if (isOOP)
+    return "Object-Oriented Programming";
+  else if (isPP)
+    return "Procedural Programming";
+  else
+    return "";
+}
+
+/*
+ * Count-only classification of a file, read in fixed blocks, so the memory
+ * used doesn't depend on the size of the file.
+ *
+ * @param filename: The file to classify.
+ * @param tally: Counters to be filled, they should start empty.
+ * @param error: Optional string where the parse error is stored, empty if there was none.
+ * @return: The paradigm, nullptr if the file can't be opened.
+ */
+const char *countFile(const char *filename, paradigmTally &tally, std::string *error = nullptr)
+{
+  FILE *fileptr = fopen(filename, "rb");
+  if (!fileptr)
+    return nullptr;
+  char block[1 << 16];
+  size_t got;
+  while ((got = fread(block, 1, sizeof(block), fileptr)) > 0)
+    tallyCode(std::string_view(block, got), tally);
+  fclose(fileptr);
+  return finishTally(tally, error);
+}
 
+#ifndef PYTHONCOMP_NO_MAIN
 int main()
 {
-  std::vector<int> tokens = scanner("3.py");
-  tokens.push_back(-1);
+  tokenStream stream = scanner("3.py");
+  tokenSpan tokens = tokenStreamSpan(&stream);
 
-  // 1: def, 2: class, 3: self, -1: $
+  // 1: def, 2: class, 3: self, -1: $ (read one past the last token)
   std::cout << "tokens: ";
-  for (int token : tokens)
-    std::cout << token << " ";
+  for (size_t i = 0; i <= tokens.size(); i++)
+    std::cout << tokens[i] << " ";
 
   Parser parser = Parser(tokens);
   std::string paradigm = parser.parse();
+  std::cout << parser.getError();
   std::cout << "\n\nParadigm: " << paradigm << "\n\n";
-}
\ No newline at end of file
+  releaseTokenStream(&stream);
+}
+#endif
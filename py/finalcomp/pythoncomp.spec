@@ -0,0 +1,11 @@
+; token spec for the paradigm classifier in pythoncomp.cpp
+; regenerate with: python3 ../../python/lexgen.py pythoncomp.spec pythoncomp_tables.h
+;
+; 1: def, 2: class, 3: self, any other word, comment or symbol is dropped
+
+def      1  def
+class    2  class
+self     3  self
+word     -  [A-Za-z0-9_]+
+comment  -  #[^\n]*
+other    -  [^A-Za-z0-9_#]
@@ -0,0 +1,49 @@
+// generated by python/lexgen.py from pythoncomp.spec, do not edit
+#ifndef PYTHONCOMP_TABLES_H
+#define PYTHONCOMP_TABLES_H
+
+#include <stdint.h>
+
+#ifndef LEXGEN_TABLE
+#ifdef __cplusplus
+#define LEXGEN_TABLE constexpr
+#else
+#define LEXGEN_TABLE static const
+#endif
+#endif
+
+#define PYTHONCOMP_STATES 17
+#define PYTHONCOMP_CLASSES 11
+#define PYTHONCOMP_START 0
+#define PYTHONCOMP_DEAD 7
+#define PYTHONCOMP_NONE 255
+#define PYTHONCOMP_SKIP 254
+
+// byte -> equivalence class
+LEXGEN_TABLE uint8_t pythoncompClassOf[256] = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 0, 0, 0, 0, 0, 0, 0, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 0, 0, 0, 0, 3, 0, 4, 3, 5, 6, 7, 8, 3, 3, 3, 3, 3, 9, 3, 3, 3, 3, 3, 3, 10, 3, 3, 3, 3, 3, 3, 3, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
+
+// state x class -> state
+LEXGEN_TABLE uint8_t pythoncompNext[17][11] = {
+    {1, 1, 2, 3, 3, 4, 5, 3, 3, 3, 6},
+    {7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7},
+    {2, 7, 2, 2, 2, 2, 2, 2, 2, 2, 2},
+    {7, 7, 7, 3, 3, 3, 3, 3, 3, 3, 3},
+    {7, 7, 7, 3, 3, 3, 3, 3, 3, 8, 3},
+    {7, 7, 7, 3, 3, 3, 3, 9, 3, 3, 3},
+    {7, 7, 7, 3, 3, 3, 3, 10, 3, 3, 3},
+    {7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7},
+    {7, 7, 7, 3, 11, 3, 3, 3, 3, 3, 3},
+    {7, 7, 7, 3, 3, 3, 3, 3, 12, 3, 3},
+    {7, 7, 7, 3, 3, 3, 3, 3, 3, 13, 3},
+    {7, 7, 7, 3, 3, 3, 3, 3, 3, 3, 14},
+    {7, 7, 7, 3, 3, 3, 3, 3, 3, 3, 3},
+    {7, 7, 7, 3, 3, 3, 3, 3, 15, 3, 3},
+    {7, 7, 7, 3, 3, 3, 3, 3, 3, 3, 16},
+    {7, 7, 7, 3, 3, 3, 3, 3, 3, 3, 3},
+    {7, 7, 7, 3, 3, 3, 3, 3, 3, 3, 3}
+};
+
+// state -> token id, PYTHONCOMP_NONE if it doesn't accept, PYTHONCOMP_SKIP if the lexeme is dropped
+LEXGEN_TABLE uint8_t pythoncompAccept[17] = {255, 254, 254, 254, 254, 254, 254, 255, 254, 254, 254, 254, 1, 254, 254, 3, 2};
+
+#endif
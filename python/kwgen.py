@@ -0,0 +1,156 @@
+"""
+Generates a perfect hash over a keyword set
+
+usage: python3 kwgen.py <spec> <output header>
+
+Each line of the spec is `keyword id`, blank lines and lines starting with `;`
+are ignored. The hash only looks at the length and the first and last bytes of
+the lexeme, so a lookup is a few loads and one comparison against a single
+candidate whatever the size of the set. The generator searches the smallest
+power of two table and the multipliers that place every keyword in its own
+slot, and fails if two keywords share (length, first, last).
+
+The header holds the slot arrays (constexpr in C++, static const in C) and a
+`<prefix>Lookup(lexeme, length)` function that returns the id or 0.
+"""
+
+import os
+import sys
+
+MULTIPLIERS = range(1, 256)
+
+
+def read_spec(path):
+    keywords = []
+    with open(path) as spec:
+        for line in spec:
+            line = line.strip()
+            if not line or line.startswith(";"):
+                continue
+            keyword, keyword_id = line.split()
+            keywords.append((keyword, int(keyword_id)))
+    return keywords
+
+
+def key(keyword):
+    data = keyword.encode()
+    return len(data), data[0], data[-1]
+
+
+def slot(length, first, last, a, b, mask):
+    return (length + first * a + last * b) & mask
+
+
+def search(keywords):
+    """Returns (size, a, b) of the smallest table with no collisions"""
+    keys = [key(keyword) for keyword, _ in keywords]
+    if len(set(keys)) != len(keys):
+        seen = {}
+        for (keyword, _), k in zip(keywords, keys):
+            if k in seen:
+                sys.exit(f"'{seen[k]}' and '{keyword}' share length, first and last byte")
+            seen[k] = keyword
+    size = 1
+    while size < len(keys):
+        size *= 2
+    while True:
+        for a in MULTIPLIERS:
+            for b in MULTIPLIERS:
+                if len({slot(*k, a, b, size - 1) for k in keys}) == len(keys):
+                    return size, a, b
+        size *= 2
+
+
+def emit(path, spec, prefix, keywords, size, a, b):
+    upper = prefix.upper()
+    guard = f"{upper}_TABLES_H"
+    longest = max(len(keyword.encode()) for keyword, _ in keywords)
+    slots = [("", 0)] * size
+    for keyword, keyword_id in keywords:
+        slots[slot(*key(keyword), a, b, size - 1)] = (keyword, keyword_id)
+
+    def row(values):
+        return "{" + ", ".join(map(str, values)) + "}"
+
+    lengths = [len(keyword.encode()) for keyword, _ in slots]
+    firsts = [keyword.encode()[0] if keyword else 0 for keyword, _ in slots]
+    lasts = [keyword.encode()[-1] if keyword else 0 for keyword, _ in slots]
+    texts = ",\n".join(f'    "{keyword}"' for keyword, _ in slots)
+    out = [
+        f"// generated by python/kwgen.py from {os.path.basename(spec)}, do not edit",
+        f"#ifndef {guard}",
+        f"#define {guard}",
+        "",
+        "#include <stddef.h>",
+        "#include <stdint.h>",
+        "#include <string.h>",
+        "",
+        "#ifndef LEXGEN_TABLE",
+        "#ifdef __cplusplus",
+        "#define LEXGEN_TABLE constexpr",
+        "#else",
+        "#define LEXGEN_TABLE static const",
+        "#endif",
+        "#endif",
+        "",
+        f"#define {upper}_COUNT {len(keywords)}",
+        f"#define {upper}_SLOTS {size}",
+        f"#define {upper}_SHORTEST {min(lengths[i] for i in range(size) if lengths[i])}",
+        f"#define {upper}_LONGEST {longest}",
+        f"#define {upper}_SLOT(length, first, last) \\",
+        f"  (((length) + (first) * {a}u + (last) * {b}u) & {size - 1}u)",
+        "",
+        "// slot -> keyword length, 0 for empty slots",
+        f"LEXGEN_TABLE uint8_t {prefix}Length[{size}] = {row(lengths)};",
+        "",
+        "// slot -> first and last byte of the keyword",
+        f"LEXGEN_TABLE uint8_t {prefix}First[{size}] = {row(firsts)};",
+        f"LEXGEN_TABLE uint8_t {prefix}Last[{size}] = {row(lasts)};",
+        "",
+        "// slot -> keyword and token id",
+        f"LEXGEN_TABLE char {prefix}Text[{size}][{longest + 1}] = {{",
+        texts,
+        "};",
+        f"LEXGEN_TABLE int {prefix}Id[{size}] = {row(id for _, id in slots)};",
+        "",
+        "/*",
+        "  Gets the id of a keyword",
+        "",
+        "  @lexeme: start of the lexeme",
+        "  @length: length of the lexeme",
+        "",
+        "  Return: token id, 0 if the lexeme isn't a keyword",
+        "*/",
+        f"static inline int {prefix}Lookup(const char *lexeme, size_t length)",
+        "{",
+        f"  if (length < {upper}_SHORTEST || length > {upper}_LONGEST)",
+        "    return 0;",
+        "",
+        "  uint8_t first = (uint8_t)lexeme[0];",
+        "  uint8_t last = (uint8_t)lexeme[length - 1];",
+        f"  unsigned slot = {upper}_SLOT((unsigned)length, first, last);",
+        f"  if ({prefix}Length[slot] != length || {prefix}First[slot] != first || {prefix}Last[slot] != last)",
+        "    return 0;",
+        f"  return memcmp(lexeme, {prefix}Text[slot], length) ? 0 : {prefix}Id[slot];",
+        "}",
+        "",
+        "#endif",
+        "",
+    ]
+    with open(path, "w") as header:
+        header.write("\n".join(out))
+
+
+def main():
+    if len(sys.argv) != 3:
+        sys.exit("usage: python3 kwgen.py <spec> <output header>")
+    spec, output = sys.argv[1], sys.argv[2]
+    keywords = read_spec(spec)
+    size, a, b = search(keywords)
+    prefix = os.path.splitext(os.path.basename(spec))[0]
+    emit(output, spec, prefix, keywords, size, a, b)
+    print(f"{spec}: {len(keywords)} keywords in {size} slots")
+
+
+if __name__ == "__main__":
+    main()
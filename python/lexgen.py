@@ -0,0 +1,308 @@
+"""
+Generates compact lexer tables from a token spec
+
+usage: python3 lexgen.py <spec> <output header>
+
+Each line of the spec is `name id regex`, `id` is the token id reported to the
+parser or `-` for lexemes that are matched and dropped (whitespace, comments).
+The lexer is maximal munch, when two tokens match the same length the one
+declared first wins. Blank lines and lines starting with `;` are ignored.
+
+Supported regex syntax: literals, escapes (\\n \\t \\\\ ...), `.` (any byte but a
+line break), classes `[a-z_]` and `[^\\n]`, groups, `|`, `*`, `+` and `?`.
+
+The header holds a byte -> equivalence class map, the minimized transition
+table over those classes and the accept state -> token id map, all of them
+uint8_t (constexpr in C++, static const in C).
+"""
+
+import os
+import sys
+
+ANY = frozenset(range(256))
+NONE = 255
+SKIP = 254
+ESCAPES = {"n": ord("\n"), "t": ord("\t"), "r": ord("\r"), "0": 0}
+
+
+class Regex:
+    """Recursive descent over the regex syntax, builds a Thompson NFA"""
+
+    def __init__(self, nfa, pattern):
+        self.nfa = nfa
+        self.pattern = pattern
+        self.i = 0
+
+    def peek(self):
+        return self.pattern[self.i] if self.i < len(self.pattern) else None
+
+    def take(self):
+        ch = self.pattern[self.i]
+        self.i += 1
+        return ch
+
+    def escape(self):
+        ch = self.take()
+        return ESCAPES.get(ch, ord(ch))
+
+    def parse(self):
+        fragment = self.alternation()
+        if self.i != len(self.pattern):
+            raise SyntaxError(f"unexpected '{self.peek()}' in {self.pattern}")
+        return fragment
+
+    # alternation -> concatenation ('|' concatenation)*
+    def alternation(self):
+        fragments = [self.concatenation()]
+        while self.peek() == "|":
+            self.take()
+            fragments.append(self.concatenation())
+        if len(fragments) == 1:
+            return fragments[0]
+        start, end = self.nfa.state(), self.nfa.state()
+        for first, last in fragments:
+            self.nfa.epsilon(start, first)
+            self.nfa.epsilon(last, end)
+        return start, end
+
+    # concatenation -> repetition*
+    def concatenation(self):
+        start = end = self.nfa.state()
+        while self.peek() not in (None, "|", ")"):
+            first, last = self.repetition()
+            self.nfa.epsilon(end, first)
+            end = last
+        return start, end
+
+    # repetition -> atom ('*' | '+' | '?')*
+    def repetition(self):
+        first, last = self.atom()
+        while self.peek() in ("*", "+", "?"):
+            op = self.take()
+            start, end = self.nfa.state(), self.nfa.state()
+            self.nfa.epsilon(start, first)
+            self.nfa.epsilon(last, end)
+            if op in ("*", "?"):
+                self.nfa.epsilon(start, end)
+            if op in ("*", "+"):
+                self.nfa.epsilon(last, first)
+            first, last = start, end
+        return first, last
+
+    # atom -> '(' alternation ')' | class | '.' | literal
+    def atom(self):
+        ch = self.take()
+        if ch == "(":
+            fragment = self.alternation()
+            if self.take() != ")":
+                raise SyntaxError(f"missing ')' in {self.pattern}")
+            return fragment
+        if ch == "[":
+            symbols = self.charclass()
+        elif ch == ".":
+            symbols = ANY - {ord("\n")}
+        elif ch == "\\":
+            symbols = frozenset([self.escape()])
+        else:
+            symbols = frozenset(ch.encode())
+        start, end = self.nfa.state(), self.nfa.state()
+        self.nfa.edge(start, symbols, end)
+        return start, end
+
+    def charclass(self):
+        negated = self.peek() == "^"
+        if negated:
+            self.take()
+        symbols = set()
+        while self.peek() != "]":
+            low = self.escape() if self.take() == "\\" else ord(self.pattern[self.i - 1])
+            high = low
+            if self.peek() == "-" and self.pattern[self.i + 1] != "]":
+                self.take()
+                high = self.escape() if self.take() == "\\" else ord(self.pattern[self.i - 1])
+            symbols.update(range(low, high + 1))
+        self.take()
+        return ANY - symbols if negated else frozenset(symbols)
+
+
+class NFA:
+    def __init__(self):
+        self.epsilons = []
+        self.edges = []
+        self.accepts = {}
+
+    def state(self):
+        self.epsilons.append([])
+        self.edges.append([])
+        return len(self.edges) - 1
+
+    def epsilon(self, source, target):
+        self.epsilons[source].append(target)
+
+    def edge(self, source, symbols, target):
+        self.edges[source].append((symbols, target))
+
+    def closure(self, states):
+        stack = list(states)
+        seen = set(states)
+        while stack:
+            for target in self.epsilons[stack.pop()]:
+                if target not in seen:
+                    seen.add(target)
+                    stack.append(target)
+        return frozenset(seen)
+
+
+def read_spec(path):
+    tokens = []
+    with open(path) as spec:
+        for line in spec:
+            line = line.strip()
+            if not line or line.startswith(";"):
+                continue
+            name, token_id, pattern = line.split(None, 2)
+            tokens.append((name, SKIP if token_id == "-" else int(token_id), pattern))
+    return tokens
+
+
+def build_nfa(tokens):
+    nfa = NFA()
+    start = nfa.state()
+    for priority, (_, token_id, pattern) in enumerate(tokens):
+        first, last = Regex(nfa, pattern).parse()
+        nfa.epsilon(start, first)
+        nfa.accepts[last] = (priority, token_id)
+    return nfa, start
+
+
+def subset_construction(nfa, start):
+    """Returns the transition table over bytes and the token id of every state"""
+    initial = nfa.closure([start])
+    index = {initial: 0}
+    order = [initial]
+    table = []
+    accepts = []
+    while len(table) < len(order):
+        current = order[len(table)]
+        row = []
+        for byte in range(256):
+            targets = [t for s in current for symbols, t in nfa.edges[s] if byte in symbols]
+            following = nfa.closure(targets) if targets else frozenset()
+            if following not in index:
+                index[following] = len(order)
+                order.append(following)
+            row.append(index[following])
+        table.append(row)
+        matches = [nfa.accepts[s] for s in current if s in nfa.accepts]
+        accepts.append(min(matches)[1] if matches else NONE)
+    return table, accepts
+
+
+def minimize(table, accepts):
+    """Moore partition refinement, the start state stays as state 0"""
+    block = {s: accepts[s] for s in range(len(table))}
+    while True:
+        signatures = {}
+        refined = {}
+        # the start state goes first so it gets block 0
+        for s in range(len(table)):
+            signature = (block[s], tuple(block[t] for t in table[s]))
+            refined[s] = signatures.setdefault(signature, len(signatures))
+        if len(signatures) == len(set(block.values())):
+            break
+        block = refined
+    block = refined
+
+    states = len(set(block.values()))
+    small = [None] * states
+    small_accepts = [NONE] * states
+    for s in range(len(table)):
+        small[block[s]] = [block[t] for t in table[s]]
+        small_accepts[block[s]] = accepts[s]
+    return small, small_accepts
+
+
+def compress_alphabet(table):
+    """Bytes with identical columns share one equivalence class"""
+    classes = {}
+    class_of = []
+    for byte in range(256):
+        column = tuple(row[byte] for row in table)
+        class_of.append(classes.setdefault(column, len(classes)))
+    compressed = [[0] * len(classes) for _ in table]
+    for column, symbol in classes.items():
+        for state, target in enumerate(column):
+            compressed[state][symbol] = target
+    return class_of, compressed
+
+
+def dead_state(table, accepts):
+    for state, row in enumerate(table):
+        if accepts[state] == NONE and all(target == state for target in row):
+            return state
+    return NONE
+
+
+def emit(path, spec, prefix, class_of, table, accepts, dead):
+    upper = prefix.upper()
+    guard = f"{upper}_TABLES_H"
+    rows = ",\n".join("    {" + ", ".join(map(str, row)) + "}" for row in table)
+    out = [
+        f"// generated by python/lexgen.py from {os.path.basename(spec)}, do not edit",
+        f"#ifndef {guard}",
+        f"#define {guard}",
+        "",
+        "#include <stdint.h>",
+        "",
+        "#ifndef LEXGEN_TABLE",
+        "#ifdef __cplusplus",
+        "#define LEXGEN_TABLE constexpr",
+        "#else",
+        "#define LEXGEN_TABLE static const",
+        "#endif",
+        "#endif",
+        "",
+        f"#define {upper}_STATES {len(table)}",
+        f"#define {upper}_CLASSES {len(table[0])}",
+        f"#define {upper}_START 0",
+        f"#define {upper}_DEAD {dead}",
+        f"#define {upper}_NONE {NONE}",
+        f"#define {upper}_SKIP {SKIP}",
+        "",
+        "// byte -> equivalence class",
+        f"LEXGEN_TABLE uint8_t {prefix}ClassOf[256] = {{"
+        + ", ".join(map(str, class_of)) + "};",
+        "",
+        "// state x class -> state",
+        f"LEXGEN_TABLE uint8_t {prefix}Next[{len(table)}][{len(table[0])}] = {{",
+        rows,
+        "};",
+        "",
+        f"// state -> token id, {upper}_NONE if it doesn't accept, {upper}_SKIP if the lexeme is dropped",
+        f"LEXGEN_TABLE uint8_t {prefix}Accept[{len(table)}] = {{"
+        + ", ".join(map(str, accepts)) + "};",
+        "",
+        f"#endif",
+        "",
+    ]
+    with open(path, "w") as header:
+        header.write("\n".join(out))
+
+
+def main():
+    if len(sys.argv) != 3:
+        sys.exit("usage: python3 lexgen.py <spec> <output header>")
+    spec, output = sys.argv[1], sys.argv[2]
+    tokens = read_spec(spec)
+    table, accepts = minimize(*subset_construction(*build_nfa(tokens)))
+    class_of, compressed = compress_alphabet(table)
+    if len(compressed) >= SKIP:
+        sys.exit(f"{len(compressed)} states don't fit in uint8_t")
+    prefix = os.path.splitext(os.path.basename(spec))[0]
+    emit(output, spec, prefix, class_of, compressed, accepts, dead_state(compressed, accepts))
+    print(f"{spec}: {len(compressed)} states, {len(compressed[0])} classes, "
+          f"{len(compressed) * len(compressed[0])} bytes of transitions")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,353 @@
+"""
+Generates LL(1) predict tables from a grammar file
+
+usage: python3 llgen.py <grammar> <output header> [terminal=ids ...]
+
+The grammar is read in the notation of grammar5.md and
+py/finalcomp/grammar.txt: every line with `->` is `NONTERMINAL -> alternative
+| alternative ...`, symbols are separated by spaces, `ε` (or `e`) is the empty
+alternative, `_x_` and `<n>` are terminals and so is any bare symbol that no
+line defines. Consecutive lines that define the same nonterminal are one
+definition (grammar.md writes long ones that way); after that the first
+definition is the one used, the later ones (FIRST+ listings, rewritten copies
+of the grammar) are skipped, as are `<!-- -->` comments and all the lines
+without `->`. The first nonterminal is the start symbol.
+
+Terminals get their token ids from a `name=ids` argument, a comma separated
+list of ids and ranges (`id=0,10-255` also reads the keywords as identifiers),
+the first id names the terminal. `<n>` is id n.
+
+FIRST, FOLLOW and FIRST+ are computed as bitsets (one bit per terminal, the
+last one for $) by fixed-point iteration. Two alternatives of a nonterminal
+whose FIRST+ sets intersect are an LL(1) conflict: they are reported, the
+nonterminal is flagged and its predict cells keep the first alternative that
+claims the token, the ordered choice the recursive descent parsers make.
+
+The header holds the token id -> column map, the predict table (nonterminal x
+column -> production), the productions as flat symbol lists grouped by
+nonterminal, the FIRST+ bitset of every production, the conflict flags and the
+symbol names, constexpr in C++ and static const in C, ready for the ll1.h driver.
+"""
+
+import os
+import re
+import sys
+
+NONE = 255
+# rhs symbols from here on are nonterminals
+NONTERMINAL_BASE = 128
+PRIMES = ["", "PRIME", "DOUBLE_PRIME", "TRIPLE_PRIME", "QUADRUPLE_PRIME", "QUINTUPLE_PRIME"]
+
+
+def read_grammar(path):
+    """Returns [(nonterminal, [alternative])] in order, an alternative is a list of symbols"""
+    rules = []
+    defined = set()
+    last = None
+    with open(path, encoding="utf-8") as grammar:
+        text = re.sub(r"<!--.*?-->", "", grammar.read(), flags=re.S)
+    for line in text.splitlines():
+        if "->" not in line:
+            continue
+        lhs, rhs = line.split("->", 1)
+        lhs = lhs.strip()
+        if not lhs or " " in lhs:
+            continue
+        alternatives = [[s for s in alternative.split() if s not in ("ε", "e")] for alternative in rhs.split("|")]
+        # the line right after a definition of the same nonterminal goes on with it
+        if lhs == last:
+            rules[-1][1].extend(alternatives)
+            continue
+        if lhs in defined:
+            last = None
+            continue
+        defined.add(lhs)
+        rules.append((lhs, alternatives))
+        last = lhs
+    if not rules:
+        sys.exit(f"{path}: no productions")
+    return rules
+
+
+def terminal_name(symbol):
+    match = re.fullmatch(r"_(.+)_", symbol)
+    return match.group(1) if match else symbol
+
+
+def terminal_ids(name, ids):
+    match = re.fullmatch(r"<(\d+)>", name)
+    if match:
+        return [int(match.group(1))]
+    if name not in ids:
+        sys.exit(f"terminal '{name}' has no id, pass {name}=<id>")
+    return ids[name]
+
+
+def parse_ids(text):
+    ids = []
+    for part in text.split(","):
+        first, _, last = part.partition("-")
+        ids.extend(range(int(first), int(last or first) + 1))
+    if not ids or min(ids) < 0 or max(ids) > 255:
+        sys.exit(f"token ids '{text}' are not in 0-255")
+    return ids
+
+
+def macro_name(nonterminal):
+    base = nonterminal.rstrip("'")
+    primes = len(nonterminal) - len(base)
+    return base.upper() + ("_" + PRIMES[primes] if primes else "")
+
+
+class Grammar:
+    def __init__(self, rules, ids):
+        self.nonterminals = [lhs for lhs, _ in rules]
+        index = {lhs: n for n, lhs in enumerate(self.nonterminals)}
+
+        # one column per terminal in token id order, $ is the last column
+        names = {terminal_name(symbol) for _, alternatives in rules for alternative in alternatives
+                 for symbol in alternative if symbol not in index}
+        self.terminals = sorted(names, key=lambda name: terminal_ids(name, ids)[0])
+        self.ids = [terminal_ids(name, ids) for name in self.terminals]
+        every = [token_id for column in self.ids for token_id in column]
+        if len(set(every)) != len(every):
+            sys.exit("two terminals share a token id")
+        self.end = len(self.terminals)
+        columns = {name: column for column, name in enumerate(self.terminals)}
+
+        self.productions = []
+        for lhs, alternatives in rules:
+            for alternative in alternatives:
+                symbols = [NONTERMINAL_BASE + index[symbol] if symbol in index else columns[terminal_name(symbol)]
+                           for symbol in alternative]
+                self.productions.append((index[lhs], symbols))
+
+    def first_of(self, symbols, first, nullable):
+        """FIRST of a symbol list as a bitset, and whether it derives ε"""
+        bits = 0
+        for symbol in symbols:
+            if symbol < NONTERMINAL_BASE:
+                return bits | 1 << symbol, False
+            bits |= first[symbol - NONTERMINAL_BASE]
+            if not nullable[symbol - NONTERMINAL_BASE]:
+                return bits, False
+        return bits, True
+
+    def compute(self):
+        count = len(self.nonterminals)
+        first = [0] * count
+        nullable = [False] * count
+        changed = True
+        while changed:
+            changed = False
+            for lhs, symbols in self.productions:
+                bits, empty = self.first_of(symbols, first, nullable)
+                if bits | first[lhs] != first[lhs] or (empty and not nullable[lhs]):
+                    first[lhs] |= bits
+                    nullable[lhs] = nullable[lhs] or empty
+                    changed = True
+
+        follow = [0] * count
+        follow[0] = 1 << self.end
+        changed = True
+        while changed:
+            changed = False
+            for lhs, symbols in self.productions:
+                for i, symbol in enumerate(symbols):
+                    if symbol < NONTERMINAL_BASE:
+                        continue
+                    bits, empty = self.first_of(symbols[i + 1:], first, nullable)
+                    if empty:
+                        bits |= follow[lhs]
+                    n = symbol - NONTERMINAL_BASE
+                    if bits | follow[n] != follow[n]:
+                        follow[n] |= bits
+                        changed = True
+
+        self.first, self.nullable, self.follow = first, nullable, follow
+        self.first_plus = []
+        self.derives_empty = []
+        for lhs, symbols in self.productions:
+            bits, empty = self.first_of(symbols, first, nullable)
+            self.first_plus.append(bits | follow[lhs] if empty else bits)
+            self.derives_empty.append(int(empty))
+
+    def build_table(self):
+        """Predict table and the conflicts as (nonterminal, production, production, bits)"""
+        self.predict = [[NONE] * (self.end + 1) for _ in self.nonterminals]
+        self.conflicts = []
+        self.conflicted = [0] * len(self.nonterminals)
+        claimed = {}
+        for production, (lhs, _) in enumerate(self.productions):
+            for earlier in claimed.get(lhs, []):
+                shared = self.first_plus[earlier] & self.first_plus[production]
+                if shared:
+                    self.conflicts.append((lhs, earlier, production, shared))
+                    self.conflicted[lhs] = 1
+            claimed.setdefault(lhs, []).append(production)
+            for column in range(self.end + 1):
+                if self.first_plus[production] >> column & 1 and self.predict[lhs][column] == NONE:
+                    self.predict[lhs][column] = production
+
+    def reachable(self):
+        seen = {0}
+        stack = [0]
+        while stack:
+            n = stack.pop()
+            for lhs, symbols in self.productions:
+                if lhs != n:
+                    continue
+                for symbol in symbols:
+                    if symbol >= NONTERMINAL_BASE and symbol - NONTERMINAL_BASE not in seen:
+                        seen.add(symbol - NONTERMINAL_BASE)
+                        stack.append(symbol - NONTERMINAL_BASE)
+        return seen
+
+    def names(self, bits):
+        return ", ".join(self.terminals[c] if c < self.end else "$" for c in range(self.end + 1) if bits >> c & 1)
+
+    def show(self, production):
+        lhs, symbols = self.productions[production]
+        rhs = " ".join(self.nonterminals[s - NONTERMINAL_BASE] if s >= NONTERMINAL_BASE else self.terminals[s]
+                       for s in symbols)
+        return f"{self.nonterminals[lhs]} -> {rhs or 'ε'}"
+
+
+def name_width(names):
+    return max(len(name.encode()) for name in names) + 1
+
+
+def c_string(name):
+    return '"' + name.replace("\\", "\\\\").replace('"', '\\"') + '"'
+
+
+def emit(path, source, prefix, grammar):
+    upper = prefix.upper()
+    guard = f"{upper}_TABLES_H"
+    columns = grammar.end + 1
+    column_of = [NONE] * 256
+    for column, token_ids in enumerate(grammar.ids):
+        for token_id in token_ids:
+            column_of[token_id] = column
+
+    # productions are grouped by nonterminal, in the order of the rules
+    first_production = [0] * (len(grammar.nonterminals) + 1)
+    for production, (lhs, _) in reversed(list(enumerate(grammar.productions))):
+        first_production[lhs] = production
+    first_production[-1] = len(grammar.productions)
+
+    starts = [0]
+    rhs = []
+    for _, symbols in grammar.productions:
+        rhs.extend(symbols)
+        starts.append(len(rhs))
+
+    out = [
+        f"// generated by python/llgen.py from {os.path.basename(source)}, do not edit",
+        f"#ifndef {guard}",
+        f"#define {guard}",
+        "",
+        "#include <stdint.h>",
+        "",
+        "#ifndef LEXGEN_TABLE",
+        "#ifdef __cplusplus",
+        "#define LEXGEN_TABLE constexpr",
+        "#else",
+        "#define LEXGEN_TABLE static const",
+        "#endif",
+        "#endif",
+        "",
+        f"#define {upper}_NONTERMINALS {len(grammar.nonterminals)}",
+        f"#define {upper}_PRODUCTIONS {len(grammar.productions)}",
+        f"// terminal columns, the last one ({upper}_END) is the end of the input",
+        f"#define {upper}_COLUMNS {columns}",
+        f"#define {upper}_END {grammar.end}",
+        f"#define {upper}_NONE {NONE}",
+        f"#define {upper}_NONTERMINAL_BASE {NONTERMINAL_BASE}",
+        f"#define {upper}_CONFLICTS {len(grammar.conflicts)}",
+        "",
+        "// nonterminals, the first one is the start symbol",
+    ]
+    out += [f"#define {upper}_{macro_name(n)} {i}" for i, n in enumerate(grammar.nonterminals)]
+    out += [
+        "",
+        "// columns: " + ", ".join(f"{c} {name} (<{grammar.ids[c][0]}>)" for c, name in enumerate(grammar.terminals))
+        + f", {grammar.end} $",
+        f"// token id -> column, {upper}_NONE for the ids the grammar doesn't use",
+        f"LEXGEN_TABLE uint8_t {prefix}ColumnOf[256] = {{" + ", ".join(map(str, column_of)) + "};",
+        "",
+        f"// nonterminal x column -> production, {upper}_NONE if no alternative starts with the token",
+        f"LEXGEN_TABLE uint8_t {prefix}Predict[{len(grammar.nonterminals)}][{columns}] = {{",
+        ",\n".join(f"    {{{', '.join(map(str, row))}}}" for row in grammar.predict),
+        "};",
+        "",
+        "// production -> nonterminal on its left",
+        f"LEXGEN_TABLE uint8_t {prefix}Lhs[{len(grammar.productions)}] = {{"
+        + ", ".join(str(lhs) for lhs, _ in grammar.productions) + "};",
+        "",
+        f"// nonterminal -> its first production, {prefix}FirstProduction[n + 1] - 1 is its last",
+        f"LEXGEN_TABLE uint8_t {prefix}FirstProduction[{len(first_production)}] = {{"
+        + ", ".join(map(str, first_production)) + "};",
+        "",
+        f"// production -> first symbol in {prefix}Rhs, one past the last production at the end",
+        f"LEXGEN_TABLE uint16_t {prefix}RhsStart[{len(starts)}] = {{" + ", ".join(map(str, starts)) + "};",
+        "",
+        f"// right hand sides, columns below {upper}_NONTERMINAL_BASE and nonterminals from it",
+        f"LEXGEN_TABLE uint8_t {prefix}Rhs[{max(len(rhs), 1)}] = {{" + ", ".join(map(str, rhs or [0])) + "};",
+        "",
+        "// production -> FIRST+ set, one bit per column",
+        f"LEXGEN_TABLE uint32_t {prefix}FirstPlus[{len(grammar.productions)}] = {{"
+        + ", ".join(f"0x{bits:x}" for bits in grammar.first_plus) + "};",
+        "",
+        "// production -> 1 if it derives ε, its FIRST+ set then holds the FOLLOW of its left hand side",
+        f"LEXGEN_TABLE uint8_t {prefix}Nullable[{len(grammar.productions)}] = {{"
+        + ", ".join(map(str, grammar.derives_empty)) + "};",
+        "",
+        "// nonterminal -> 1 if two of its alternatives share a token (not LL(1), the first one is predicted)",
+        f"LEXGEN_TABLE uint8_t {prefix}Conflicted[{len(grammar.nonterminals)}] = {{"
+        + ", ".join(map(str, grammar.conflicted)) + "};",
+        "",
+        "// names as the grammar file writes them, for messages",
+        f"LEXGEN_TABLE char {prefix}NonterminalNames[{len(grammar.nonterminals)}][{name_width(grammar.nonterminals)}] = {{"
+        + ", ".join(c_string(n) for n in grammar.nonterminals) + "};",
+        f"LEXGEN_TABLE char {prefix}TerminalNames[{columns}][{name_width(grammar.terminals + ['$'])}] = {{"
+        + ", ".join(c_string(n) for n in grammar.terminals + ["$"]) + "};",
+        "",
+        "#endif",
+        "",
+    ]
+    with open(path, "w") as header:
+        header.write("\n".join(out))
+
+
+def main():
+    if len(sys.argv) < 3:
+        sys.exit("usage: python3 llgen.py <grammar> <output header> [terminal=ids ...]")
+    source, output = sys.argv[1], sys.argv[2]
+    ids = {}
+    for argument in sys.argv[3:]:
+        name, _, token_ids = argument.rpartition("=")
+        ids[name] = parse_ids(token_ids)
+
+    grammar = Grammar(read_grammar(source), ids)
+    if len(grammar.nonterminals) > NONTERMINAL_BASE or grammar.end >= 32 or len(grammar.productions) >= NONE:
+        sys.exit("the grammar doesn't fit in the table types")
+    grammar.compute()
+    grammar.build_table()
+
+    for lhs, earlier, production, shared in grammar.conflicts:
+        print(f"conflict in {grammar.nonterminals[lhs]} on {{{grammar.names(shared)}}}:\n"
+              f"  {grammar.show(earlier)}\n  {grammar.show(production)}")
+    unreachable = [n for i, n in enumerate(grammar.nonterminals) if i not in grammar.reachable()]
+    if unreachable:
+        print("unreachable: " + ", ".join(unreachable))
+
+    prefix = os.path.splitext(os.path.basename(source))[0]
+    emit(output, source, prefix, grammar)
+    free = len(grammar.nonterminals) - sum(grammar.conflicted)
+    print(f"{source}: {len(grammar.nonterminals)} nonterminals, {len(grammar.productions)} productions, "
+          f"{len(grammar.conflicts)} conflicts, {free} nonterminals LL(1)")
+
+
+if __name__ == "__main__":
+    main()
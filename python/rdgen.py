@@ -0,0 +1,448 @@
+"""
+Generates a recursive descent parser from a grammar file
+
+usage: python3 rdgen.py [--memo] <grammar> <output header> [terminal=ids ...]
+
+The grammar and the terminal ids are read as llgen.py reads them. Before the
+code is written the grammar is rewritten until every nonterminal can be a
+function that only looks at the current token:
+- left recursion, direct or through other nonterminals, is removed (A -> A a |
+  b becomes A -> b A', A' -> a A' | ε), the nonterminals of each cycle are
+  substituted into each other first
+- alternatives that start with the same symbols are left factored (A -> x y |
+  x z becomes A -> x A', A' -> y | z), until no two alternatives of a
+  nonterminal share their first symbol
+the new nonterminals take the name of the one they come from with one more '.
+
+Every nonterminal becomes a parseX() method that switches on the column of
+the current token. A case lists the alternatives that can match there, those
+whose FIRST holds the token and the nullable ones, in the order of the
+grammar: a single one is called directly, more than one are tried in order,
+going back to the start of the production after each failure, the ordered
+choice the hand written parsers make. The tokens no alternative starts with
+fall to the nullable alternatives or fail. Terminals are matched in place
+against named column constants.
+
+--memo writes a packrat parser instead: every nonterminal records its outcome
+per position, and a second call there returns it, linear time whatever the
+backtracking.
+
+The class is named after the output file (grammar5_parser.h ->
+Grammar5Parser), so parsers of several grammars or strategies can be used
+together.
+"""
+
+import os
+import re
+import sys
+
+from llgen import NONE, NONTERMINAL_BASE, PRIMES as MACRO_PRIMES, Grammar, parse_ids, read_grammar, terminal_name
+
+REPO = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+PRIMES = ["", "Prime", "DoublePrime", "TriplePrime", "QuadruplePrime", "QuintuplePrime"]
+PUNCTUATION = {"(": "OPEN_PAREN", ")": "CLOSE_PAREN", "{": "OPEN_BRACE", "}": "CLOSE_BRACE", "[": "OPEN_BRACKET",
+               "]": "CLOSE_BRACKET", ":": "COLON", ",": "COMMA", ".": "DOT", "=": "EQUALS", ";": "SEMICOLON"}
+
+
+def fresh_name(name, taken):
+    while name in taken:
+        name += "'"
+    taken.add(name)
+    return name
+
+
+def normalize(rules):
+    """Writes every terminal as _name_ (<n> stays), so equal symbols compare equal"""
+    defined = {lhs for lhs, _ in rules}
+    return [(lhs, [[s if s in defined or re.fullmatch(r"<\d+>", s) else f"_{terminal_name(s)}_" for s in alt]
+                   for alt in alternatives]) for lhs, alternatives in rules]
+
+
+def left_recursive(rules):
+    """Nonterminals that can derive themselves as their first symbol, ignoring nullable prefixes"""
+    starts = {lhs: {alt[0] for alt in alternatives if alt} for lhs, alternatives in rules}
+    cyclic = set()
+    for lhs in starts:
+        seen = set()
+        stack = list(starts[lhs])
+        while stack:
+            symbol = stack.pop()
+            if symbol == lhs:
+                cyclic.add(lhs)
+                break
+            if symbol in starts and symbol not in seen:
+                seen.add(symbol)
+                stack.extend(starts[symbol])
+    return cyclic
+
+
+def remove_left_recursion(rules):
+    """Paull's algorithm, on the left recursive nonterminals only, so the rest of the grammar stays as written"""
+    cyclic = left_recursive(rules)
+    if not cyclic:
+        return rules, 0
+    taken = {lhs for lhs, _ in rules}
+    table = {lhs: [list(alt) for alt in alternatives] for lhs, alternatives in rules}
+    order = [lhs for lhs, _ in rules if lhs in cyclic]
+    added = {}
+    for i, a in enumerate(order):
+        for b in order[:i]:
+            replaced = []
+            for alt in table[a]:
+                if alt and alt[0] == b:
+                    replaced.extend(expansion + alt[1:] for expansion in table[b])
+                else:
+                    replaced.append(alt)
+            table[a] = replaced
+        recursive = [alt[1:] for alt in table[a] if alt and alt[0] == a]
+        if not recursive:
+            continue
+        tail = fresh_name(a + "'", taken)
+        table[a] = [alt + [tail] for alt in table[a] if not alt or alt[0] != a]
+        table[tail] = [alt + [tail] for alt in recursive] + [[]]
+        added[a] = tail
+
+    result = []
+    for lhs, _ in rules:
+        result.append((lhs, table[lhs]))
+        if lhs in added:
+            result.append((added[lhs], table[added[lhs]]))
+    if left_recursive(result):
+        sys.exit("left recursion through a nullable prefix isn't supported")
+    return result, len(added)
+
+
+def common_prefix(alternatives):
+    prefix = []
+    for symbols in zip(*alternatives):
+        if len(set(symbols)) != 1:
+            break
+        prefix.append(symbols[0])
+    return prefix
+
+
+def left_factor(rules):
+    """
+    Factors the alternatives of each nonterminal that share their first symbol,
+    the group keeps the place of its first member and ε goes last in the new
+    nonterminal, the longer alternatives are tried first as in the grammar
+    files factored by hand
+    """
+    taken = {lhs for lhs, _ in rules}
+    rules = [(lhs, [list(alt) for alt in alternatives]) for lhs, alternatives in rules]
+    factored = 0
+    i = 0
+    added = 0
+    while i < len(rules):
+        lhs, alternatives = rules[i]
+        groups = {}
+        for alt in alternatives:
+            if alt:
+                groups.setdefault(alt[0], []).append(alt)
+        shared = next((group for group in groups.values() if len(group) > 1), None)
+        if shared is None:
+            i += 1
+            added = 0
+            continue
+        prefix = common_prefix(shared)
+        rest = fresh_name(lhs + "'", taken)
+        position = next(k for k, alt in enumerate(alternatives) if alt is shared[0])
+        kept = [alt for alt in alternatives if not any(alt is member for member in shared)]
+        kept.insert(position, prefix + [rest])
+        rules[i] = (lhs, kept)
+        suffixes = [alt[len(prefix):] for alt in shared]
+        # after the ones already split from lhs, in the order they were made
+        added += 1
+        rules.insert(i + added, (rest, [alt for alt in suffixes if alt] + [alt for alt in suffixes if not alt][:1]))
+        factored += 1
+    return rules, factored
+
+
+def split_primes(nonterminal):
+    base = nonterminal.rstrip("'")
+    return re.sub(r"\W", "_", base), len(nonterminal) - len(base)
+
+
+def method_name(nonterminal):
+    """parseCLASSCOMPLEMENTPrime, as parser100.cpp names them"""
+    base, primes = split_primes(nonterminal)
+    return "parse" + base + (PRIMES[primes] if primes < len(PRIMES) else f"Prime{primes}")
+
+
+def constant_name(nonterminal):
+    """CLASSCOMPLEMENT_PRIME, as llgen.py names them"""
+    base, primes = split_primes(nonterminal)
+    if not primes:
+        return base.upper()
+    return base.upper() + "_" + (MACRO_PRIMES[primes] if primes < len(MACRO_PRIMES) else f"PRIME{primes}")
+
+
+def token_name(terminal):
+    if terminal in PUNCTUATION:
+        return "COLUMN_" + PUNCTUATION[terminal]
+    name = re.sub(r"\W", "_", terminal).upper()
+    return "COLUMN_" + name if name.strip("_") else f"COLUMN_{ord(terminal[0])}"
+
+
+class Generator:
+    def __init__(self, grammar, memo):
+        self.grammar = grammar
+        self.memo = memo
+        self.tokens = [token_name(t) for t in grammar.terminals]
+        if len(set(self.tokens)) != len(self.tokens):
+            sys.exit("two terminals get the same constant name")
+
+    def symbol(self, symbol):
+        if symbol >= NONTERMINAL_BASE:
+            return method_name(self.grammar.nonterminals[symbol - NONTERMINAL_BASE]) + "()"
+        return f"match({self.tokens[symbol]})"
+
+    def show(self, lhs):
+        g = self.grammar
+        alternatives = [" ".join(g.nonterminals[s - NONTERMINAL_BASE] if s >= NONTERMINAL_BASE
+                                 else g.terminals[s] for s in symbols) or "ε"
+                        for n, symbols in g.productions if n == lhs]
+        return f"{g.nonterminals[lhs]} -> {' | '.join(alternatives)}"
+
+    def choice(self, candidates):
+        """Ordered choice over the candidate productions, as lines of one expression"""
+        if not candidates:
+            return ["fail()"]
+        parts = []
+        for k, production in enumerate(candidates):
+            sequence = " && ".join(self.symbol(s) for s in self.grammar.productions[production][1])
+            if not sequence:
+                parts.append("true" if k == 0 else "backtrack(initial)")
+                break
+            if k == 0:
+                parts.append(f"({sequence})" if len(candidates) > 1 and " && " in sequence else sequence)
+            else:
+                parts.append(f"(backtrack(initial) && {sequence})")
+        return [part + (" ||" if k < len(parts) - 1 else "") for k, part in enumerate(parts)]
+
+    def method(self, lhs):
+        g = self.grammar
+        name = g.nonterminals[lhs]
+        productions = [p for p, (n, _) in enumerate(g.productions) if n == lhs]
+        first = {}
+        empty = {}
+        for p in productions:
+            first[p], empty[p] = g.first_of(g.productions[p][1], g.first, g.nullable)
+        fallback = tuple(p for p in productions if empty[p])
+        cases = {}
+        for column in range(g.end + 1):
+            candidates = tuple(p for p in productions if first[p] >> column & 1 or empty[p])
+            if candidates != fallback:
+                cases.setdefault(candidates, []).append(column)
+
+        def ret(lines, indent):
+            opening = f"return store({constant_name(name)}, initial, " if self.memo else "return "
+            lines[-1] += ");" if self.memo else ";"
+            # continuation lines line up with the first alternative
+            pad = " " * indent
+            return [pad + opening + lines[0]] + [pad + " " * len(opening) + line for line in lines[1:]]
+
+        body = []
+        for candidates, columns in sorted(cases.items(), key=lambda item: item[1][0]):
+            body += [f"    case {self.tokens[c] if c < g.end else 'COLUMN_END'}:" for c in columns]
+            body += ret(self.choice(candidates), 6)
+        if body:
+            body = ["    switch (column())", "    {"] + body + ["    }"]
+        body += ret(self.choice(fallback), 4)
+
+        head = [f"  // {self.show(lhs)}", f"  bool {method_name(name)}()", "  {"]
+        if self.memo:
+            head += ["    bool matched;", f"    if (recall({constant_name(name)}, matched))",
+                     "      return matched;"]
+        if self.memo or any("initial" in line for line in body):
+            head.append("    size_t initial = position;")
+        if len(head) > 3:
+            head.append("")
+        return head + body + ["  }"]
+
+
+def emit(path, source, grammar, memo, rewritten):
+    base = os.path.splitext(os.path.basename(path))[0]
+    class_name = "".join(part[:1].upper() + part[1:] for part in base.split("_"))
+    guard = base.upper() + "_H"
+    include = os.path.relpath(os.path.join(REPO, "tokenstream.h"), os.path.dirname(os.path.abspath(path)))
+    generator = Generator(grammar, memo)
+    column_of = [NONE] * 256
+    for column, token_ids in enumerate(grammar.ids):
+        for token_id in token_ids:
+            column_of[token_id] = column
+
+    out = [
+        f"// generated by python/rdgen.py{' --memo' if memo else ''} from {os.path.basename(source)}, do not edit",
+        f"#ifndef {guard}",
+        f"#define {guard}",
+        "",
+        "#include <stddef.h>",
+        "#include <stdint.h>",
+    ]
+    out += ["#include <vector>"] if memo else []
+    out += [
+        f'#include "{include}"',
+        "",
+    ]
+    if rewritten:
+        out += [f"// {rewritten}", ""]
+    out += [
+        f"class {class_name}",
+        "{",
+        "private:",
+        "  // terminal columns, COLUMN_END past the last token",
+        "  enum column",
+        "  {",
+    ]
+    out += [f"    {name}," for name in generator.tokens] + ["    COLUMN_END,", f"    COLUMN_NONE = {NONE}", "  };", ""]
+    if memo:
+        out += ["  // nonterminals, rows of the memo", "  enum nonterminal", "  {"]
+        out += [f"    {constant_name(n)}," for n in grammar.nonterminals] + ["    NONTERMINALS", "  };", ""]
+    out += [
+        "  // token id -> column",
+        "  static constexpr uint8_t columnOf[256] = {" + ", ".join(map(str, column_of)) + "};",
+        "",
+        "  // non-owning, the scanner's stream or a mapped token file outlives the parser",
+        "  tokenSpan tokens;",
+        "  size_t position = 0;",
+        "  // position of the last mismatch",
+        "  size_t errorPos = 0;",
+    ]
+    if memo:
+        out += [
+            "",
+            "  /*",
+            "    one entry per (nonterminal, position): MEMO_UNKNOWN, MEMO_FAILED plus",
+            "    the position of the error, or the position where it ended plus one",
+            "  */",
+            "  static constexpr uint32_t MEMO_UNKNOWN = 0;",
+            "  static constexpr uint32_t MEMO_FAILED = 0x80000000u;",
+            "  std::vector<uint32_t> memo;",
+        ]
+    out += [
+        "",
+        "  int column()",
+        "  {",
+        "    return position < tokens.count ? (int)columnOf[tokens.ids[position]] : (int)COLUMN_END;",
+        "  }",
+        "",
+        "  bool fail()",
+        "  {",
+        "    errorPos = position;",
+        "    return false;",
+        "  }",
+        "",
+        "  bool match(int expected)",
+        "  {",
+        "    if (column() != expected)",
+        "      return fail();",
+        "    position++;",
+        "    return true;",
+        "  }",
+        "",
+        "  // goes back to a checkpoint, always true so it chains with &&",
+        "  bool backtrack(size_t checkpoint)",
+        "  {",
+        "    position = checkpoint;",
+        "    return true;",
+        "  }",
+    ]
+    if memo:
+        out += [
+            "",
+            "  // replays the outcome of a nonterminal already parsed at the current position",
+            "  bool recall(int nonterminal, bool &matched)",
+            "  {",
+            "    uint32_t entry = memo[nonterminal * (tokens.count + 1) + position];",
+            "    if (entry == MEMO_UNKNOWN)",
+            "      return false;",
+            "    matched = !(entry & MEMO_FAILED);",
+            "    if (matched)",
+            "      position = entry - 1;",
+            "    else",
+            "      errorPos = entry & ~MEMO_FAILED;",
+            "    return true;",
+            "  }",
+            "",
+            "  bool store(int nonterminal, size_t start, bool matched)",
+            "  {",
+            "    memo[nonterminal * (tokens.count + 1) + start] =",
+            "        matched ? (uint32_t)position + 1 : MEMO_FAILED | (uint32_t)errorPos;",
+            "    return matched;",
+            "  }",
+        ]
+    for lhs in range(len(grammar.nonterminals)):
+        out += [""] + generator.method(lhs)
+    out += [
+        "",
+        "public:",
+        "  // @tokens: stream to be parsed, the parser keeps a view",
+        f"  {class_name}(tokenSpan tokens)",
+        "      : tokens(tokens)",
+        "  {",
+    ]
+    if memo:
+        out += ["    memo.assign(NONTERMINALS * (tokens.count + 1), MEMO_UNKNOWN);"]
+    out += [
+        "  }",
+        "",
+        "  /*",
+        "    Parses the whole stream from the start symbol, once",
+        "",
+        "    Return: true if it derives, the error is at getErrorPosition() if not",
+        "  */",
+        "  bool parse()",
+        "  {",
+        f"    if (!{method_name(grammar.nonterminals[0])}())",
+        "      return false;",
+        "    if (position < tokens.count)",
+        "      return fail();",
+        "    return true;",
+        "  }",
+        "",
+        "  size_t getErrorPosition()",
+        "  {",
+        "    return errorPos;",
+        "  }",
+        "};",
+        "",
+        "#endif",
+        "",
+    ]
+    with open(path, "w") as header:
+        header.write("\n".join(out))
+
+
+def main():
+    arguments = sys.argv[1:]
+    memo = "--memo" in arguments
+    if memo:
+        arguments.remove("--memo")
+    if len(arguments) < 2:
+        sys.exit("usage: python3 rdgen.py [--memo] <grammar> <output header> [terminal=ids ...]")
+    source, output = arguments[0], arguments[1]
+    ids = {}
+    for argument in arguments[2:]:
+        name, _, token_ids = argument.rpartition("=")
+        ids[name] = parse_ids(token_ids)
+
+    rules = normalize(read_grammar(source))
+    rules, recursions = remove_left_recursion(rules)
+    rules, factored = left_factor(rules)
+    grammar = Grammar(rules, ids)
+    grammar.compute()
+
+    rewritten = []
+    if recursions:
+        rewritten.append(f"{recursions} left recursive nonterminals rewritten")
+    if factored:
+        rewritten.append(f"{factored} prefixes left factored")
+    emit(output, source, grammar, memo, ", ".join(rewritten))
+    print(f"{source}: {len(grammar.nonterminals)} nonterminals, {len(grammar.productions)} productions, "
+          f"{recursions} left recursions removed, {factored} prefixes factored, "
+          f"{'memoized' if memo else 'predictive'} parser in {output}")
+
+
+if __name__ == "__main__":
+    main()
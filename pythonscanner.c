@@ -1,58 +1,52 @@
 #include <stdio.h>
 #include <string.h>
 #include "tables.c"
+#include "dfa.h"
 
-#define BUFFER_SIZE 128
 #define START_FINAL_STATES 10
 #define FAIL_STATE 12
 #define STATE_TOKENID_DIFFERENCE 9
+#define SYMBOLS 11
+#define EOF_SYMBOL 10
+#define STREAM_BLOCK_SIZE (1 << 16)
 
 /*
-  maps the ASCII values of the DFA alphabet to their respective index
+  maps the bytes of the DFA alphabet to their respective index
 
-  @charToIndex: pointer to the array where the values will be mapped
+  @classOf: pointer to the array where the values will be mapped, one entry per byte
+
+  bytes outside of ASCII are out of the alphabet here, the DFA engine reads the
+  ones in well-formed UTF-8 sequences as letters instead
 
   Return: none
 */
-void mapSymbols(int charToIndex[128])
+void mapSymbols(uint8_t classOf[256])
 {
   // any characters out of the alphabet
-  for (int i = 0; i < 128; i++)
-    charToIndex[i] = 9;
+  for (int i = 0; i < 256; i++)
+    classOf[i] = 9;
 
   // A-Z
-  for (int i = 'A'; i < 'Z'; i++)
-    charToIndex[i] = 8;
+  for (int i = 'A'; i <= 'Z'; i++)
+    classOf[i] = 8;
 
   // a-z
-  for (int i = 'a'; i < 'z'; i++)
-    charToIndex[i] = 8;
+  for (int i = 'a'; i <= 'z'; i++)
+    classOf[i] = 8;
 
   // 0-9
-  for (int i = '0'; i < '9'; i++)
-    charToIndex[i] = 8;
-
-  charToIndex['\n'] = 0;
-  charToIndex['d'] = 1;
-  charToIndex['e'] = 2;
-  charToIndex['f'] = 3;
-  charToIndex['c'] = 4;
-  charToIndex['l'] = 5;
-  charToIndex['a'] = 6;
-  charToIndex['s'] = 7;
-  charToIndex['_'] = 8;
-
-  /*
-    special case for EOF, as some languages like python
-    it's possible there is no delimiter between a lexeme and EOF
-
-    e.g.
-    a = b + c
-            ^
-            |
-    this is valid final line in python, there is no delimiter
-  */
-  charToIndex[EOF] = 10;
+  for (int i = '0'; i <= '9'; i++)
+    classOf[i] = 8;
+
+  classOf['\n'] = 0;
+  classOf['d'] = 1;
+  classOf['e'] = 2;
+  classOf['f'] = 3;
+  classOf['c'] = 4;
+  classOf['l'] = 5;
+  classOf['a'] = 6;
+  classOf['s'] = 7;
+  classOf['_'] = 8;
 }
 
 /*
@@ -73,51 +67,105 @@ int advance(int state, char ch)
 }
 
 /*
-  Determines if a state is accepted
+  Determines if a character should be stored in the buffer
 
   @state: current state
+  @ch: current character value
 
-  states 12-17 are accepted
+  characters that will be relevant later on are stored in the buffer, such as unrecognized chars for
+  error messages or an identifier for the symbol table
+  the lexer stops buffering once the lexeme is over DFA_BUFFER_SIZE chars
 
-  Return: 1 if it is accepted, 0 if not
+  Return: 1 if it should buffer it, 0 if not
 */
-int accept(int state)
+int shouldBuffer(int state, char ch)
 {
-  return state >= START_FINAL_STATES && state < FAIL_STATE;
+  return (ch != '\n' &&
+          (state != 10 && state != 11) &&
+          (state != START_FINAL_STATES)) ||
+         ((state == 5 || state == 6 || state == 9));
 }
 
+static const int transitionTable[10][11] = {
+    {0, 2, 1, 1, 5, 1, 1, 1, 1, 1, 12},
+    {0, 1, 1, 1, 1, 1, 1, 1, 1, 1, 12},
+    {0, 1, 3, 1, 1, 1, 1, 1, 1, 1, 12},
+    {0, 1, 1, 4, 1, 1, 1, 1, 1, 1, 12},
+    {10, 1, 1, 1, 1, 1, 1, 1, 1, 10, 12},
+    {0, 1, 1, 1, 1, 6, 1, 1, 1, 1, 12},
+    {0, 1, 1, 1, 1, 1, 7, 1, 1, 1, 12},
+    {0, 1, 1, 1, 1, 1, 1, 8, 1, 1, 12},
+    {0, 1, 1, 1, 1, 1, 1, 9, 1, 1, 12},
+    {11, 1, 1, 1, 1, 1, 1, 1, 1, 11, 12}};
+
 /*
-  Determines if a character should be stored in the buffer
+  Describes the language of the scanner for the DFA engine (dfa.h)
 
-  @state: current state
-  @ch: current character value
-  @len: current buffer length
+  @language: descriptor to be filled
 
-  characters that will be relevant later on are stored in the buffer, such as unrecognized chars for
-  error messages or an identifier for the symbol table
-  stops buffering if the lexeme is over 128 chars
+  EOF gets its own symbol, as some languages like python
+  it's possible there is no delimiter between a lexeme and EOF
 
-  Return: 1 if it should buffer it, 0 if not
+  e.g.
+  a = b + c
+          ^
+          |
+  this is valid final line in python, there is no delimiter
+
+  Return: none
 */
-int shouldBuffer(int state, char ch, int len)
+void initPythonLanguage(dfaLanguage *language)
 {
-  return len < BUFFER_SIZE - 1 && ch != '\n' &&
-             (state != 10 && state != 11) &&
-             (state != START_FINAL_STATES) ||
-         ((state == 5 || state == 6 || state == 9));
+  initDfaLanguage(language, SYMBOLS, START_FINAL_STATES, FAIL_STATE);
+  for (int state = 0; state < START_FINAL_STATES; state++)
+    for (int symbol = 0; symbol < SYMBOLS; symbol++)
+      language->next[state][symbol] = transitionTable[state][symbol];
+  mapSymbols(language->classOf);
+  // letters in any script can start and continue identifiers
+  language->utf8Symbol = 8;
+  language->eofSymbol = EOF_SYMBOL;
+
+  for (int state = START_FINAL_STATES; state < FAIL_STATE; state++)
+    language->tokens[state] = state - STATE_TOKENID_DIFFERENCE;
+
+  dfaDeriveActions(language, advance, shouldBuffer);
+  dfaBuildSkipTable(language);
 }
 
 /*
-  Gets the token id based on the state
+  State of the paradigm detection
 
-  @state: final state
-  @buffer: buffer that stores the lexeme
+  @tokens: token stream
+  @pp, @oop: 1 once a procedural (def) or object oriented (class) token is seen
+*/
+struct paradigmScan
+{
+  tokenStream *tokens;
+  int pp;
+  int oop;
+};
+typedef struct paradigmScan paradigmScan;
 
-  Return: token id
+/*
+  Callback that records the tokens and the paradigms they point to
+
+  @context: paradigmScan to be filled
+
+  unrecognized lexemes are ignored
+
+  Return: none
 */
-int getTokenId(int state)
+void recordParadigm(void *context, int tokenId, const char *, size_t, size_t offset, size_t line)
 {
-  return state - STATE_TOKENID_DIFFERENCE;
+  paradigmScan *scan = context;
+  if (tokenId == DFA_ERROR)
+    return;
+
+  recordToken(scan->tokens, tokenId, -1, offset, line);
+  if (tokenId == 1)
+    scan->pp = 1;
+  else
+    scan->oop = 1;
 }
 
 /*
@@ -130,8 +178,8 @@ int getTokenId(int state)
 
   Return: none
 */
-// void saveToFile(char *filename, tokenTable *tokens, charTable *identifiers, charTable *errors)
-void saveToFile(char *filename, tokenTable *tokens)
+// void saveToFile(char *filename, tokenStream *tokens, charTable *identifiers, charTable *errors)
+void saveToFile(char *filename, tokenStream *tokens)
 {
   FILE *file = fopen(filename, "w");
 
@@ -139,14 +187,14 @@ void saveToFile(char *filename, tokenTable *tokens)
   int oop = 0;
 
   fprintf(file, "Tokens:\n");
-  for (int i = 0; i < tokens->position; i++)
+  for (size_t i = 0; i < tokens->count; i++)
   {
-    fprintf(file, "<%d, %d>\n", tokens->tokens[i][0], tokens->tokens[i][1]);
-    if (tokens->tokens[i][0] == 1)
+    fprintf(file, "<%d, %d>\n", tokens->ids[i], tokens->symbols[i]);
+    if (tokens->ids[i] == 1)
     {
       pp = 1;
     }
-    else if (tokens->tokens[i][0] == 2)
+    else if (tokens->ids[i] == 2)
     {
       oop = 1;
     }
@@ -154,46 +202,19 @@ void saveToFile(char *filename, tokenTable *tokens)
 }
 
 /*
-  Main method
+  Scans a file, recording its tokens and paradigms
 
-  @argv[0]: filename of the input
-  @argv[1]: filename of the output
+  @filename: name of the input
+  @language: descriptor built by initPythonLanguage
+  @scan: tokens and paradigms to be filled
 
-  If the output file doesn't exist, it will be created
+  Return: 1 on success, 0 if the file can't be opened
 */
-int main(int argc, char **argv)
+int scanPythonFile(const char *filename, const dfaLanguage *language, paradigmScan *scan)
 {
-  static const int transitionTable[10][11] = {
-      {0, 2, 1, 1, 5, 1, 1, 1, 1, 1, 12},
-      {0, 1, 1, 1, 1, 1, 1, 1, 1, 1, 12},
-      {0, 1, 3, 1, 1, 1, 1, 1, 1, 1, 12},
-      {0, 1, 1, 4, 1, 1, 1, 1, 1, 1, 12},
-      {10, 1, 1, 1, 1, 1, 1, 1, 1, 10, 12},
-      {0, 1, 1, 1, 1, 6, 1, 1, 1, 1, 12},
-      {0, 1, 1, 1, 1, 1, 7, 1, 1, 1, 12},
-      {0, 1, 1, 1, 1, 1, 1, 8, 1, 1, 12},
-      {0, 1, 1, 1, 1, 1, 1, 9, 1, 1, 12},
-      {11, 1, 1, 1, 1, 1, 1, 1, 1, 11, 12}};
-
-  int charToIndex[128];
-  mapSymbols(charToIndex);
-
-  // initialization of tables (definition on tables.c)
-  tokenTable *tokens = initTokenTable();
-  charTable *identifiers = initCharTable();
-  charTable *errors = initCharTable();
-
-  int state;
-  char ch;
-  int tokenid;
-  FILE *fileptr = fopen(argv[1], "r");
-  // FILE *fileptr = fopen("tests/t.py", "r");
-  ch = fgetc(fileptr);
-  int charVal = charToIndex[ch];
-  int symbolIndex;
-
-  int pp = 0;
-  int oop = 0;
+  FILE *fileptr = fopen(filename, "r");
+  if (!fileptr)
+    return 0;
 
   /*
     DFA simulation
@@ -201,36 +222,49 @@ int main(int argc, char **argv)
       R. Castelló, Class Lecture, Topic: “Chapter 2 – Lexical Analysis.” TC3002,
       School of Engineering and Science, ITESM, Zapopan, Jalisco, April, 2025.
   */
-  while (ch != EOF)
-  {
-    state = 0;
-    while (state < START_FINAL_STATES)
-    {
-      state = transitionTable[state][charVal];
-      if (advance(state, ch))
-      {
-        ch = fgetc(fileptr);
-        charVal = charToIndex[ch];
-      }
-    }
+  dfaLexer lexer;
+  initDfaLexer(&lexer, language, recordParadigm, scan);
+
+  char block[STREAM_BLOCK_SIZE];
+  size_t got;
+  while ((got = fread(block, 1, sizeof(block), fileptr)) > 0)
+    dfaFeed(&lexer, block, got);
+  dfaFinish(&lexer);
+  fclose(fileptr);
+  return 1;
+}
 
-    if (accept(state))
-    {
+#ifndef PYTHONSCANNER_NO_MAIN
+/*
+  Main method
 
-      tokenid = getTokenId(state);
+  @argv[0]: filename of the input
+  @argv[1]: filename of the output
 
-      if (tokenid == 1)
-        pp = 1;
-      else
-        oop = 1;
-    }
+  If the output file doesn't exist, it will be created
+*/
+int main(int argc, char **argv)
+{
+  dfaLanguage language;
+  initPythonLanguage(&language);
+
+  // initialization of tables (definition on tables.c)
+  scanTables *tables = initScanTables(0);
+  paradigmScan scan = {tables->tokens, 0, 0};
+
+  // FILE *fileptr = fopen("tests/t.py", "r");
+  if (!scanPythonFile(argv[1], &language, &scan))
+  {
+    fprintf(stderr, "%s: can't be opened\n", argv[1]);
+    return 1;
   }
   // FILE *file = fopen(argv[2], "w");
 
-  if (pp && oop)
+  if (scan.pp && scan.oop)
     printf("\nParadigm: MIXED");
-  else if (pp)
+  else if (scan.pp)
     printf("\nParadigm: PP");
   else
     printf("\nParadigm: OOP");
-}
\ No newline at end of file
+}
+#endif
@@ -1,70 +1,66 @@
 #include <stdio.h>
 #include <string.h>
 #include "tables.c"
+#include "source.c"
+#include "dfa.h"
+#include "tokfile.h"
+#include "keywords_tables.h"
+#include "scanner.h"
 
-#define BUFFER_SIZE 128
 #define START_FINAL_STATES 12
 #define FAIL_STATE 19
 #define STATE_TOKENID_DIFFERENCE 9
+#define SYMBOLS 17
 
 /*
-  maps the ASCII values of the DFA alphabet to their respective index
+  maps the bytes of the DFA alphabet to their respective index
 
-  @charToIndex: pointer to the array where the values will be mapped
+  @classOf: pointer to the array where the values will be mapped, one entry per byte
+
+  bytes outside of ASCII are out of the alphabet here, the DFA engine reads the
+  ones in well-formed UTF-8 sequences as letters instead
 
   Return: none
 */
-void mapSymbols(int charToIndex[128])
+void mapSymbols(uint8_t classOf[256])
 {
   // any characters out of the alphabet
-  for (int i = 0; i < 128; i++)
-    charToIndex[i] = 16;
+  for (int i = 0; i < 256; i++)
+    classOf[i] = 16;
 
   // A-Z
-  for (int i = 'A'; i < 'Z'; i++)
-    charToIndex[i] = 3;
+  for (int i = 'A'; i <= 'Z'; i++)
+    classOf[i] = 3;
 
   // a-z
-  for (int i = 'a'; i < 'z'; i++)
-    charToIndex[i] = 3;
+  for (int i = 'a'; i <= 'z'; i++)
+    classOf[i] = 3;
 
   // 0-9
-  for (int i = '0'; i < '9'; i++)
-    charToIndex[i] = 4;
+  for (int i = '0'; i <= '9'; i++)
+    classOf[i] = 4;
 
   // special characters
-  charToIndex['_'] = 5;
-  charToIndex['('] = 6;
-  charToIndex[')'] = 7;
-  charToIndex['{'] = 8;
-  charToIndex['}'] = 9;
+  classOf['_'] = 5;
+  classOf['('] = 6;
+  classOf[')'] = 7;
+  classOf['{'] = 8;
+  classOf['}'] = 9;
 
   // ignoring strings
-  charToIndex['"'] = 10;
-  charToIndex['\''] = 11;
-  charToIndex['`'] = 12;
+  classOf['"'] = 10;
+  classOf['\''] = 11;
+  classOf['`'] = 12;
 
   // space delimiters
-  charToIndex[' '] = 0;
-  charToIndex['\n'] = 1;
-  charToIndex['\t'] = 2;
+  classOf[' '] = 0;
+  classOf['\n'] = 1;
+  classOf['\t'] = 2;
 
   // comments
-  charToIndex['/'] = 13;
-  charToIndex['*'] = 14;
-  charToIndex['#'] = 15;
-
-  /*
-    special case for EOF, as some languages like python
-    it's possible there is no delimiter between a lexeme and EOF
-
-    e.g.
-    a = b + c
-            ^
-            |
-    this is valid final line in python, there is no delimiter
-  */
-  charToIndex[EOF] = 0;
+  classOf['/'] = 13;
+  classOf['*'] = 14;
+  classOf['#'] = 15;
 }
 
 /*
@@ -81,82 +77,46 @@ void mapSymbols(int charToIndex[128])
 */
 int advance(int state, char ch)
 {
-  return ch != EOF && (state != 17) && (state != 18) &&
+  return (state != 17) && (state != 18) &&
          (state != START_FINAL_STATES ||
           (state == START_FINAL_STATES && ch == ' ')) &&
          !(state == 19 && ch == '\n');
 }
 
-/*
-  Determines if a state is accepted
-
-  @state: current state
-
-  states 12-17 are accepted
-
-  Return: 1 if it is accepted, 0 if not
-*/
-int accept(int state)
-{
-  return state >= START_FINAL_STATES && state < FAIL_STATE;
-}
-
 /*
   Determines if a character should be stored in the buffer
 
   @state: current state
   @ch: current character value
-  @len: current buffer length
 
   characters that will be relevant later on are stored in the buffer, such as unrecognized chars for
   error messages or an identifier for the symbol table
-  stops buffering if the lexeme is over 128 chars
+  the lexer stops buffering once the lexeme is over DFA_BUFFER_SIZE chars, comments included
 
   Return: 1 if it should buffer it, 0 if not
 */
-int shouldBuffer(int state, char ch, int len)
+int shouldBuffer(int state, char ch)
 {
-  return len < BUFFER_SIZE - 1 && ch != '\n' &&
-             (state != 10 && state != 11) &&
-             (state != START_FINAL_STATES) ||
-         ((state == 5 || state == 6 || state == 9));
+  return (ch != '\n' &&
+          (state != 10 && state != 11) &&
+          (state != START_FINAL_STATES)) ||
+         (state == 5 || state == 6 || state == 9);
 }
 
 /*
   Gets the token id for a identifier or reserved word
 
-  @buffer: buffer that stores the lexeme
+  @lexeme: start of the lexeme, doesn't need to be null terminated
+  @length: length of the lexeme
 
-  Return: token id
-*/
-int getWordId(char *buffer)
-{
-  int id = 0;
-  if (!strcmp(buffer, "class"))
-    id = 1;
-  else if (!strcmp(buffer, "def"))
-    id = 2;
-  else if (!strcmp(buffer, "main"))
-    id = 3;
-  return id;
-}
-
-/*
-  Gets the token id based on the state
+  reserved words are looked up in the perfect hash of keywords_tables.h
+  (generated from keywords.spec)
 
-  @state: final state
-  @buffer: buffer that stores the lexeme
-
-  Return: token id
+  Return: token id, 0 for identifiers
 */
-int getTokenId(int state, char *buffer)
+int getWordId(const char *lexeme, size_t length)
 {
-  int id;
-  if (state == START_FINAL_STATES)
-    id = getWordId(buffer);
-  else
-    id = state - STATE_TOKENID_DIFFERENCE;
-  return id;
+  return keywordsLookup(lexeme, length);
 }
 
 /*
@@ -169,111 +129,418 @@ int getTokenId(int state, char *buffer)
 
   Return: none
 */
-void saveToFile(char *filename, tokenTable *tokens, charTable *identifiers, charTable *errors)
+void saveToFile(char *filename, tokenStream *tokens, symbolTable *identifiers, charTable *errors)
 {
   FILE *file = fopen(filename, "w");
 
   fprintf(file, "Tokens:\n");
-  for (int i = 0; i < tokens->position; i++)
-    fprintf(file, "<%d, %d>\n", tokens->tokens[i][0], tokens->tokens[i][1]);
+  for (size_t i = 0; i < tokens->count; i++)
+    fprintf(file, "<%d, %d>\n", tokens->ids[i], tokens->symbols[i]);
 
+  // one row per distinct identifier, with its number of occurrences
   fprintf(file, "\nSymbols:\n");
   for (int i = 0; i < identifiers->position; i++)
-    fprintf(file, "%d: %s\n", i, identifiers->symbols[i]);
+    fprintf(file, "%d: %s (%zu)\n", i, symbolName(identifiers, i), identifiers->entries[i].count);
 
   fprintf(file, "\nErrors:");
   for (int i = 0; i < errors->position; i++)
-    fprintf(file, "\nLexeme %s not recognized", errors->symbols[i]);
+  {
+    fprintf(file, "\nLexeme ");
+    writeLexeme(file, errors, i);
+    fprintf(file, " not recognized");
+  }
+  fclose(file);
+}
+
+static const int transitionTable[12][17] = {
+    {19, 10, 19, 1, 19, 1, 13, 14, 15, 16, 2, 3, 4, 5, 19, 9, 19},
+    {12, 12, 12, 1, 1, 1, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12},
+    {2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 19, 2, 2, 2, 2, 2, 2},
+    {3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 19, 3, 3, 3, 3, 3},
+    {4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 19, 4, 4, 4, 4},
+    {19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 6, 7, 19, 19},
+    {6, 19, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6},
+    {7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 8, 7, 7},
+    {7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 19, 7, 7, 7},
+    {9, 19, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9},
+    {11, 10, 11, 18, 19, 18, 13, 14, 15, 16, 2, 3, 4, 5, 19, 9, 19},
+    {11, 10, 11, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 5, 17, 9, 17},
+};
+
+/*
+  Describes the language of the scanner for the DFA engine (dfa.h)
+
+  @language: descriptor to be filled
+
+  EOF is processed as a space, as some languages like python
+  it's possible there is no delimiter between a lexeme and EOF
+
+  e.g.
+  a = b + c
+          ^
+          |
+  this is valid final line in python, there is no delimiter
+
+  Return: none
+*/
+void initScannerLanguage(dfaLanguage *language)
+{
+  initDfaLanguage(language, SYMBOLS, START_FINAL_STATES, FAIL_STATE);
+  for (int state = 0; state < START_FINAL_STATES; state++)
+    for (int symbol = 0; symbol < SYMBOLS; symbol++)
+      language->next[state][symbol] = transitionTable[state][symbol];
+  mapSymbols(language->classOf);
+  // letters in any script can start and continue identifiers
+  language->utf8Symbol = 3;
+  language->eofSymbol = 0;
+
+  // identifiers and reserved words share the first final state
+  language->tokens[START_FINAL_STATES] = DFA_KEYWORD;
+  for (int state = START_FINAL_STATES + 1; state < FAIL_STATE; state++)
+    language->tokens[state] = state - STATE_TOKENID_DIFFERENCE;
+  language->keyword = getWordId;
+
+  dfaDeriveActions(language, advance, shouldBuffer);
+  dfaBuildSkipTable(language);
+}
+
+/*
+  Callback that stores the lexemes in the scanner tables
+
+  @context: scanTables to be filled
+
+  errors are stored as views when the error table has the source attached
+  (the lexeme points into it), as copies otherwise
+
+  Return: none
+*/
+void recordScanned(void *context, int tokenId, const char *lexeme, size_t length, size_t offset, size_t line)
+{
+  scanTables *tables = context;
+  if (tokenId == DFA_ERROR)
+  {
+    if (tables->errors->source)
+      recordView(tables->errors, offset, length);
+    else
+      recordLexeme(tables->errors, (char *)lexeme);
+  }
+  else
+    recordToken(tables->tokens, tokenId, tokenId == 0 ? internLexeme(tables->identifiers, lexeme, length) : -1,
+                offset, line);
+}
+
+/*
+  Scans a whole input buffer in place (see dfaScanRange)
+
+  @language: descriptor of the scanner language
+  @source: input buffer
+  @skip: 1 to jump over strings and comments with findByte, 0 for the per-byte DFA walk
+  @tables: tables to be filled, errors must have the source attached
+
+  lexemes are stored as (offset, length) views into the source instead of being
+  copied
+
+  Return: none
+*/
+void scanSource(const dfaLanguage *language, const sourceBuffer *source, int skip, scanTables *tables)
+{
+  dfaCursor cursor = {0, 0, 0, 0, 0, 0};
+  dfaScanRange(language, source->data, source->length, skip, &cursor, source->length, recordScanned, tables);
+}
+
+/*
+  Writes the result as a binary token file (see tokfile.h)
+
+  @filename: name of the output file
+  @tables: tables filled by the scan
+
+  the whole file is laid out in one buffer from the tables' arena and written
+  with a single call
+
+  Return: none
+*/
+void saveToBinary(char *filename, scanTables *tables)
+{
+  tokenStream *tokens = tables->tokens;
+  symbolTable *identifiers = tables->identifiers;
+  charTable *errors = tables->errors;
+
+  size_t errorTextLength = 0;
+  for (size_t i = 0; i < errors->position; i++)
+    errorTextLength += copyLexeme(errors, i, NULL);
+
+  tokfileHeader header;
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, TOKFILE_MAGIC, 4);
+  header.version = TOKFILE_VERSION;
+
+  uint64_t offset = tokfileAlign(sizeof(header));
+  tokfileSection *sections[] = {&header.tokenIds, &header.tokenSymbols, &header.offsetDeltas,
+                                &header.lineDeltas, &header.checkpoints, &header.symbols,
+                                &header.symbolText, &header.errors, &header.errorText};
+  uint64_t counts[] = {tokens->count, tokens->count, tokens->count,
+                       tokens->count, tokens->checkpointCount, identifiers->position,
+                       identifiers->textLength, errors->position, errorTextLength};
+  size_t sizes[] = {sizeof(uint8_t), sizeof(int32_t), sizeof(uint8_t),
+                    sizeof(uint8_t), sizeof(tokenCheckpoint), sizeof(tokfileSymbol),
+                    1, sizeof(tokfileLexeme), 1};
+  for (int i = 0; i < 9; i++)
+  {
+    sections[i]->offset = offset;
+    sections[i]->count = counts[i];
+    offset = tokfileAlign(offset + counts[i] * sizes[i]);
+  }
+
+  char *file = arenaAlloc(tables->arena, offset);
+  memset(file, 0, offset);
+  memcpy(file, &header, sizeof(header));
+
+  // the columns are written as they are in memory
+  memcpy(file + header.tokenIds.offset, tokens->ids, tokens->count);
+  memcpy(file + header.tokenSymbols.offset, tokens->symbols, tokens->count * sizeof(int32_t));
+  memcpy(file + header.offsetDeltas.offset, tokens->offsetDeltas, tokens->count);
+  memcpy(file + header.lineDeltas.offset, tokens->lineDeltas, tokens->count);
+  memcpy(file + header.checkpoints.offset, tokens->checkpoints, tokens->checkpointCount * sizeof(tokenCheckpoint));
+
+  tokfileSymbol *symbols = (tokfileSymbol *)(file + header.symbols.offset);
+  for (size_t i = 0; i < identifiers->position; i++)
+  {
+    symbols[i].offset = identifiers->entries[i].offset;
+    symbols[i].length = identifiers->entries[i].length;
+    symbols[i].count = identifiers->entries[i].count;
+  }
+  memcpy(file + header.symbolText.offset, identifiers->text, identifiers->textLength);
+
+  tokfileLexeme *lexemes = (tokfileLexeme *)(file + header.errors.offset);
+  char *errorText = file + header.errorText.offset;
+  size_t errorOffset = 0;
+  for (size_t i = 0; i < errors->position; i++)
+  {
+    lexemes[i].offset = errorOffset;
+    lexemes[i].length = copyLexeme(errors, i, errorText + errorOffset);
+    errorOffset += lexemes[i].length;
+  }
+
+  FILE *output = fopen(filename, "wb");
+  fwrite(file, 1, offset, output);
+  fclose(output);
+}
+
+/*
+  Writes the result in the format picked by the output name
+
+  @filename: name of the output file, binary when it ends in .tok
+  @tables: tables filled by the scan
+
+  Return: none
+*/
+void saveResult(char *filename, scanTables *tables)
+{
+  size_t length = strlen(filename);
+  if (length > 4 && !strcmp(filename + length - 4, ".tok"))
+    saveToBinary(filename, tables);
+  else
+    saveToFile(filename, tables->tokens, tables->identifiers, tables->errors);
+}
+
+#define STREAM_BLOCK_SIZE (1 << 16)
+
+/*
+  Scans a stream in blocks through the push lexer of dfa.h
+
+  @fileptr: input stream, can be a pipe or stdin
+  @language: descriptor of the scanner language
+  @tables: tables to be filled
+
+  Return: none
+*/
+void scanStream(FILE *fileptr, const dfaLanguage *language, scanTables *tables)
+{
+  dfaLexer lexer;
+  initDfaLexer(&lexer, language, recordScanned, tables);
+
+  char block[STREAM_BLOCK_SIZE];
+  size_t got;
+  while ((got = fread(block, 1, sizeof(block), fileptr)) > 0)
+    dfaFeed(&lexer, block, got);
+  dfaFinish(&lexer);
+}
+
+// multithreaded scan, built on dfaScanRange
+#include "parallel.c"
+
+static dfaLanguage scannerLanguage;
+static pthread_once_t scannerLanguageOnce = PTHREAD_ONCE_INIT;
+
+// builds scannerLanguage, run once by pthread_once
+static void buildScannerLanguage(void)
+{
+  initScannerLanguage(&scannerLanguage);
+}
+
+/*
+  Gets the language of the scanner, built by the first call and shared by
+  every later one, from any thread (batch mode scans on a pool)
+
+  Return: the language, read only
+*/
+const dfaLanguage *getScannerLanguage(void)
+{
+  pthread_once(&scannerLanguageOnce, buildScannerLanguage);
+  return &scannerLanguage;
 }
 
+/*
+  Scans an input that is already in memory, e.g. a snippet received by a service
+
+  @data: start of the input, doesn't need to be null terminated
+  @length: length of the input
+  @tables: tables to be filled, they are reset first so their memory is reused
+
+  the errors are views into data, they stay valid as long as data does
+
+  Return: none
+*/
+void scanBuffer(const char *data, size_t length, scanTables *tables)
+{
+  sourceBuffer source = {data, length, 0};
+  resetScanTables(tables, length);
+  attachSource(tables->errors, data);
+  scanSource(getScannerLanguage(), &source, 1, tables);
+}
+
+/*
+  Scans a file into the tables, memory-mapping it when possible
+
+  @filename: name of the input
+  @tables: tables to be filled, they are reset first
+
+  Return: 1 on success, 0 if the file can't be opened
+*/
+int scanFile(const char *filename, scanTables *tables)
+{
+  sourceBuffer source;
+  if (openSource(filename, &source))
+  {
+    scanBuffer(source.data, source.length, tables);
+    // the error views point into the source, which is released below
+    charTable *errors = initCharTable(tables->arena, tables->errors->position);
+    for (size_t i = 0; i < tables->errors->position; i++)
+    {
+      char *lexeme = arenaAlloc(tables->arena, copyLexeme(tables->errors, i, NULL) + 1);
+      lexeme[copyLexeme(tables->errors, i, lexeme)] = '\0';
+      recordLexeme(errors, lexeme);
+    }
+    tables->errors = errors;
+    closeSource(&source);
+    return 1;
+  }
+
+  FILE *fileptr = fopen(filename, "r");
+  if (!fileptr)
+    return 0;
+  resetScanTables(tables, 0);
+  scanStream(fileptr, getScannerLanguage(), tables);
+  fclose(fileptr);
+  return 1;
+}
+
+/*
+  Gets the counts of a finished scan
+
+  @tables: tables filled by the scan
+  @summary: counts to be filled
+
+  Return: none
+*/
+void summarizeScan(scanTables *tables, scanSummary *summary)
+{
+  summary->tokens = tables->tokens->count;
+  summary->symbols = tables->identifiers->position;
+  summary->errors = tables->errors->position;
+  summary->stream = tokenStreamSpan(tables->tokens);
+}
+
+// incremental rescan after edits, built on dfaScanRange
+#include "incremental.c"
+
+#ifndef SCANNER_NO_MAIN
 /*
   Main method
 
-  @argv[0]: filename of the input
-  @argv[1]: filename of the output
+  @argv[1..]: optional flags
+    "-s" logs the allocation statistics of every file to stderr
+    "-j N" scans each memory-mapped file with N threads
+  @argv[i]: filename of an input, "-" reads from stdin
+  @argv[i + 1]: filename of its output, binary token file (tokfile.h) if it ends in .tok
 
+  Any number of input/output pairs can be given, the tables are reset between
+  files so each one reuses the memory of the previous one
+  Regular files are memory-mapped and scanned in place, anything else
+  (pipes, stdin) goes through the stream path
   If the output file doesn't exist, it will be created
 */
 int main(int argc, char **argv)
 {
-  static const int transitionTable[12][17] = {
-      {19, 10, 19, 1, 19, 1, 13, 14, 15, 16, 2, 3, 4, 5, 19, 9, 19},
-      {12, 12, 12, 1, 1, 1, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12},
-      {2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 19, 2, 2, 2, 2, 2, 2},
-      {3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 19, 3, 3, 3, 3, 3},
-      {4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 19, 4, 4, 4, 4},
-      {19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 6, 7, 19, 19},
-      {6, 19, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6},
-      {7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 8, 7, 7},
-      {7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 19, 7, 7, 7},
-      {9, 19, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9},
-      {11, 10, 11, 18, 19, 18, 13, 14, 15, 16, 2, 3, 4, 5, 19, 9, 19},
-      {11, 10, 11, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, 5, 17, 9, 17},
-  };
-
-  int charToIndex[128];
-  mapSymbols(charToIndex);
-
-  // initialization of tables (definition on tables.c)
-  tokenTable *tokens = initTokenTable();
-  charTable *identifiers = initCharTable();
-  charTable *errors = initCharTable();
-
-  // buffer to temporarily store lexemes
-  char buffer[BUFFER_SIZE];
-  int bufferLen;
-
-  int state;
-  char ch;
-  int tokenid;
-  FILE *fileptr = fopen(argv[1], "r");
-  ch = fgetc(fileptr);
-  int charVal = charToIndex[ch];
-  int symbolIndex;
-
-  /*
-    DFA simulation
-    based on the pseudocode from:
-      R. Castelló, Class Lecture, Topic: “Chapter 2 – Lexical Analysis.” TC3002,
-      School of Engineering and Science, ITESM, Zapopan, Jalisco, April, 2025.
-  */
-  while (ch != EOF)
+  dfaLanguage language;
+  initScannerLanguage(&language);
+
+  int stats = 0;
+  int threads = 1;
+  int i = 1;
+  for (; i < argc && argv[i][0] == '-' && argv[i][1]; i++)
   {
-    state = 0;
-    bufferLen = 0;
+    if (!strcmp(argv[i], "-s"))
+      stats = 1;
+    else if (!strcmp(argv[i], "-j") && i + 1 < argc)
+      threads = atoi(argv[++i]);
+  }
+  if (threads < 1)
+    threads = 1;
 
-    // states >= 11 are final
-    while (state < START_FINAL_STATES)
+  scanTables *tables = NULL;
+
+  for (; i + 1 < argc; i += 2)
+  {
+    sourceBuffer source;
+    int mapped = strcmp(argv[i], "-") && openSource(argv[i], &source);
+    size_t length = mapped ? source.length : 0;
+
+    // initialization of tables (definition on tables.c)
+    if (tables)
+      resetScanTables(tables, length);
+    else
+      tables = initScanTables(length);
+
+    if (mapped)
+    {
+      attachSource(tables->errors, source.data);
+      if (threads > 1)
+        scanParallel(&language, &source, 1, threads, tables);
+      else
+        scanSource(&language, &source, 1, tables);
+      saveResult(argv[i + 1], tables);
+      closeSource(&source);
+    }
+    else
     {
-      state = transitionTable[state][charVal];
-      if (shouldBuffer(state, ch, bufferLen))
-        buffer[bufferLen++] = ch;
-      if (advance(state, ch))
+      FILE *fileptr = strcmp(argv[i], "-") ? fopen(argv[i], "r") : stdin;
+      if (!fileptr)
       {
-        ch = fgetc(fileptr);
-        charVal = charToIndex[ch];
+        fprintf(stderr, "%s: can't be opened\n", argv[i]);
+        continue;
       }
+      scanStream(fileptr, &language, tables);
+      saveResult(argv[i + 1], tables);
+      if (fileptr != stdin)
+        fclose(fileptr);
     }
-    // adding an end of string to the buffer
-    buffer[bufferLen] = '\0';
-    if (accept(state))
-    {
-      tokenid = getTokenId(state, buffer);
 
-      // if it is an identifier, add it to the symbol table and get the index
-      // if not, use -1
-      if (tokenid == 0)
-        symbolIndex = recordLexeme(identifiers, buffer);
-      else
-        symbolIndex = -1;
-
-      recordToken(tokens, tokenid, symbolIndex);
-    }
-    else
+    if (stats)
     {
-      buffer[bufferLen] = '\0';
-      recordLexeme(errors, buffer);
+      fprintf(stderr, "%s: ", argv[i]);
+      printArenaStats(stderr, tables->arena);
     }
   }
-  saveToFile(argv[2], tokens, identifiers, errors);
-}
\ No newline at end of file
+}
+#endif
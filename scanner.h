@@ -0,0 +1,87 @@
+#ifndef SCANNER_H
+#define SCANNER_H
+
+/*
+  Entry points of scanner.c for code that links it instead of including it,
+  e.g. C++ tools (build scanner.c as C with -DSCANNER_NO_MAIN)
+*/
+
+#include <stddef.h>
+#include "tokenstream.h"
+
+#if defined(__cplusplus) && __cplusplus >= 201703L
+#include <string_view>
+#endif
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+  typedef struct scanTables scanTables;
+
+  /*
+    Counts of a finished scan
+
+    @stream: view of the token stream, valid until the tables are reset
+  */
+  struct scanSummary
+  {
+    size_t tokens;
+    size_t symbols;
+    size_t errors;
+    tokenSpan stream;
+  };
+  typedef struct scanSummary scanSummary;
+
+  scanTables *initScanTables(size_t sourceLength);
+  void freeScanTables(scanTables *tables);
+  void scanBuffer(const char *data, size_t length, scanTables *tables);
+  int scanFile(const char *filename, scanTables *tables);
+  void summarizeScan(scanTables *tables, scanSummary *summary);
+
+  typedef struct liveScan liveScan;
+
+  /*
+    What an edit rescanned
+
+    @firstToken: index of the first token that was replaced
+    @removedTokens, @insertedTokens: tokens taken out and put in at firstToken
+    @rescannedBytes: bytes of the new text the DFA went through
+  */
+  struct scanEdit
+  {
+    size_t firstToken;
+    size_t removedTokens;
+    size_t insertedTokens;
+    size_t rescannedBytes;
+  };
+  typedef struct scanEdit scanEdit;
+
+  liveScan *initLiveScan(const char *data, size_t length);
+  void editLiveScan(liveScan *scan, const char *data, size_t length, size_t editStart, size_t oldEnd, size_t newEnd,
+                    scanEdit *edit);
+  const char *liveParadigm(liveScan *scan);
+  void summarizeLiveScan(liveScan *scan, scanSummary *summary);
+  void freeLiveScan(liveScan *scan);
+
+#ifdef __cplusplus
+}
+#endif
+
+#if defined(__cplusplus) && __cplusplus >= 201703L
+/*
+  Scans a snippet in memory, the errors are views into it (see scanBuffer)
+
+  @code: input
+  @tables: tables to be filled, reused across calls
+
+  Return: none
+*/
+inline void scanBuffer(std::string_view code, scanTables *tables)
+{
+  scanBuffer(code.data(), code.size(), tables);
+}
+#endif
+
+#endif
@@ -0,0 +1,111 @@
+#include <fcntl.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define SOURCE_BLOCK_SIZE (1 << 20)
+#define SOURCE_ALIGNMENT 64
+
+/*
+  Whole input file as a single contiguous buffer, either memory-mapped or
+  read in large aligned blocks when the file can't be mapped
+*/
+struct sourceBuffer
+{
+  const char *data;
+  size_t length;
+  int mapped;
+};
+typedef struct sourceBuffer sourceBuffer;
+
+/*
+  Reads a regular file in SOURCE_BLOCK_SIZE blocks into an aligned buffer
+
+  @fd: open file descriptor
+  @length: file length reported by fstat
+  @source: buffer to be filled
+
+  Return: 1 on success, 0 if the file couldn't be read
+*/
+int readSource(int fd, size_t length, sourceBuffer *source)
+{
+  void *data;
+  if (posix_memalign(&data, SOURCE_ALIGNMENT, length))
+    return 0;
+
+  size_t total = 0;
+  while (total < length)
+  {
+    size_t block = length - total < SOURCE_BLOCK_SIZE ? length - total : SOURCE_BLOCK_SIZE;
+    ssize_t got = read(fd, (char *)data + total, block);
+    if (got <= 0)
+      break;
+    total += got;
+  }
+
+  source->data = data;
+  source->length = total;
+  source->mapped = 0;
+  return 1;
+}
+
+/*
+  Opens an input file as a contiguous buffer
+
+  @filename: name of the input file
+  @source: buffer to be filled
+
+  only non-empty regular files are supported, pipes and stdin have to go through the
+  stream (fgetc) path instead
+
+  Return: 1 if the buffer is ready, 0 if the caller should fall back to a stream
+*/
+int openSource(const char *filename, sourceBuffer *source)
+{
+  int fd = open(filename, O_RDONLY);
+  if (fd < 0)
+    return 0;
+
+  struct stat info;
+  if (fstat(fd, &info) || !S_ISREG(info.st_mode) || info.st_size == 0)
+  {
+    close(fd);
+    return 0;
+  }
+
+  size_t length = info.st_size;
+  void *data = mmap(NULL, length, PROT_READ, MAP_PRIVATE, fd, 0);
+  int ok;
+  if (data != MAP_FAILED)
+  {
+    madvise(data, length, MADV_SEQUENTIAL);
+    source->data = data;
+    source->length = length;
+    source->mapped = 1;
+    ok = 1;
+  }
+  else
+    ok = readSource(fd, length, source);
+
+  close(fd);
+  return ok;
+}
+
+/*
+  Releases a buffer opened with openSource
+
+  @source: buffer to be released
+
+  Return: none
+*/
+void closeSource(sourceBuffer *source)
+{
+  if (source->mapped)
+    munmap((void *)source->data, source->length);
+  else
+    free((void *)source->data);
+
+  source->data = NULL;
+  source->length = 0;
+}
@@ -1,75 +1,105 @@
 #include <string.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include "arena.c"
+#include "tokenstream.h"
 
 #define DEFAULT_SIZE 50
 
-struct tokenTable
-{
-  size_t position;
-  size_t size;
-  int (*tokens)[2];
-};
-typedef struct tokenTable tokenTable;
+// expected bytes of source per entry, used to size the tables up front
+#define BYTES_PER_TOKEN 6
+#define BYTES_PER_SYMBOL 64
+#define BYTES_PER_ERROR 32
+
+/*
+  Gets the initial size of a table
 
-tokenTable *initTokenTable()
+  @sizeHint: expected number of entries, 0 if unknown
+
+  Return: number of entries
+*/
+size_t tableSize(size_t sizeHint)
 {
-  tokenTable *table = malloc(sizeof(tokenTable));
+  return sizeHint > DEFAULT_SIZE ? sizeHint : DEFAULT_SIZE;
+}
 
-  table->position = 0;
-  table->size = DEFAULT_SIZE;
+/*
+  Grow function of the token stream (see tokenGrowFunction) over an arena
 
-  table->tokens = malloc(table->size * sizeof(int[2]));
+  @allocator: arena to be used
 
-  return table;
+  Return: pointer to the allocation, NULL when it is released
+*/
+void *growFromArena(void *allocator, void *memory, size_t oldSize, size_t newSize)
+{
+  // released along with the arena
+  if (!newSize)
+    return NULL;
+  if (!memory)
+    return arenaAlloc(allocator, newSize);
+  return arenaGrow(allocator, memory, oldSize, newSize);
 }
 
 /*
-  Saves an entry in the token table
-
-  @tokenTable: token table
-  @id: token id to be stored
-  @symbolEntry: index of the entry in the symbol table
+  Creates the token table, a token stream (tokenstream.h) whose columns come
+  from the arena like every other table, so they are all released at once
+  when the arena is reset
 
-  if the table has reached its size limit, it doubles in capacity
+  @arena: arena to be used
+  @sizeHint: expected number of tokens, 0 if unknown
 
-  Return: none
+  Return: empty token stream
 */
-void recordToken(tokenTable *tokenTable, int tokenId, int symbolEntry)
+tokenStream *initTokenTable(arena *arena, size_t sizeHint)
 {
-  if (tokenTable->position >= tokenTable->size)
-  {
-    tokenTable->size *= 2;
-    int (*newTokens)[2] = realloc(tokenTable->tokens, tokenTable->size * sizeof(int[2]));
-    tokenTable->tokens = newTokens;
-  }
-
-  tokenTable->tokens[tokenTable->position][0] = tokenId;
-  tokenTable->tokens[tokenTable->position][1] = symbolEntry;
-  tokenTable->position++;
+  tokenStream *table = arenaAlloc(arena, sizeof(tokenStream));
+  initTokenStream(table, tableSize(sizeHint), growFromArena, arena);
+  return table;
 }
 
 /*
   This struct is used for both the symbol table and the errors table
+
+  when source is set, entries are (offset, length) views into it instead of copies
 */
 struct charTable
 {
   size_t position;
   size_t size;
   char **symbols;
+  const char *source;
+  size_t (*views)[2];
+  arena *arena;
 };
 typedef struct charTable charTable;
 
-charTable *initCharTable()
+charTable *initCharTable(arena *arena, size_t sizeHint)
 {
-  charTable *table = malloc(sizeof(charTable));
+  charTable *table = arenaAlloc(arena, sizeof(charTable));
+  table->arena = arena;
   table->position = 0;
-  table->size = DEFAULT_SIZE;
-  table->symbols = malloc(table->size * sizeof(char *));
+  table->size = tableSize(sizeHint);
+  table->symbols = NULL;
+  table->source = NULL;
+  table->views = NULL;
 
   return table;
 }
 
+/*
+  Switches a table to store views into a source buffer instead of copies
+
+  @charTable: table to be used, must be empty
+  @source: buffer the views will point into
+
+  Return: none
+*/
+void attachSource(charTable *charTable, const char *source)
+{
+  charTable->source = source;
+  charTable->views = arenaAlloc(charTable->arena, charTable->size * sizeof(size_t[2]));
+}
+
 /*
   Saves an entry in the symbol or the errors table
 
@@ -82,15 +112,367 @@ charTable *initCharTable()
 */
 int recordLexeme(charTable *charTable, char *buffer)
 {
+  if (!charTable->symbols)
+    charTable->symbols = arenaAlloc(charTable->arena, charTable->size * sizeof(char *));
 
   if (charTable->position >= charTable->size)
   {
+    char **newSymbols = arenaGrow(charTable->arena, charTable->symbols,
+                                  charTable->size * sizeof(char *), charTable->size * 2 * sizeof(char *));
     charTable->size *= 2;
-    char **newSymbols = realloc(charTable->symbols, charTable->size * sizeof(char *));
     charTable->symbols = newSymbols;
   }
 
-  charTable->symbols[charTable->position] = strdup(buffer);
+  size_t length = strlen(buffer);
+  char *copy = arenaAlloc(charTable->arena, length + 1);
+  memcpy(copy, buffer, length + 1);
+  charTable->symbols[charTable->position] = copy;
+
+  return charTable->position++;
+}
+
+/*
+  Saves a view of the source buffer in the symbol or the errors table
+
+  @charTable: table to be used, must have a source attached
+  @offset: offset of the lexeme in the source buffer
+  @length: length of the lexeme
+
+  if the table has reached its size limit, it doubles in capacity
+
+  Return: index of the entry
+*/
+int recordView(charTable *charTable, size_t offset, size_t length)
+{
+  if (charTable->position >= charTable->size)
+  {
+    size_t (*newViews)[2] = arenaGrow(charTable->arena, charTable->views,
+                                      charTable->size * sizeof(size_t[2]), charTable->size * 2 * sizeof(size_t[2]));
+    charTable->size *= 2;
+    charTable->views = newViews;
+  }
+
+  charTable->views[charTable->position][0] = offset;
+  charTable->views[charTable->position][1] = length;
 
   return charTable->position++;
-}
\ No newline at end of file
+}
+
+/*
+  Writes an entry of the symbol or the errors table
+
+  @file: output file
+  @charTable: table to be used
+  @index: index of the entry
+
+  views skip line breaks, the same way the scanner buffer does
+
+  Return: none
+*/
+void writeLexeme(FILE *file, charTable *charTable, size_t index)
+{
+  if (!charTable->source)
+  {
+    fputs(charTable->symbols[index], file);
+    return;
+  }
+
+  const char *lexeme = charTable->source + charTable->views[index][0];
+  size_t length = charTable->views[index][1];
+  for (size_t i = 0; i < length; i++)
+    if (lexeme[i] != '\n')
+      fputc(lexeme[i], file);
+}
+
+/*
+  Copies an entry of the symbol or the errors table
+
+  @charTable: table to be used
+  @index: index of the entry
+  @out: where the lexeme is copied, NULL to only get its length
+
+  views skip line breaks, the same way the scanner buffer does
+
+  Return: length of the lexeme
+*/
+size_t copyLexeme(charTable *charTable, size_t index, char *out)
+{
+  if (!charTable->source)
+  {
+    size_t length = strlen(charTable->symbols[index]);
+    if (out)
+      memcpy(out, charTable->symbols[index], length);
+    return length;
+  }
+
+  const char *lexeme = charTable->source + charTable->views[index][0];
+  size_t length = 0;
+  for (size_t i = 0; i < charTable->views[index][1]; i++)
+    if (lexeme[i] != '\n')
+    {
+      if (out)
+        out[length] = lexeme[i];
+      length++;
+    }
+  return length;
+}
+
+/*
+  Entry of the symbol table, the name lives in the table's text arena
+*/
+struct symbolEntry
+{
+  size_t offset;
+  size_t length;
+  size_t count;
+  unsigned hash;
+};
+typedef struct symbolEntry symbolEntry;
+
+/*
+  Interning symbol table, every distinct identifier is stored once
+
+  @entries: symbols in order of first occurrence, the index is the symbol id
+  @text: names stored contiguously and null terminated
+  @slots: open addressing hash table, holds id + 1 and 0 for empty slots
+*/
+struct symbolTable
+{
+  size_t position;
+  size_t size;
+  symbolEntry *entries;
+  char *text;
+  size_t textLength;
+  size_t textSize;
+  int *slots;
+  size_t slotCount;
+  arena *arena;
+};
+typedef struct symbolTable symbolTable;
+
+symbolTable *initSymbolTable(arena *arena, size_t sizeHint)
+{
+  symbolTable *table = arenaAlloc(arena, sizeof(symbolTable));
+  table->arena = arena;
+
+  table->position = 0;
+  table->size = tableSize(sizeHint);
+  table->entries = arenaAlloc(arena, table->size * sizeof(symbolEntry));
+
+  table->textLength = 0;
+  table->textSize = table->size * 8;
+  table->text = arenaAlloc(arena, table->textSize);
+
+  // power of two at least twice the entries, so the slot is picked with a mask
+  table->slotCount = 128;
+  while (table->slotCount < table->size * 2)
+    table->slotCount *= 2;
+  table->slots = arenaAlloc(arena, table->slotCount * sizeof(int));
+  memset(table->slots, 0, table->slotCount * sizeof(int));
+
+  return table;
+}
+
+/*
+  FNV-1a hash of a lexeme
+
+  @lexeme: start of the lexeme
+  @length: length of the lexeme
+
+  Return: hash value
+*/
+unsigned hashLexeme(const char *lexeme, size_t length)
+{
+  unsigned hash = 2166136261u;
+  for (size_t i = 0; i < length; i++)
+  {
+    hash ^= (unsigned char)lexeme[i];
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+/*
+  Doubles the hash table and reinserts every symbol with its stored hash
+
+  @symbolTable: table to be grown
+
+  Return: none
+*/
+void growSlots(symbolTable *symbolTable)
+{
+  symbolTable->slotCount *= 2;
+  symbolTable->slots = arenaAlloc(symbolTable->arena, symbolTable->slotCount * sizeof(int));
+  memset(symbolTable->slots, 0, symbolTable->slotCount * sizeof(int));
+
+  size_t mask = symbolTable->slotCount - 1;
+  for (size_t id = 0; id < symbolTable->position; id++)
+  {
+    size_t slot = symbolTable->entries[id].hash & mask;
+    while (symbolTable->slots[slot])
+      slot = (slot + 1) & mask;
+    symbolTable->slots[slot] = id + 1;
+  }
+}
+
+/*
+  Gets the id of a lexeme, adding it to the symbol table on its first occurrence
+
+  @symbolTable: table to be used
+  @lexeme: start of the lexeme, doesn't need to be null terminated
+  @length: length of the lexeme
+
+  the hash table is kept at most half full, the entries and the text arena
+  double in capacity when they run out of space
+
+  Return: id of the symbol
+*/
+int internLexeme(symbolTable *symbolTable, const char *lexeme, size_t length)
+{
+  unsigned hash = hashLexeme(lexeme, length);
+  size_t mask = symbolTable->slotCount - 1;
+  size_t slot = hash & mask;
+
+  // linear probing until the symbol or an empty slot shows up
+  while (symbolTable->slots[slot])
+  {
+    int id = symbolTable->slots[slot] - 1;
+    symbolEntry *entry = &symbolTable->entries[id];
+    if (entry->hash == hash && entry->length == length &&
+        !memcmp(symbolTable->text + entry->offset, lexeme, length))
+    {
+      entry->count++;
+      return id;
+    }
+    slot = (slot + 1) & mask;
+  }
+
+  if (symbolTable->position >= symbolTable->size)
+  {
+    symbolEntry *newEntries = arenaGrow(symbolTable->arena, symbolTable->entries,
+                                        symbolTable->size * sizeof(symbolEntry), symbolTable->size * 2 * sizeof(symbolEntry));
+    symbolTable->size *= 2;
+    symbolTable->entries = newEntries;
+  }
+
+  while (symbolTable->textLength + length + 1 > symbolTable->textSize)
+  {
+    char *newText = arenaGrow(symbolTable->arena, symbolTable->text,
+                              symbolTable->textSize, symbolTable->textSize * 2);
+    symbolTable->textSize *= 2;
+    symbolTable->text = newText;
+  }
+
+  int id = symbolTable->position++;
+  symbolEntry *entry = &symbolTable->entries[id];
+  entry->offset = symbolTable->textLength;
+  entry->length = length;
+  entry->count = 1;
+  entry->hash = hash;
+
+  memcpy(symbolTable->text + entry->offset, lexeme, length);
+  symbolTable->text[entry->offset + length] = '\0';
+  symbolTable->textLength += length + 1;
+
+  symbolTable->slots[slot] = id + 1;
+  if (symbolTable->position * 2 > symbolTable->slotCount)
+    growSlots(symbolTable);
+
+  return id;
+}
+
+/*
+  Gets the name of a symbol
+
+  @symbolTable: table to be used
+  @id: id of the symbol
+
+  Return: null terminated name, valid until the next symbol is added
+*/
+const char *symbolName(symbolTable *symbolTable, int id)
+{
+  return symbolTable->text + symbolTable->entries[id].offset;
+}
+
+/*
+  Tables filled by one scan, sharing a single arena
+
+  @arena: arena every table allocates from, reset between scans
+  @tokens: token stream
+  @identifiers: symbol table
+  @errors: error table
+*/
+struct scanTables
+{
+  arena *arena;
+  tokenStream *tokens;
+  symbolTable *identifiers;
+  charTable *errors;
+};
+typedef struct scanTables scanTables;
+
+/*
+  Creates the tables of the next scan out of the arena
+
+  @tables: tables to be filled
+  @sourceLength: length of the input, 0 if unknown
+
+  Return: none
+*/
+void createTables(scanTables *tables, size_t sourceLength)
+{
+  tables->tokens = initTokenTable(tables->arena, sourceLength / BYTES_PER_TOKEN);
+  tables->identifiers = initSymbolTable(tables->arena, sourceLength / BYTES_PER_SYMBOL);
+  tables->errors = initCharTable(tables->arena, sourceLength / BYTES_PER_ERROR);
+}
+
+/*
+  Gets the arena size that fits the tables of an input without growing
+
+  @sourceLength: length of the input, 0 if unknown
+
+  Return: number of bytes
+*/
+size_t tablesSizeHint(size_t sourceLength)
+{
+  size_t tokenCount = tableSize(sourceLength / BYTES_PER_TOKEN);
+  size_t tokens = tokenCount * (3 + sizeof(int32_t)) +
+                  (tokenCount / TOKEN_CHECKPOINT_INTERVAL + 1) * sizeof(tokenCheckpoint);
+  size_t symbols = tableSize(sourceLength / BYTES_PER_SYMBOL) * (sizeof(symbolEntry) + 8 + 4 * sizeof(int));
+  size_t errors = tableSize(sourceLength / BYTES_PER_ERROR) * sizeof(size_t[2]);
+  return tokens + symbols + errors + 4 * ARENA_ALIGNMENT * 8;
+}
+
+scanTables *initScanTables(size_t sourceLength)
+{
+  scanTables *tables = malloc(sizeof(scanTables));
+  tables->arena = initArena(tablesSizeHint(sourceLength));
+  createTables(tables, sourceLength);
+  return tables;
+}
+
+/*
+  Empties the tables for the next input, reusing the memory of the previous one
+
+  @tables: tables to be reset, any pointer into them becomes invalid
+  @sourceLength: length of the next input, 0 if unknown
+
+  Return: none
+*/
+void resetScanTables(scanTables *tables, size_t sourceLength)
+{
+  resetArena(tables->arena, tablesSizeHint(sourceLength));
+  createTables(tables, sourceLength);
+}
+/*
+  Releases the tables and their arena
+
+  @tables: tables to be released
+
+  Return: none
+*/
+void freeScanTables(scanTables *tables)
+{
+  freeArena(tables->arena);
+  free(tables);
+}
@@ -0,0 +1,367 @@
+#ifndef TOKENSTREAM_H
+#define TOKENSTREAM_H
+
+/*
+  Packed token stream shared by the scanners (writers) and the parsers (readers)
+
+  the columns are kept apart, so a parser that only looks at the ids reads one
+  byte per token:
+  - ids: token id
+  - symbols: index in the symbol table, -1 when the token isn't an identifier
+  - offsetDeltas, lineDeltas: byte offset and line of the token minus the ones
+    of the previous token
+  a checkpoint stores the absolute offset and line every
+  TOKEN_CHECKPOINT_INTERVAL tokens and wherever a delta doesn't fit in a byte,
+  so any position is at most TOKEN_CHECKPOINT_INTERVAL - 1 additions away
+
+  usable from C and C++, the memory comes from the grow function the writer
+  picks (an arena in the scanner, realloc elsewhere)
+*/
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#define TOKEN_CHECKPOINT_INTERVAL 64
+#define TOKEN_DEFAULT_SIZE 64
+
+// id read past the last token
+#define TOKEN_END -1
+
+/*
+  Absolute position of a token
+
+  @token: index of the token
+  @line: line number, starting at 1
+*/
+struct tokenCheckpoint
+{
+  uint64_t offset;
+  uint32_t token;
+  uint32_t line;
+};
+typedef struct tokenCheckpoint tokenCheckpoint;
+
+/*
+  Allocates, grows or releases a column
+
+  @allocator: pointer given to initTokenStream
+  @memory: previous allocation, NULL for a new one
+  @oldSize: size of the previous allocation
+  @newSize: size needed, 0 to release the allocation
+
+  Return: pointer to the allocation, NULL when it was released
+*/
+typedef void *(*tokenGrowFunction)(void *allocator, void *memory, size_t oldSize, size_t newSize);
+
+/*
+  Writer side of the stream, owns the columns
+
+  @count: number of tokens
+  @size: capacity of the token columns
+  @lastOffset, @lastLine: position of the last token, the base of the next delta
+*/
+struct tokenStream
+{
+  size_t count;
+  size_t size;
+  uint8_t *ids;
+  int32_t *symbols;
+  uint8_t *offsetDeltas;
+  uint8_t *lineDeltas;
+  size_t checkpointCount;
+  size_t checkpointSize;
+  tokenCheckpoint *checkpoints;
+  uint64_t lastOffset;
+  uint32_t lastLine;
+  tokenGrowFunction grow;
+  void *allocator;
+};
+typedef struct tokenStream tokenStream;
+
+/*
+  Reader side of the stream, doesn't own anything
+
+  built from a tokenStream, a mapped token file (tokfile.h) or a bare id array,
+  the position columns are NULL when the source had no positions
+*/
+struct tokenSpan
+{
+  size_t count;
+  const uint8_t *ids;
+  const int32_t *symbols;
+  const uint8_t *offsetDeltas;
+  const uint8_t *lineDeltas;
+  size_t checkpointCount;
+  const tokenCheckpoint *checkpoints;
+
+#ifdef __cplusplus
+  // token id, TOKEN_END past the last token
+  int operator[](size_t index) const
+  {
+    return index < count ? ids[index] : TOKEN_END;
+  }
+
+  size_t size() const
+  {
+    return count;
+  }
+#endif
+};
+typedef struct tokenSpan tokenSpan;
+
+/*
+  Grow function over malloc/realloc/free
+
+  Return: see tokenGrowFunction
+*/
+static inline void *tokenStreamRealloc(void *allocator, void *memory, size_t oldSize, size_t newSize)
+{
+  (void)allocator;
+  (void)oldSize;
+  if (!newSize)
+  {
+    free(memory);
+    return NULL;
+  }
+  return realloc(memory, newSize);
+}
+
+/*
+  Prepares an empty stream
+
+  @stream: stream to be initialized
+  @sizeHint: expected number of tokens, 0 if unknown
+  @grow: allocation function, tokenStreamRealloc when there is no arena
+  @allocator: pointer passed to grow
+
+  Return: none
+*/
+static inline void initTokenStream(tokenStream *stream, size_t sizeHint, tokenGrowFunction grow, void *allocator)
+{
+  stream->count = 0;
+  stream->size = sizeHint > TOKEN_DEFAULT_SIZE ? sizeHint : TOKEN_DEFAULT_SIZE;
+  stream->grow = grow;
+  stream->allocator = allocator;
+
+  stream->ids = (uint8_t *)grow(allocator, NULL, 0, stream->size);
+  stream->symbols = (int32_t *)grow(allocator, NULL, 0, stream->size * sizeof(int32_t));
+  stream->offsetDeltas = (uint8_t *)grow(allocator, NULL, 0, stream->size);
+  stream->lineDeltas = (uint8_t *)grow(allocator, NULL, 0, stream->size);
+
+  stream->checkpointCount = 0;
+  stream->checkpointSize = stream->size / TOKEN_CHECKPOINT_INTERVAL + 1;
+  stream->checkpoints = (tokenCheckpoint *)grow(allocator, NULL, 0, stream->checkpointSize * sizeof(tokenCheckpoint));
+  stream->lastOffset = 0;
+  stream->lastLine = 0;
+}
+
+/*
+  Doubles the capacity of the token columns
+
+  @stream: stream to be grown
+
+  Return: none
+*/
+static inline void growTokenStream(tokenStream *stream)
+{
+  size_t size = stream->size;
+  stream->ids = (uint8_t *)stream->grow(stream->allocator, stream->ids, size, size * 2);
+  stream->symbols = (int32_t *)stream->grow(stream->allocator, stream->symbols,
+                                            size * sizeof(int32_t), size * 2 * sizeof(int32_t));
+  stream->offsetDeltas = (uint8_t *)stream->grow(stream->allocator, stream->offsetDeltas, size, size * 2);
+  stream->lineDeltas = (uint8_t *)stream->grow(stream->allocator, stream->lineDeltas, size, size * 2);
+  stream->size = size * 2;
+}
+
+/*
+  Appends a token to the stream
+
+  @stream: stream to be used
+  @tokenId: token id, has to fit in a byte
+  @symbolEntry: index of the entry in the symbol table, -1 if it isn't an identifier
+  @offset: byte offset of the lexeme, not lower than the previous token's
+  @line: line of the lexeme, starting at 1
+
+  Return: none
+*/
+static inline void recordToken(tokenStream *stream, int tokenId, int symbolEntry, size_t offset, size_t line)
+{
+  if (stream->count >= stream->size)
+    growTokenStream(stream);
+
+  size_t index = stream->count;
+  uint64_t offsetDelta = offset - stream->lastOffset;
+  uint64_t lineDelta = line - stream->lastLine;
+
+  if (index == 0 || offsetDelta > UINT8_MAX || lineDelta > UINT8_MAX ||
+      index - stream->checkpoints[stream->checkpointCount - 1].token >= TOKEN_CHECKPOINT_INTERVAL)
+  {
+    if (stream->checkpointCount >= stream->checkpointSize)
+    {
+      stream->checkpoints = (tokenCheckpoint *)stream->grow(stream->allocator, stream->checkpoints,
+                                                            stream->checkpointSize * sizeof(tokenCheckpoint),
+                                                            stream->checkpointSize * 2 * sizeof(tokenCheckpoint));
+      stream->checkpointSize *= 2;
+    }
+    tokenCheckpoint *checkpoint = &stream->checkpoints[stream->checkpointCount++];
+    checkpoint->offset = offset;
+    checkpoint->token = (uint32_t)index;
+    checkpoint->line = (uint32_t)line;
+    offsetDelta = lineDelta = 0;
+  }
+
+  stream->ids[index] = (uint8_t)tokenId;
+  stream->symbols[index] = symbolEntry;
+  stream->offsetDeltas[index] = (uint8_t)offsetDelta;
+  stream->lineDeltas[index] = (uint8_t)lineDelta;
+  stream->lastOffset = offset;
+  stream->lastLine = (uint32_t)line;
+  stream->count++;
+}
+
+/*
+  Empties a stream while keeping its capacity, so it can be filled again
+  without allocating
+
+  @stream: stream to be cleared
+
+  Return: none
+*/
+static inline void clearTokenStream(tokenStream *stream)
+{
+  stream->count = 0;
+  stream->checkpointCount = 0;
+  stream->lastOffset = 0;
+  stream->lastLine = 0;
+}
+
+/*
+  Releases the columns of a stream
+
+  @stream: stream to be released
+
+  arena-backed streams are released with their arena, their grow function
+  ignores this call
+
+  Return: none
+*/
+static inline void releaseTokenStream(tokenStream *stream)
+{
+  stream->grow(stream->allocator, stream->ids, stream->size, 0);
+  stream->grow(stream->allocator, stream->symbols, stream->size * sizeof(int32_t), 0);
+  stream->grow(stream->allocator, stream->offsetDeltas, stream->size, 0);
+  stream->grow(stream->allocator, stream->lineDeltas, stream->size, 0);
+  stream->grow(stream->allocator, stream->checkpoints, stream->checkpointSize * sizeof(tokenCheckpoint), 0);
+  stream->count = stream->size = 0;
+}
+
+/*
+  Gets a view of a stream, valid until the stream grows or is released
+
+  @stream: stream to be viewed
+
+  Return: span over the stream
+*/
+static inline tokenSpan tokenStreamSpan(const tokenStream *stream)
+{
+  tokenSpan span;
+  span.count = stream->count;
+  span.ids = stream->ids;
+  span.symbols = stream->symbols;
+  span.offsetDeltas = stream->offsetDeltas;
+  span.lineDeltas = stream->lineDeltas;
+  span.checkpointCount = stream->checkpointCount;
+  span.checkpoints = stream->checkpoints;
+  return span;
+}
+
+/*
+  Gets a view of a bare id array, without symbols or positions
+
+  @ids: token ids
+  @count: number of tokens
+
+  Return: span over the ids
+*/
+static inline tokenSpan tokenSpanOf(const uint8_t *ids, size_t count)
+{
+  tokenSpan span = {count, ids, NULL, NULL, NULL, 0, NULL};
+  return span;
+}
+
+/*
+  Finds the checkpoint a token's position is relative to
+
+  @span: span to be used, must have positions
+  @index: index of the token
+
+  Return: last checkpoint at or before the token
+*/
+static inline const tokenCheckpoint *tokenSpanCheckpoint(const tokenSpan *span, size_t index)
+{
+  size_t low = 0;
+  size_t high = span->checkpointCount;
+  while (high - low > 1)
+  {
+    size_t middle = low + (high - low) / 2;
+    if (span->checkpoints[middle].token <= index)
+      low = middle;
+    else
+      high = middle;
+  }
+  return &span->checkpoints[low];
+}
+
+/*
+  Gets the byte offset of a token
+
+  @span: span to be used
+  @index: index of the token
+
+  Return: offset of the lexeme in the source, 0 if the span has no positions
+*/
+static inline uint64_t tokenSpanOffset(const tokenSpan *span, size_t index)
+{
+  if (!span->checkpointCount || index >= span->count)
+    return 0;
+  const tokenCheckpoint *checkpoint = tokenSpanCheckpoint(span, index);
+  uint64_t offset = checkpoint->offset;
+  for (size_t i = checkpoint->token + 1; i <= index; i++)
+    offset += span->offsetDeltas[i];
+  return offset;
+}
+
+/*
+  Gets the line of a token
+
+  @span: span to be used
+  @index: index of the token
+
+  Return: line number starting at 1, 0 if the span has no positions
+*/
+static inline size_t tokenSpanLine(const tokenSpan *span, size_t index)
+{
+  if (!span->checkpointCount || index >= span->count)
+    return 0;
+  const tokenCheckpoint *checkpoint = tokenSpanCheckpoint(span, index);
+  size_t line = checkpoint->line;
+  for (size_t i = checkpoint->token + 1; i <= index; i++)
+    line += span->lineDeltas[i];
+  return line;
+}
+
+/*
+  Gets the symbol table index of a token
+
+  @span: span to be used
+  @index: index of the token
+
+  Return: symbol index, -1 if it isn't an identifier or the span has no symbols
+*/
+static inline int tokenSpanSymbol(const tokenSpan *span, size_t index)
+{
+  return span->symbols && index < span->count ? span->symbols[index] : -1;
+}
+
+#endif
@@ -0,0 +1,217 @@
+#ifndef TOKFILE_H
+#define TOKFILE_H
+
+/*
+  Binary token stream shared by the scanner (writer) and the parsers (readers)
+
+  layout: header, then every section 8-byte aligned at the offset the header
+  gives, all integers little endian as written by the host
+  the file is meant to be mmapped and used in place, there is no parsing step
+*/
+
+#include <fcntl.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "tokenstream.h"
+
+#define TOKFILE_MAGIC "TOKS"
+#define TOKFILE_VERSION 2
+
+// ids from here on are keywords (keywords.spec) the parser grammars don't use
+#define KEYWORD_TOKEN_BASE 10
+
+/*
+  Position of a section in the file
+
+  @offset: bytes from the start of the file
+  @count: number of elements (bytes for text sections)
+*/
+struct tokfileSection
+{
+  uint64_t offset;
+  uint64_t count;
+};
+typedef struct tokfileSection tokfileSection;
+
+/*
+  Symbol table entry, the name is at offset in the symbol text section
+  and is null terminated
+*/
+struct tokfileSymbol
+{
+  uint64_t offset;
+  uint32_t length;
+  uint32_t count;
+};
+typedef struct tokfileSymbol tokfileSymbol;
+
+/*
+  Error table entry, the lexeme is at offset in the error text section
+*/
+struct tokfileLexeme
+{
+  uint64_t offset;
+  uint64_t length;
+};
+typedef struct tokfileLexeme tokfileLexeme;
+
+struct tokfileHeader
+{
+  char magic[4];
+  uint32_t version;
+  // columns of a tokenStream (tokenstream.h), one element per token
+  tokfileSection tokenIds;
+  tokfileSection tokenSymbols;
+  tokfileSection offsetDeltas;
+  tokfileSection lineDeltas;
+  tokfileSection checkpoints;
+  tokfileSection symbols;
+  tokfileSection symbolText;
+  tokfileSection errors;
+  tokfileSection errorText;
+};
+typedef struct tokfileHeader tokfileHeader;
+
+/*
+  A mapped token file, the pointers go straight into the mapping
+
+  @tokens: span over the token columns, valid until tokfileUnmap
+*/
+struct tokfile
+{
+  const void *data;
+  size_t length;
+  tokenSpan tokens;
+  size_t symbolCount;
+  const tokfileSymbol *symbols;
+  const char *symbolText;
+  size_t errorCount;
+  const tokfileLexeme *errors;
+  const char *errorText;
+};
+typedef struct tokfile tokfile;
+
+/*
+  Rounds an offset up to the section alignment
+
+  @offset: offset to be rounded
+
+  Return: aligned offset
+*/
+static inline uint64_t tokfileAlign(uint64_t offset)
+{
+  return (offset + 7) & ~(uint64_t)7;
+}
+
+/*
+  Determines if a section lies inside the file
+
+  @section: section to be checked
+  @size: size of one element
+  @length: length of the file
+
+  Return: 1 if it fits, 0 if not
+*/
+static inline int tokfileFits(tokfileSection section, size_t size, size_t length)
+{
+  return section.offset % 8 == 0 && section.offset <= length &&
+         section.count <= (length - section.offset) / size;
+}
+
+/*
+  Gets the id a parser grammar expects
+
+  @id: token id written by the scanner
+
+  Return: the same id, or 0 (identifier) for keywords past KEYWORD_TOKEN_BASE
+*/
+static inline int grammarTokenId(int id)
+{
+  return id >= KEYWORD_TOKEN_BASE ? 0 : id;
+}
+
+/*
+  Maps a token file written by the scanner
+
+  @filename: name of the token file
+  @file: mapping to be filled
+
+  only the header is checked, the sections are used as they are
+
+  Return: 1 on success, 0 if the file can't be mapped or isn't a valid token file
+*/
+static inline int tokfileMap(const char *filename, tokfile *file)
+{
+  int fd = open(filename, O_RDONLY);
+  if (fd < 0)
+    return 0;
+
+  struct stat info;
+  if (fstat(fd, &info) || (size_t)info.st_size < sizeof(tokfileHeader))
+  {
+    close(fd);
+    return 0;
+  }
+
+  size_t length = info.st_size;
+  void *data = mmap(NULL, length, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (data == MAP_FAILED)
+    return 0;
+
+  const tokfileHeader *header = (const tokfileHeader *)data;
+  if (memcmp(header->magic, TOKFILE_MAGIC, 4) || header->version != TOKFILE_VERSION ||
+      !tokfileFits(header->tokenIds, sizeof(uint8_t), length) ||
+      !tokfileFits(header->tokenSymbols, sizeof(int32_t), length) ||
+      !tokfileFits(header->offsetDeltas, sizeof(uint8_t), length) ||
+      !tokfileFits(header->lineDeltas, sizeof(uint8_t), length) ||
+      !tokfileFits(header->checkpoints, sizeof(tokenCheckpoint), length) ||
+      header->tokenSymbols.count != header->tokenIds.count ||
+      header->offsetDeltas.count != header->tokenIds.count ||
+      header->lineDeltas.count != header->tokenIds.count ||
+      (header->tokenIds.count && !header->checkpoints.count) ||
+      !tokfileFits(header->symbols, sizeof(tokfileSymbol), length) ||
+      !tokfileFits(header->symbolText, 1, length) ||
+      !tokfileFits(header->errors, sizeof(tokfileLexeme), length) ||
+      !tokfileFits(header->errorText, 1, length))
+  {
+    munmap(data, length);
+    return 0;
+  }
+
+  const char *base = (const char *)data;
+  file->data = data;
+  file->length = length;
+  file->tokens.count = header->tokenIds.count;
+  file->tokens.ids = (const uint8_t *)(base + header->tokenIds.offset);
+  file->tokens.symbols = (const int32_t *)(base + header->tokenSymbols.offset);
+  file->tokens.offsetDeltas = (const uint8_t *)(base + header->offsetDeltas.offset);
+  file->tokens.lineDeltas = (const uint8_t *)(base + header->lineDeltas.offset);
+  file->tokens.checkpointCount = header->checkpoints.count;
+  file->tokens.checkpoints = (const tokenCheckpoint *)(base + header->checkpoints.offset);
+  file->symbolCount = header->symbols.count;
+  file->symbols = (const tokfileSymbol *)(base + header->symbols.offset);
+  file->symbolText = base + header->symbolText.offset;
+  file->errorCount = header->errors.count;
+  file->errors = (const tokfileLexeme *)(base + header->errors.offset);
+  file->errorText = base + header->errorText.offset;
+  return 1;
+}
+
+/*
+  Releases a mapping made by tokfileMap
+
+  @file: mapping to be released
+
+  Return: none
+*/
+static inline void tokfileUnmap(tokfile *file)
+{
+  munmap((void *)file->data, file->length);
+  file->data = NULL;
+}
+
+#endif